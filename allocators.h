@@ -0,0 +1,455 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "vector.h"
+
+namespace coolstd {
+
+// malloc/realloc-backed allocator implementing the optional extensions coolstd::vector looks
+// for. allocate_at_least() and try_expand() expose the slack malloc leaves at the end of every
+// block, and reallocate() lets trivially relocatable elements be resized with ::realloc, which
+// glibc serves with mremap() for large blocks instead of copying. std::allocator can't offer
+// this: operator new has no realloc counterpart.
+template <class T>
+struct realloc_allocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "realloc_allocator only provides malloc's alignment");
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    realloc_allocator() = default;
+
+    template <class U>
+    constexpr realloc_allocator(const realloc_allocator<U>&) noexcept {
+    }
+
+    T* allocate(std::size_t n) {
+        void* ptr = std::malloc(n * sizeof(T));
+        if (ptr == nullptr && n > 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    allocation_result<T*> allocate_at_least(std::size_t n) {
+        T* ptr = allocate(n);
+        return {ptr, std::max(usableCount(ptr), n)};
+    }
+
+    void deallocate(T* ptr, std::size_t) noexcept {
+        std::free(ptr);
+    }
+
+    bool try_expand(T* ptr, std::size_t, std::size_t newCount) const noexcept {
+        return usableCount(ptr) >= newCount;
+    }
+
+    T* reallocate(T* ptr, std::size_t, std::size_t newCount) {
+        if (newCount == 0) {
+            std::free(ptr);
+            return nullptr;
+        }
+
+        void* resized = std::realloc(static_cast<void*>(ptr), newCount * sizeof(T));
+        if (resized == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(resized);
+    }
+
+    friend bool operator==(const realloc_allocator&, const realloc_allocator&) noexcept {
+        return true;
+    }
+
+private:
+    static std::size_t usableCount(T* ptr) noexcept {
+#if defined(__GLIBC__)
+        return ptr == nullptr ? 0 : malloc_usable_size(ptr) / sizeof(T);
+#else
+        (void)ptr;
+        return 0;
+#endif
+    }
+};
+
+// Allocator whose blocks start at a multiple of Alignment (at least alignof(T)), through the
+// aligned forms of operator new. The default of 64 is a cache line and an AVX-512 vector, so
+// no element straddles a line it doesn't have to and SIMD loops need no unaligned head; a
+// vector over it tells the compiler so through data().
+template <class T, std::size_t Alignment = 64>
+struct aligned_allocator {
+    static_assert(std::has_single_bit(Alignment), "alignment must be a power of two");
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t alignment = std::max(Alignment, alignof(T));
+
+    template <class U>
+    struct rebind {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() = default;
+
+    template <class U>
+    constexpr aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {
+    }
+
+    T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        ::operator delete(ptr, n * sizeof(T), std::align_val_t(alignment));
+    }
+
+    friend bool operator==(const aligned_allocator&, const aligned_allocator&) noexcept {
+        return true;
+    }
+};
+
+// Allocator that backs large blocks with 2 MiB pages, so that a buffer of hundreds of megabytes
+// costs a few hundred TLB entries instead of tens of thousands of 4 KiB ones. Blocks of at
+// least half a huge page are mapped directly, in whole huge pages: first from the kernel's
+// reserved pool with MAP_HUGETLB, and when that is empty or not configured, as ordinary
+// anonymous memory aligned to 2 MiB and marked MADV_HUGEPAGE for transparent huge pages (which
+// the kernel may still decline, e.g. when memory is fragmented). Smaller blocks come from
+// aligned operator new. Every block is 64-byte aligned. Elsewhere than Linux it behaves as
+// aligned_allocator<T, 64>.
+template <class T>
+struct huge_page_allocator {
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t alignment = std::max(std::size_t(64), alignof(T));
+    static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+    huge_page_allocator() = default;
+
+    template <class U>
+    constexpr huge_page_allocator(const huge_page_allocator<U>&) noexcept {
+    }
+
+    T* allocate(std::size_t n) {
+        return allocate_at_least(n).ptr;
+    }
+
+    // Mapped blocks are whole huge pages; the rest of the last one is reported as capacity.
+    allocation_result<T*> allocate_at_least(std::size_t n) {
+        if (n > (std::numeric_limits<std::size_t>::max() - huge_page_size) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+
+        const std::size_t bytes = n * sizeof(T);
+        if (!isMapped(bytes)) {
+            return {static_cast<T*>(::operator new(bytes, std::align_val_t(alignment))), n};
+        }
+
+        const std::size_t mapped = roundToHugePage(bytes);
+        const std::size_t count = sizeof(T) <= mapThreshold ? mapped / sizeof(T) : n;
+        return {static_cast<T*>(mapHugePages(mapped)), count};
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        const std::size_t bytes = n * sizeof(T);
+        if (isMapped(bytes)) {
+#if defined(__linux__)
+            ::munmap(ptr, roundToHugePage(bytes));
+#endif
+        } else {
+            ::operator delete(ptr, bytes, std::align_val_t(alignment));
+        }
+    }
+
+    friend bool operator==(const huge_page_allocator&, const huge_page_allocator&) noexcept {
+        return true;
+    }
+
+private:
+    static constexpr std::size_t mapThreshold = huge_page_size / 2;
+
+    // The size decides how a block was allocated, so deallocate() can tell from its count. A
+    // capacity from allocate_at_least() is within one element of the mapping's end, which
+    // keeps it above the threshold and rounds it back up to the same mapping.
+    static bool isMapped(std::size_t bytes) noexcept {
+#if defined(__linux__)
+        return bytes >= mapThreshold;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    static std::size_t roundToHugePage(std::size_t bytes) noexcept {
+        return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+
+#if defined(__linux__)
+    // Set once MAP_HUGETLB has failed, so a system without a reserved pool pays for the failed
+    // mmap() only once; a pool that has run dry isn't retried either.
+    static std::atomic<bool>& hugetlbUnavailable() noexcept {
+        static std::atomic<bool> unavailable{false};
+        return unavailable;
+    }
+
+    static void* mapHugePages(std::size_t bytes) {
+        constexpr int protection = PROT_READ | PROT_WRITE;
+        constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+        if (!hugetlbUnavailable().load(std::memory_order_relaxed)) {
+            void* ptr = ::mmap(nullptr, bytes, protection, flags | MAP_HUGETLB, -1, 0);
+            if (ptr != MAP_FAILED) {
+                return ptr;
+            }
+            hugetlbUnavailable().store(true, std::memory_order_relaxed);
+        }
+
+        // Over-map by a page and trim both ends so the block starts on a 2 MiB boundary, which
+        // transparent huge pages need.
+        void* raw = ::mmap(nullptr, bytes + huge_page_size, protection, flags, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        char* const start = static_cast<char*>(raw);
+        char* const aligned = reinterpret_cast<char*>(
+            roundToHugePage(reinterpret_cast<std::uintptr_t>(start)));
+        if (aligned != start) {
+            ::munmap(start, std::size_t(aligned - start));
+        }
+        ::munmap(aligned + bytes, std::size_t(start + huge_page_size - aligned));
+        ::madvise(aligned, bytes, MADV_HUGEPAGE);
+        return aligned;
+    }
+#else
+    static void* mapHugePages(std::size_t) {
+        return nullptr;
+    }
+#endif
+};
+
+// Monotonic memory resource. Allocations bump a pointer through chunks taken from an upstream
+// resource, each chunk twice the size of the previous one; deallocate() is a no-op and memory is
+// reclaimed all at once by reset() or the destructor. The most recent allocation can be grown
+// or shrunk in place with try_extend(), which is what lets a vector growing at the top of the
+// arena keep its buffer.
+//
+// reset() hands everything back at once: containers still referring to the arena must not
+// touch their elements afterwards, and may only be destroyed if those elements are trivially
+// destructible (coolstd::vector with arena_allocator then runs no code at all in its
+// destructor). Not thread-safe.
+class arena : public std::pmr::memory_resource {
+public:
+    explicit arena(std::size_t initialSize = 4096,
+                   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream_(upstream), nextChunkSize_(std::max(initialSize, sizeof(Chunk) * 2)) {
+    }
+
+    // Serves allocations from buffer first; it is never returned to upstream.
+    arena(void* buffer, std::size_t size,
+          std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream_(upstream),
+          buffer_(static_cast<char*>(buffer)),
+          bufferSize_(size),
+          cursor_(buffer_),
+          end_(buffer_ + size),
+          nextChunkSize_(std::max(size, sizeof(Chunk) * 2)) {
+    }
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena() override {
+        release();
+    }
+
+    void* bump(std::size_t bytes, std::size_t alignment) {
+        std::uintptr_t aligned = alignUp(cursor_, alignment);
+
+        if (cursor_ == nullptr || aligned > std::uintptr_t(end_) ||
+            bytes > std::uintptr_t(end_) - aligned) {
+            addChunk(bytes, alignment);
+            aligned = alignUp(cursor_, alignment);
+        }
+
+        last_ = reinterpret_cast<char*>(aligned);
+        cursor_ = last_ + bytes;
+        return last_;
+    }
+
+    // Resizes the most recent allocation if it still ends at the bump pointer and the new size
+    // fits in the current chunk.
+    bool try_extend(void* ptr, std::size_t oldBytes, std::size_t newBytes) noexcept {
+        char* const block = static_cast<char*>(ptr);
+
+        if (block == nullptr || block != last_ || block + oldBytes != cursor_ ||
+            newBytes > std::size_t(end_ - block)) {
+            return false;
+        }
+
+        cursor_ = block + newBytes;
+        return true;
+    }
+
+    // Reclaims every allocation. The largest chunk is kept and reused, so an arena reset
+    // between requests settles into a single chunk.
+    void reset() noexcept {
+        if (chunks_ == nullptr) {
+            cursor_ = buffer_;
+            end_ = buffer_ + bufferSize_;
+        } else {
+            freeChunks(chunks_->previous);
+            chunks_->previous = nullptr;
+            cursor_ = reinterpret_cast<char*>(chunks_ + 1);
+            end_ = reinterpret_cast<char*>(chunks_) + chunks_->size;
+        }
+        last_ = nullptr;
+    }
+
+    // Reclaims every allocation and returns all chunks to upstream.
+    void release() noexcept {
+        freeChunks(chunks_);
+        chunks_ = nullptr;
+        reset();
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept {
+        return upstream_;
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        return bump(bytes, alignment);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) noexcept override {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* previous;
+        std::size_t size;
+    };
+
+    static std::uintptr_t alignUp(const char* ptr, std::size_t alignment) noexcept {
+        return (reinterpret_cast<std::uintptr_t>(ptr) + alignment - 1) & ~(alignment - 1);
+    }
+
+    void addChunk(std::size_t bytes, std::size_t alignment) {
+        const std::size_t padding = sizeof(Chunk) + std::max(alignment, alignof(Chunk));
+
+        if (bytes > std::numeric_limits<std::size_t>::max() - padding) {
+            throw std::bad_alloc();
+        }
+
+        const std::size_t size = std::max(nextChunkSize_, bytes + padding);
+        Chunk* chunk = static_cast<Chunk*>(upstream_->allocate(size, alignof(Chunk)));
+
+        chunks_ = ::new (chunk) Chunk{chunks_, size};
+        cursor_ = reinterpret_cast<char*>(chunk + 1);
+        end_ = reinterpret_cast<char*>(chunk) + size;
+        nextChunkSize_ = size * 2;
+    }
+
+    void freeChunks(Chunk* chunk) noexcept {
+        while (chunk != nullptr) {
+            Chunk* const previous = chunk->previous;
+            upstream_->deallocate(chunk, chunk->size, alignof(Chunk));
+            chunk = previous;
+        }
+    }
+
+    std::pmr::memory_resource* upstream_;
+    char* buffer_ = nullptr;
+    std::size_t bufferSize_ = 0;
+    Chunk* chunks_ = nullptr;
+    char* cursor_ = nullptr;
+    char* end_ = nullptr;
+    char* last_ = nullptr;
+    std::size_t nextChunkSize_;
+};
+
+// Allocator handing out memory from an arena. It declares itself monotonic, so coolstd::vector
+// never calls deallocate(), and exposes try_expand(), so a vector whose buffer is the newest
+// block in the arena grows in place. Like std::pmr::polymorphic_allocator it does not
+// propagate: every container stays in the arena it was created with, and moving between
+// arenas moves the elements.
+template <class T>
+class arena_allocator {
+public:
+    using value_type = T;
+    using is_monotonic = std::true_type;
+
+    explicit arena_allocator(arena& source) noexcept : arena_(&source) {
+    }
+
+    template <class U>
+    constexpr arena_allocator(const arena_allocator<U>& other) noexcept
+        : arena_(other.resource()) {
+    }
+
+    T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(arena_->bump(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {
+    }
+
+    bool try_expand(T* ptr, std::size_t oldCount, std::size_t newCount) const noexcept {
+        return newCount <= std::numeric_limits<std::size_t>::max() / sizeof(T) &&
+               arena_->try_extend(ptr, oldCount * sizeof(T), newCount * sizeof(T));
+    }
+
+    arena* resource() const noexcept {
+        return arena_;
+    }
+
+    friend bool operator==(const arena_allocator& lhs, const arena_allocator& rhs) noexcept {
+        return lhs.resource() == rhs.resource();
+    }
+
+private:
+    arena* arena_;
+};
+
+namespace pmr {
+
+// coolstd::vector over a std::pmr::memory_resource, e.g. a coolstd::arena or a
+// std::pmr::monotonic_buffer_resource. Deallocation goes through the resource, and there is no
+// in-place growth: the extensions vector looks for can't be reached through memory_resource.
+template <class T, class GrowthPolicy = growth::doubling>
+using vector = coolstd::vector<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy>;
+
+}  // namespace pmr
+
+}  // namespace coolstd
@@ -0,0 +1,98 @@
+// Log-batch concatenation: many small batches of fixed-size records appended to one output
+// vector. Compares an element-wise push_back loop with append_range from a contiguous source
+// (one growth and one memcpy per batch), a non-contiguous source (one growth, element-wise copy)
+// and a pure input range (geometric growth), with std::vector::insert as a reference.
+
+#include <cstdint>
+#include <list>
+#include <ranges>
+#include <vector>
+
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+struct LogRecord {
+    std::uint64_t timestamp;
+    std::uint32_t level;
+    std::uint32_t source;
+    char message[48];
+};
+
+std::vector<std::vector<LogRecord>> makeBatches(std::size_t batches, std::size_t perBatch) {
+    std::vector<std::vector<LogRecord>> result(batches);
+
+    for (std::size_t b = 0; b < batches; ++b) {
+        result[b].resize(perBatch);
+        for (std::size_t i = 0; i < perBatch; ++i) {
+            result[b][i].timestamp = b * perBatch + i;
+        }
+    }
+
+    return result;
+}
+
+template <class Fn>
+void run(const char* name, std::size_t items, Fn fn) {
+    bench::report(name, items, bench::measure(fn));
+}
+
+}  // namespace
+
+int main() {
+    for (std::size_t perBatch : {16u, 256u, 4096u}) {
+        const std::size_t batches = (std::size_t(1) << 16) / perBatch;
+        const std::size_t items = batches * perBatch;
+        const auto source = makeBatches(batches, perBatch);
+        const std::list<LogRecord> listBatch(source[0].begin(), source[0].end());
+
+        std::printf("-- %zu records per batch\n", perBatch);
+
+        run("push_back loop", items, [&] {
+            coolstd::vector<LogRecord> out;
+            for (const auto& batch : source) {
+                for (const LogRecord& record : batch) {
+                    out.push_back(record);
+                }
+            }
+            bench::doNotOptimize(out.data());
+        });
+
+        run("append_range/contiguous", items, [&] {
+            coolstd::vector<LogRecord> out;
+            for (const auto& batch : source) {
+                out.append_range(batch);
+            }
+            bench::doNotOptimize(out.data());
+        });
+
+        run("std::vector::insert/contiguous", items, [&] {
+            std::vector<LogRecord> out;
+            for (const auto& batch : source) {
+                out.insert(out.end(), batch.begin(), batch.end());
+            }
+            bench::doNotOptimize(out.data());
+        });
+
+        run("append_range/list", items, [&] {
+            coolstd::vector<LogRecord> out;
+            for (std::size_t b = 0; b < batches; ++b) {
+                out.append_range(listBatch);
+            }
+            bench::doNotOptimize(out.data());
+        });
+
+        run("append_range/input", items, [&] {
+            coolstd::vector<LogRecord> out;
+            for (const auto& batch : source) {
+                auto it = batch.begin();
+                auto generator = std::views::iota(std::size_t(0), batch.size()) |
+                                 std::views::filter([](std::size_t) { return true; }) |
+                                 std::views::transform([&](std::size_t) { return *it++; });
+                out.append_range(generator);
+            }
+            bench::doNotOptimize(out.data());
+        });
+    }
+}
@@ -0,0 +1,86 @@
+// Per-request scratch vectors: every simulated request builds a few vectors of varying size and
+// drops them. With std::allocator each vector pays for its growth steps and a free; in an arena
+// reset after every request, growth of the newest vector is an in-place bump and teardown is a
+// single reset() with no per-vector deallocation.
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+#include "../allocators.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+struct Edge {
+    std::uint32_t from;
+    std::uint32_t to;
+    float weight;
+};
+
+// Deterministic per-request sizes between 1 and 1024.
+std::size_t itemsFor(std::size_t request, std::size_t list) {
+    const std::size_t hash = (request * 4 + list) * 2654435761u;
+
+    return 1 + (hash >> 9) % ((hash >> 5) % 8 == 0 ? 1024 : 64);
+}
+
+template <class Vector>
+std::size_t handle(std::size_t request, const typename Vector::allocator_type& allocator) {
+    std::size_t total = 0;
+
+    for (std::size_t list = 0; list < 4; ++list) {
+        Vector edges(allocator);
+        const std::size_t n = itemsFor(request, list);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            edges.push_back(Edge{std::uint32_t(i), std::uint32_t(i + 1), 1.0f});
+        }
+        total += edges.size();
+        bench::doNotOptimize(edges.data());
+    }
+
+    return total;
+}
+
+template <class Fn>
+void run(const char* name, std::size_t items, Fn fn) {
+    bench::report(name, items, bench::measure(fn));
+}
+
+}  // namespace
+
+int main() {
+    using ArenaVector = coolstd::vector<Edge, coolstd::arena_allocator<Edge>>;
+
+    for (std::size_t requests : {1000u, 100000u}) {
+        std::size_t items = 0;
+        for (std::size_t r = 0; r < requests; ++r) {
+            items += itemsFor(r, 0) + itemsFor(r, 1) + itemsFor(r, 2) + itemsFor(r, 3);
+        }
+
+        std::printf("-- %zu requests\n", requests);
+
+        run("std::allocator", items, [&] {
+            for (std::size_t r = 0; r < requests; ++r) {
+                handle<coolstd::vector<Edge>>(r, {});
+            }
+        });
+
+        coolstd::arena arena(std::size_t(1) << 16);
+        run("arena_allocator", items, [&] {
+            for (std::size_t r = 0; r < requests; ++r) {
+                handle<ArenaVector>(r, coolstd::arena_allocator<Edge>(arena));
+                arena.reset();
+            }
+        });
+
+        run("pmr::vector on arena", items, [&] {
+            for (std::size_t r = 0; r < requests; ++r) {
+                handle<coolstd::pmr::vector<Edge>>(r, &arena);
+                arena.reset();
+            }
+        });
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Minimal timing harness shared by the benchmarks in this directory. Each benchmark is run a few
+// times and the fastest repetition is reported, which filters out most scheduler noise without
+// pulling in an external framework.
+namespace bench {
+
+template <class T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+// Returns the fastest of `repetitions` runs of fn, in nanoseconds.
+template <class Fn>
+double measure(Fn&& fn, int repetitions = 5) {
+    double best = std::numeric_limits<double>::max();
+
+    for (int i = 0; i < repetitions; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        clobberMemory();
+        const auto stop = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+
+    return best;
+}
+
+// As measure(), but each repetition first calls setup() outside the timed region and passes the
+// state it returns to fn. The state is destroyed after the clock stops.
+template <class Setup, class Fn>
+double measureWithSetup(Setup&& setup, Fn&& fn, int repetitions = 5) {
+    double best = std::numeric_limits<double>::max();
+
+    for (int i = 0; i < repetitions; ++i) {
+        auto state = setup();
+        clobberMemory();
+        const auto start = std::chrono::steady_clock::now();
+        fn(state);
+        clobberMemory();
+        const auto stop = std::chrono::steady_clock::now();
+
+        best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+
+    return best;
+}
+
+inline void report(const char* name, std::size_t items, double nanoseconds) {
+    std::printf("%-48s %12zu items %14.0f ns %10.2f ns/item\n", name, items, nanoseconds,
+                nanoseconds / double(items));
+}
+
+struct Result {
+    std::string name;
+    std::size_t iterations;
+    std::size_t items;
+    double nanoseconds;  // per iteration
+};
+
+// Writes results in the subset of Google Benchmark's JSON format that its compare.py and most
+// dashboards read, so runs can be diffed over time. Names must not need escaping.
+inline void writeJson(std::FILE* out, const char* executable, const std::vector<Result>& results) {
+    std::fprintf(out, "{\n  \"context\": {\"executable\": \"%s\"},\n  \"benchmarks\": [",
+                 executable);
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+
+        std::fprintf(out,
+                     "%s\n    {\"name\": \"%s\", \"run_name\": \"%s\", \"run_type\": "
+                     "\"iteration\", \"iterations\": %zu, \"real_time\": %.3f, "
+                     "\"cpu_time\": %.3f, \"time_unit\": \"ns\", \"items_per_second\": %.1f}",
+                     i == 0 ? "" : ",", result.name.c_str(), result.name.c_str(),
+                     result.iterations, result.nanoseconds, result.nanoseconds,
+                     double(result.items) * 1e9 / result.nanoseconds);
+    }
+
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+}  // namespace bench
@@ -0,0 +1,144 @@
+// Cost of COOLSTD_CHECKS. The same kernels (indexed, iterator and range-for sums, a random
+// gather, push_back/pop_back and front()/back() traffic, middle insert/erase) run against a
+// raw-pointer loop doing the same work. CMake builds this file three times: bench_checks with
+// the checks off, bench_checks_assert and bench_checks_trap. With the checks off the vector
+// kernels should time the same as before checks existed, and the code is the same: the kernels
+// are out-of-line functions so that
+//
+//   objdump -d --no-show-raw-insn bench_checks | awk '/<sumIndexed/,/^$/'
+//
+// can be diffed between builds, or against a build of the previous vector.h.
+
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+using Vector = coolstd::vector<std::uint32_t>;
+
+[[gnu::noinline]] std::uint64_t sumRaw(const std::uint32_t* data, std::size_t size) {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        total += data[i];
+    }
+    return total;
+}
+
+[[gnu::noinline]] std::uint64_t sumIndexed(const Vector& vec) {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        total += vec[i];
+    }
+    return total;
+}
+
+[[gnu::noinline]] std::uint64_t sumIterators(const Vector& vec) {
+    std::uint64_t total = 0;
+    for (auto it = vec.begin(); it != vec.end(); ++it) {
+        total += *it;
+    }
+    return total;
+}
+
+[[gnu::noinline]] std::uint64_t sumRangeFor(const Vector& vec) {
+    std::uint64_t total = 0;
+    for (std::uint32_t value : vec) {
+        total += value;
+    }
+    return total;
+}
+
+// indices[i] < size for every i, which the compiler can't see.
+[[gnu::noinline]] std::uint64_t gatherRaw(const std::uint32_t* data, const std::uint32_t* indices,
+                                          std::size_t count) {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        total += data[indices[i]];
+    }
+    return total;
+}
+
+[[gnu::noinline]] std::uint64_t gatherIndexed(const Vector& vec, const Vector& indices) {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        total += vec[indices[i]];
+    }
+    return total;
+}
+
+// A stack: push, peek, pop.
+[[gnu::noinline]] std::uint64_t stackTraffic(Vector& stack, std::size_t rounds) {
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < rounds; ++i) {
+        stack.push_back(std::uint32_t(i));
+        stack.push_back(std::uint32_t(i) * 3);
+        total += stack.back() + stack.front();
+        stack.pop_back();
+        stack.pop_back();
+    }
+    return total;
+}
+
+[[gnu::noinline]] void insertErase(Vector& vec, std::size_t rounds) {
+    for (std::size_t i = 0; i < rounds; ++i) {
+        vec.insert(vec.begin() + std::ptrdiff_t(vec.size() / 2), std::uint32_t(i));
+        vec.erase(vec.begin() + std::ptrdiff_t(vec.size() / 3));
+    }
+}
+
+const char* modeName() {
+    switch (COOLSTD_CHECKS) {
+        case COOLSTD_CHECKS_ASSERT:
+            return "assert";
+        case COOLSTD_CHECKS_TRAP:
+            return "trap";
+        default:
+            return "off";
+    }
+}
+
+}  // namespace
+
+int main() {
+    std::printf("COOLSTD_CHECKS: %s\n", modeName());
+
+    constexpr std::size_t count = std::size_t(1) << 20;
+    Vector vec(count);
+    std::iota(vec.begin(), vec.end(), 0u);
+
+    Vector indices(count);
+    std::uint32_t state = 2463534242u;
+    for (std::uint32_t& index : indices) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        index = state % count;
+    }
+
+    auto time = [&](const char* name, auto fn) {
+        bench::report(name, count, bench::measure([&] { bench::doNotOptimize(fn()); }, 20));
+    };
+
+    time("sum/raw pointer", [&] { return sumRaw(vec.data(), vec.size()); });
+    time("sum/operator[]", [&] { return sumIndexed(vec); });
+    time("sum/iterators", [&] { return sumIterators(vec); });
+    time("sum/range-for", [&] { return sumRangeFor(vec); });
+    time("gather/raw pointer",
+         [&] { return gatherRaw(vec.data(), indices.data(), indices.size()); });
+    time("gather/operator[]", [&] { return gatherIndexed(vec, indices); });
+
+    Vector stack;
+    stack.reserve(16);
+    stack.push_back(0);
+    time("push_back/back/pop_back", [&] { return stackTraffic(stack, count); });
+
+    Vector small(1000, 1);
+    bench::report("insert/erase middle of 1000", 10000, bench::measure([&] {
+                      insertErase(small, 10000);
+                      bench::doNotOptimize(small.data());
+                  }));
+}
@@ -0,0 +1,135 @@
+// Producer contention: 1 to 64 threads append fixed-size telemetry records to one shared
+// container, either a coolstd::vector behind a std::mutex or a coolstd::concurrent_vector. Each
+// line reports the wall time for all appends and the aggregate rate. With the mutex every append
+// serializes and every growth step stalls all producers while the buffer is copied; the
+// concurrent vector only shares one atomic counter.
+//
+//   concurrent [--max-threads=N] [--records=N] [--repetitions=N]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../concurrent_vector.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+struct Record {
+    std::uint64_t timestamp = 0;
+    std::uint32_t source = 0;
+    std::uint32_t kind = 0;
+    double value = 0.0;
+};
+
+struct Options {
+    std::size_t maxThreads = 64;
+    std::size_t records = 4000000;
+    int repetitions = 3;
+};
+
+bool parseOption(const char* argument, const char* name, const char** value) {
+    const std::size_t length = std::strlen(name);
+
+    if (std::strncmp(argument, name, length) == 0 && argument[length] == '=') {
+        *value = argument + length + 1;
+        return true;
+    }
+
+    return false;
+}
+
+// Runs append(thread, i) for records / threads values of i on each of `threads` threads.
+template <class Append>
+void produce(std::size_t threads, std::size_t records, Append append) {
+    std::vector<std::thread> producers;
+
+    for (std::size_t t = 0; t < threads; ++t) {
+        producers.emplace_back([&, t] {
+            for (std::size_t i = t; i < records; i += threads) {
+                append(std::uint32_t(t), i);
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+}
+
+void report(const char* name, std::size_t threads, std::size_t records, double nanoseconds) {
+    std::printf("%-28s %3zu threads %10.2f ms %10.2f M appends/s\n", name, threads,
+                nanoseconds / 1e6, double(records) / nanoseconds * 1e3);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* value = nullptr;
+
+        if (parseOption(argv[i], "--max-threads", &value)) {
+            options.maxThreads = std::strtoull(value, nullptr, 10);
+        } else if (parseOption(argv[i], "--records", &value)) {
+            options.records = std::strtoull(value, nullptr, 10);
+        } else if (parseOption(argv[i], "--repetitions", &value)) {
+            options.repetitions = std::max(1, std::atoi(value));
+        } else {
+            std::fprintf(stderr, "usage: %s [--max-threads=N] [--records=N] [--repetitions=N]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    const std::size_t records = options.records;
+    std::printf("hardware threads: %u, %zu records\n", std::thread::hardware_concurrency(),
+                records);
+
+    for (std::size_t threads = 1; threads <= options.maxThreads; threads *= 2) {
+        report("mutex + vector::push_back", threads, records,
+               bench::measure(
+                   [&] {
+                       coolstd::vector<Record> records_vec;
+                       std::mutex mutex;
+
+                       produce(threads, records, [&](std::uint32_t source, std::size_t i) {
+                           const Record record{i, source, 1, double(i)};
+                           std::lock_guard<std::mutex> lock(mutex);
+                           records_vec.push_back(record);
+                       });
+                       bench::doNotOptimize(records_vec.data());
+                   },
+                   options.repetitions));
+
+        report("concurrent_vector::push_back", threads, records,
+               bench::measure(
+                   [&] {
+                       coolstd::concurrent_vector<Record> records_vec;
+
+                       produce(threads, records, [&](std::uint32_t source, std::size_t i) {
+                           records_vec.push_back(Record{i, source, 1, double(i)});
+                       });
+                       bench::doNotOptimize(records_vec.size());
+                   },
+                   options.repetitions));
+
+        report("concurrent_vector::grow_by", threads, records,
+               bench::measure(
+                   [&] {
+                       coolstd::concurrent_vector<Record> records_vec;
+
+                       // Batches of 64 per claim, as a producer flushing a local buffer would.
+                       produce(threads, records / 64, [&](std::uint32_t source, std::size_t i) {
+                           records_vec.grow_by(64, Record{i, source, 1, double(i)});
+                       });
+                       bench::doNotOptimize(records_vec.size());
+                   },
+                   options.repetitions));
+    }
+}
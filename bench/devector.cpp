@@ -0,0 +1,99 @@
+// FIFO workloads on coolstd::devector against coolstd::vector and std::deque:
+//   - queue: a window of fixed size slides over a stream, push_back plus pop_front (erase(begin())
+//     for vector, which shifts the whole window each time);
+//   - window sum: the same, summing the window once per window of pushes, where devector's
+//     contiguous elements vectorize and std::deque's blocks don't;
+//   - push_front: building a sequence from the front (insert(begin()) for vector).
+// Reported per operation. vector's runs are shortened at large windows, where every pop is a
+// memmove of the whole window.
+
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#include "../devector.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+template <class Queue>
+void popFront(Queue& queue) {
+    if constexpr (requires { queue.pop_front(); }) {
+        queue.pop_front();
+    } else {
+        queue.erase(queue.begin());
+    }
+}
+
+template <class Queue>
+void pushFront(Queue& queue, std::uint64_t value) {
+    if constexpr (requires { queue.push_front(value); }) {
+        queue.push_front(value);
+    } else {
+        queue.insert(queue.begin(), value);
+    }
+}
+
+template <class Queue>
+void runQueue(const char* name, std::size_t window, std::size_t operations) {
+    const std::string label = std::string(name) + "/" + std::to_string(window);
+
+    bench::report(("queue/" + label).c_str(), operations, bench::measure([&] {
+                      Queue queue;
+                      for (std::uint64_t i = 0; i < operations; ++i) {
+                          queue.push_back(i);
+                          if (queue.size() > window) {
+                              popFront(queue);
+                          }
+                      }
+                      bench::doNotOptimize(queue.front());
+                  }));
+
+    bench::report(("window sum/" + label).c_str(), operations, bench::measure([&] {
+                      Queue queue;
+                      std::uint64_t total = 0;
+                      for (std::uint64_t i = 0; i < operations; ++i) {
+                          queue.push_back(i);
+                          if (queue.size() > window) {
+                              popFront(queue);
+                          }
+                          if (i % window == 0) {
+                              for (std::uint64_t value : queue) {
+                                  total += value;
+                              }
+                          }
+                      }
+                      bench::doNotOptimize(total);
+                  }));
+}
+
+template <class Queue>
+void runPushFront(const char* name, std::size_t count) {
+    bench::report((std::string("push_front/") + name + "/" + std::to_string(count)).c_str(), count,
+                  bench::measure([&] {
+                      Queue queue;
+                      for (std::uint64_t i = 0; i < count; ++i) {
+                          pushFront(queue, i);
+                      }
+                      bench::doNotOptimize(queue.front());
+                  }));
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::size_t operations = std::size_t(1) << 22;
+
+    for (std::size_t window : {std::size_t(16), std::size_t(1024), std::size_t(1) << 16}) {
+        const std::size_t vectorOperations = window > 1024 ? window + 4096 : operations;
+
+        runQueue<coolstd::devector<std::uint64_t>>("devector", window, operations);
+        runQueue<std::deque<std::uint64_t>>("std::deque", window, operations);
+        runQueue<coolstd::vector<std::uint64_t>>("coolstd::vector", window, vectorOperations);
+    }
+
+    runPushFront<coolstd::devector<std::uint64_t>>("devector", operations);
+    runPushFront<std::deque<std::uint64_t>>("std::deque", operations);
+    runPushFront<coolstd::vector<std::uint64_t>>("coolstd::vector", 1 << 15);
+}
@@ -0,0 +1,132 @@
+// Erasing from the middle of large vectors of std::uint64_t, coolstd::vector against std::vector:
+//   - erase one element near the front of a 10M-element vector, which shifts the whole tail
+//     (memmove for coolstd, whose elements are bitwise relocatable), and erase_unordered, which
+//     moves only the back element into the gap;
+//   - erase_if against the std::remove_if + erase idiom, at a few drop rates;
+//   - erase_indices of a sorted index list against remove_if with a lookup into the list, the way
+//     the idiom has to do it.
+// Reported per element of the vector for the bulk erasures, per call for the single ones.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+using Vector = coolstd::vector<std::uint64_t>;
+
+constexpr std::size_t count = 10'000'000;
+
+template <class V>
+V iota() {
+    V vec(count);
+    std::iota(vec.begin(), vec.end(), std::uint64_t(0));
+    return vec;
+}
+
+// Keeps the benchmark from being a pure branch predictor test: whether an element is dropped
+// depends on a hash of it.
+bool dropped(std::uint64_t value, std::uint64_t percent) {
+    return (value * 0x9e3779b97f4a7c15ull >> 32) % 100 < percent;
+}
+
+void singleErasures() {
+    constexpr std::size_t rounds = 20;
+    auto time = [&](const char* name, auto fn) {
+        const double nanoseconds = bench::measure([&] {
+            for (std::size_t i = 0; i < rounds; ++i) {
+                fn();
+            }
+        });
+        bench::report(name, rounds, nanoseconds);
+    };
+
+    std::vector<std::uint64_t> std_vec = iota<std::vector<std::uint64_t>>();
+    Vector custom_vec = iota<Vector>();
+
+    time("erase near front/std::vector", [&] {
+        std_vec.erase(std_vec.begin() + 100);
+        bench::doNotOptimize(std_vec.data());
+    });
+    time("erase near front/coolstd", [&] {
+        custom_vec.erase(custom_vec.begin() + 100);
+        bench::doNotOptimize(custom_vec.data());
+    });
+    time("erase_unordered near front/coolstd", [&] {
+        custom_vec.erase_unordered(custom_vec.begin() + 100);
+        bench::doNotOptimize(custom_vec.data());
+    });
+}
+
+void bulkErasures(std::uint64_t percent) {
+    auto time = [&](const std::string& name, auto setup, auto fn) {
+        bench::report((name + "/" + std::to_string(percent) + "%").c_str(), count,
+                      bench::measureWithSetup(setup, fn));
+    };
+    auto pred = [percent](std::uint64_t value) { return dropped(value, percent); };
+
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (pred(i)) {
+            indices.push_back(i);
+        }
+    }
+
+    time(
+        "remove_if + erase/std::vector", [] { return iota<std::vector<std::uint64_t>>(); },
+        [&](auto& vec) {
+            vec.erase(std::remove_if(vec.begin(), vec.end(), pred), vec.end());
+            bench::doNotOptimize(vec.data());
+        });
+    time(
+        "remove_if + erase/coolstd", [] { return iota<Vector>(); },
+        [&](auto& vec) {
+            vec.erase(std::remove_if(vec.begin(), vec.end(), pred), vec.end());
+            bench::doNotOptimize(vec.data());
+        });
+    time(
+        "erase_if/coolstd", [] { return iota<Vector>(); },
+        [&](auto& vec) {
+            erase_if(vec, pred);
+            bench::doNotOptimize(vec.data());
+        });
+
+    // The idiom only sees values, so it has to find each element's index in the list.
+    time(
+        "remove_if by index + erase/coolstd", [] { return iota<Vector>(); },
+        [&](auto& vec) {
+            const std::uint64_t* first = vec.data();
+            auto next = indices.begin();
+            auto byIndex = [&](const std::uint64_t& value) {
+                const std::size_t i = std::size_t(&value - first);
+                if (next != indices.end() && *next == i) {
+                    ++next;
+                    return true;
+                }
+                return false;
+            };
+            vec.erase(std::remove_if(vec.begin(), vec.end(), byIndex), vec.end());
+            bench::doNotOptimize(vec.data());
+        });
+    time(
+        "erase_indices/coolstd", [] { return iota<Vector>(); },
+        [&](auto& vec) {
+            vec.erase_indices(indices);
+            bench::doNotOptimize(vec.data());
+        });
+}
+
+}  // namespace
+
+int main() {
+    singleErasures();
+    for (std::uint64_t percent : {1, 10, 50}) {
+        bulkErasures(percent);
+    }
+}
@@ -0,0 +1,104 @@
+// Parallel construction of large vectors and what it does to later reads. A vector<double> is
+// built three ways: by the sequential count+value constructor, and by the executor constructor
+// with dynamic and with fixed scheduling. Each line reports the construction time (page faults
+// included, as the buffer is fresh from the OS) and the bandwidth of a par::reduce over the
+// result with a fixed schedule.
+//
+// On a NUMA machine a page lives on the node of the thread that first touched it, so after a
+// sequential construction every reduce thread reads from one node, while after a fixed
+// construction every thread reads the block it wrote itself. Dynamic scheduling hands chunks to
+// whichever thread is free and lands somewhere in between. On a single-node machine only the
+// construction times differ.
+//
+//   first_touch [--max-threads=N] [--max-bytes=N] [--repetitions=N]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "../parallel.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+using Vector = coolstd::vector<double>;
+
+struct Options {
+    std::size_t maxThreads = 64;
+    std::size_t maxBytes = std::size_t(1) << 30;
+    int repetitions = 3;
+};
+
+bool parseOption(const char* argument, const char* name, const char** value) {
+    const std::size_t length = std::strlen(name);
+
+    if (std::strncmp(argument, name, length) == 0 && argument[length] == '=') {
+        *value = argument + length + 1;
+        return true;
+    }
+
+    return false;
+}
+
+template <class Construct>
+void run(const char* name, std::size_t threads, std::size_t count, int repetitions,
+         const coolstd::par::options& reader, Construct construct) {
+    const double constructNs = bench::measureWithSetup(
+        [] { return std::optional<Vector>(); }, [&](std::optional<Vector>& vec) { construct(vec); },
+        repetitions);
+
+    std::optional<Vector> vec;
+    construct(vec);
+    const double readNs = bench::measure(
+        [&] { bench::doNotOptimize(coolstd::par::reduce(*vec, 0.0, std::plus<>(), reader)); },
+        repetitions);
+
+    std::printf("%-12s %12zu items %3zu threads %10.2f ms construct %8.2f GB/s read\n", name,
+                count, threads, constructNs / 1e6,
+                double(count * sizeof(double)) / readNs);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* value = nullptr;
+
+        if (parseOption(argv[i], "--max-threads", &value)) {
+            options.maxThreads = std::strtoull(value, nullptr, 10);
+        } else if (parseOption(argv[i], "--max-bytes", &value)) {
+            options.maxBytes = std::strtoull(value, nullptr, 10);
+        } else if (parseOption(argv[i], "--repetitions", &value)) {
+            options.repetitions = std::max(1, std::atoi(value));
+        } else {
+            std::fprintf(stderr, "usage: %s [--max-threads=N] [--max-bytes=N] [--repetitions=N]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    for (std::size_t count = std::size_t(1) << 22; count * sizeof(double) <= options.maxBytes;
+         count *= 4) {
+        for (std::size_t threads = 1; threads <= options.maxThreads; threads *= 2) {
+            coolstd::par::thread_pool pool(threads);
+            const coolstd::par::options dynamic{&pool, 0, coolstd::par::schedule::dynamic};
+            const coolstd::par::options fixed{&pool, 0, coolstd::par::schedule::fixed};
+
+            run("sequential", threads, count, options.repetitions, fixed,
+                [&](std::optional<Vector>& vec) { vec.emplace(count, 1.0); });
+            run("dynamic", threads, count, options.repetitions, fixed,
+                [&](std::optional<Vector>& vec) { vec.emplace(dynamic, count, 1.0); });
+            run("fixed", threads, count, options.repetitions, fixed,
+                [&](std::optional<Vector>& vec) { vec.emplace(fixed, count, 1.0); });
+        }
+    }
+}
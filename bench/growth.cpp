@@ -0,0 +1,57 @@
+// Ingestion workload (push_back of 64-byte records with no reserve) under each growth policy.
+// Reports time, number of reallocations, bytes relocated, and the unused capacity left at the
+// end, which is the memory-versus-reallocations trade-off the policies make.
+
+#include <cstdint>
+
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+struct Record {
+    std::uint64_t fields[8];
+};
+
+template <class GrowthPolicy>
+void ingest(const char* name, std::size_t count) {
+    std::size_t reallocations = 0;
+    std::size_t relocatedBytes = 0;
+    std::size_t finalCapacity = 0;
+
+    const double ns = bench::measure([&] {
+        coolstd::vector<Record, std::allocator<Record>, GrowthPolicy> vec;
+        reallocations = 0;
+        relocatedBytes = 0;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (vec.size() == vec.capacity()) {
+                ++reallocations;
+                relocatedBytes += vec.size() * sizeof(Record);
+            }
+            vec.push_back(Record{{i, i, i, i, i, i, i, i}});
+        }
+
+        finalCapacity = vec.capacity();
+        bench::doNotOptimize(vec.data());
+    });
+
+    bench::report(name, count, ns);
+    std::printf("    reallocations %zu, relocated %.1f MiB, slack %.1f%%\n", reallocations,
+                double(relocatedBytes) / (1 << 20),
+                100.0 * double(finalCapacity - count) / double(finalCapacity));
+}
+
+}  // namespace
+
+int main() {
+    using namespace coolstd::growth;
+
+    for (std::size_t count : {1000u, 100000u, 2000000u}) {
+        ingest<doubling>("ingest/doubling", count);
+        ingest<one_and_a_half>("ingest/one_and_a_half", count);
+        ingest<size_class<one_and_a_half>>("ingest/size_class<one_and_a_half>", count);
+        ingest<size_class<doubling>>("ingest/size_class<doubling>", count);
+        ingest<fixed_increment<65536>>("ingest/fixed_increment<65536>", count);
+    }
+}
@@ -0,0 +1,158 @@
+// Large buffers on 4 KiB against 2 MiB pages: a streaming sum and a dependent random walk over a
+// coolstd::vector<std::uint64_t>, whose buffer comes from
+//   - an anonymous mapping marked MADV_NOHUGEPAGE, for 4 KiB pages whatever the system default,
+//   - std::allocator, which gets whatever the system's transparent huge page setting gives it,
+//   - aligned_allocator<64>,
+//   - huge_page_allocator (MAP_HUGETLB, else MADV_HUGEPAGE).
+// The random walk misses the TLB on nearly every step with 4 KiB pages once the buffer is well
+// past the TLB's reach (a few MiB), which is where 2 MiB pages pay off; the streaming sum is
+// bandwidth-bound and should barely care. Each variant runs in a child process and reports how
+// much of its memory the kernel actually backed with huge pages (AnonHugePages; explicit
+// MAP_HUGETLB pages are not counted there).
+//
+//   huge_pages [--bytes=N] [--steps=N]
+//
+// Linux only.
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <string>
+
+#include "../allocators.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+// 4 KiB pages only, whatever /sys/kernel/mm/transparent_hugepage/enabled says.
+template <class T>
+struct small_page_allocator {
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    small_page_allocator() = default;
+
+    template <class U>
+    constexpr small_page_allocator(const small_page_allocator<U>&) noexcept {
+    }
+
+    T* allocate(std::size_t n) {
+        void* ptr = ::mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        ::madvise(ptr, n * sizeof(T), MADV_NOHUGEPAGE);
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        ::munmap(ptr, n * sizeof(T));
+    }
+
+    friend bool operator==(const small_page_allocator&, const small_page_allocator&) noexcept {
+        return true;
+    }
+};
+
+std::string firstLine(const char* path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line.empty() ? "unavailable" : line;
+}
+
+// AnonHugePages of the whole process, in MiB.
+double anonHugePagesMiB() {
+    std::ifstream in("/proc/self/smaps_rollup");
+    std::string key;
+    double kib = 0;
+    while (in >> key) {
+        if (key == "AnonHugePages:") {
+            in >> kib;
+            break;
+        }
+    }
+    return kib / 1024;
+}
+
+template <class Allocator>
+void run(const char* name, std::size_t count, std::size_t steps) {
+    std::fflush(stdout);
+
+    if (fork() == 0) {
+        // A single random cycle through all elements (Sattolo's shuffle), so each step of the
+        // walk depends on the load before it and lands on an unpredictable page.
+        coolstd::vector<std::uint64_t, Allocator> next(count);
+        std::iota(next.begin(), next.end(), std::uint64_t(0));
+        std::uint64_t state = 88172645463325252ull;
+        for (std::size_t i = count - 1; i > 0; --i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            std::swap(next[i], next[state % i]);
+        }
+
+        const double streaming = bench::measure([&] {
+            std::uint64_t total = 0;
+            for (std::uint64_t value : next) {
+                total += value;
+            }
+            bench::doNotOptimize(total);
+        });
+
+        const double random = bench::measure([&] {
+            std::uint64_t position = 0;
+            for (std::size_t i = 0; i < steps; ++i) {
+                position = next[position];
+            }
+            bench::doNotOptimize(position);
+        });
+
+        std::printf("%-22s stream %7.2f GB/s   random %7.2f ns/step   AnonHugePages %6.0f MiB\n",
+                    name, double(count * sizeof(std::uint64_t)) / streaming,
+                    random / double(steps), anonHugePagesMiB());
+        std::fflush(stdout);
+        std::_Exit(0);
+    }
+
+    int status = 0;
+    wait(&status);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t bytes = std::size_t(512) << 20;
+    std::size_t steps = 10000000;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--bytes=", 8) == 0) {
+            bytes = std::strtoull(argv[i] + 8, nullptr, 10);
+        } else if (std::strncmp(argv[i], "--steps=", 8) == 0) {
+            steps = std::strtoull(argv[i] + 8, nullptr, 10);
+        } else {
+            std::fprintf(stderr, "usage: %s [--bytes=N] [--steps=N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const std::size_t count = std::max<std::size_t>(bytes / sizeof(std::uint64_t), 2);
+    std::printf("%zu MiB buffer, THP %s\n", bytes >> 20,
+                firstLine("/sys/kernel/mm/transparent_hugepage/enabled").c_str());
+
+    run<small_page_allocator<std::uint64_t>>("4 KiB pages", count, steps);
+    run<std::allocator<std::uint64_t>>("std::allocator", count, steps);
+    run<coolstd::aligned_allocator<std::uint64_t>>("aligned_allocator", count, steps);
+    run<coolstd::huge_page_allocator<std::uint64_t>>("huge_page_allocator", count, steps);
+}
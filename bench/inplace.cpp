@@ -0,0 +1,63 @@
+// Short-lived small vectors on a hot path, as in packet processing: each iteration builds a list
+// of up to 15 header offsets, filters it and sums what is left. coolstd::inplace_vector keeps the
+// list on the stack; coolstd::vector and std::vector with reserve(16) pay an allocation and a free
+// per iteration (reserve is only a capacity check on inplace_vector). A second run also copies
+// each list there and back, which for inplace_vector<uint32_t> is a trivial copy of the whole
+// object. Reported per list.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../inplace_vector.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+constexpr std::size_t listCapacity = 16;
+
+template <class List>
+void run(const char* name, std::size_t iterations, bool copy) {
+    bench::report(((copy ? "build+copy/" : "build/") + std::string(name)).c_str(), iterations,
+                  bench::measure([&] {
+                      std::uint64_t total = 0;
+                      std::uint32_t state = 1;
+                      for (std::size_t i = 0; i < iterations; ++i) {
+                          List list;
+                          list.reserve(listCapacity);
+                          const std::size_t count = 4 + (i & 7) + (i >> 3 & 4);
+                          for (std::size_t j = 0; j < count; ++j) {
+                              state = state * 1664525u + 1013904223u;
+                              list.push_back(state >> 20);
+                          }
+                          list.erase(std::remove_if(list.begin(), list.end(),
+                                                    [](std::uint32_t value) { return value & 1; }),
+                                     list.end());
+
+                          if (copy) {
+                              List kept = list;
+                              bench::doNotOptimize(kept.data());
+                              list = kept;
+                          }
+                          for (std::uint32_t value : list) {
+                              total += value;
+                          }
+                      }
+                      bench::doNotOptimize(total);
+                  }));
+}
+
+}  // namespace
+
+int main() {
+    constexpr std::size_t iterations = std::size_t(1) << 22;
+
+    for (bool copy : {false, true}) {
+        run<coolstd::inplace_vector<std::uint32_t, listCapacity>>("inplace_vector", iterations,
+                                                                  copy);
+        run<coolstd::vector<std::uint32_t>>("coolstd::vector+reserve", iterations, copy);
+        run<std::vector<std::uint32_t>>("std::vector+reserve", iterations, copy);
+    }
+}
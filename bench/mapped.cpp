@@ -0,0 +1,136 @@
+// Opening a file of floats: reading it into a coolstd::vector<float> against mapping it with
+// open_mapped, read-only and copy-on-write. Each variant runs in a child process and reports
+// the time until the vector is usable, the time of a first full pass summing it, and the peak
+// RSS. The file is written just before, so it is in the page cache: the read costs a copy into
+// anonymous memory the size of the file, on top of the cache, while the mapping uses the cache
+// pages themselves and only faults them in as the pass touches them. Peak RSS counts mapped
+// cache pages too, so it comes out the same; the difference is that they are shared and
+// reclaimable. Pass --drop-caches (as root) to start cold instead.
+//
+//   mapped [--bytes=N] [--path=FILE] [--drop-caches]
+//
+// POSIX only.
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "../mapped_file.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+template <class Vector>
+double sum(const Vector& vec) {
+    double total = 0.0;
+    for (float value : vec) {
+        total += value;
+    }
+    return total;
+}
+
+// Opens the file with open(), which returns the vector, then sums it; prints the timings.
+template <class Open>
+void run(const char* name, Open open) {
+    std::fflush(stdout);
+
+    if (fork() == 0) {
+        const auto start = std::chrono::steady_clock::now();
+        auto vec = open();
+        const double opened = millisecondsSince(start);
+
+        const auto passStart = std::chrono::steady_clock::now();
+        bench::doNotOptimize(sum(vec));
+        const double pass = millisecondsSince(passStart);
+
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        std::printf("%-28s %10.3f ms open %10.2f ms first pass %8.0f MiB peak RSS\n", name,
+                    opened, pass, double(usage.ru_maxrss) / 1024);
+        std::fflush(stdout);
+        std::_Exit(0);
+    }
+
+    int status = 0;
+    wait(&status);
+}
+
+void dropCaches(bool drop) {
+    if (drop) {
+        sync();
+        if (std::FILE* control = std::fopen("/proc/sys/vm/drop_caches", "w")) {
+            std::fputs("3", control);
+            std::fclose(control);
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t bytes = std::size_t(512) << 20;
+    std::string path = "coolstd_mapped_bench.bin";
+    bool drop = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--bytes=", 8) == 0) {
+            bytes = std::strtoull(argv[i] + 8, nullptr, 10);
+        } else if (std::strncmp(argv[i], "--path=", 7) == 0) {
+            path = argv[i] + 7;
+        } else if (std::strcmp(argv[i], "--drop-caches") == 0) {
+            drop = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--bytes=N] [--path=FILE] [--drop-caches]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    const std::size_t count = bytes / sizeof(float);
+    {
+        coolstd::mapped_file file(path.c_str(), coolstd::map_mode::read_write);
+        auto vec = coolstd::open_mapped<float>(file);
+        vec.resize(count, 1.0f);
+    }
+    std::printf("%zu MiB file %s\n", bytes >> 20, path.c_str());
+
+    dropCaches(drop);
+    run("read into vector<float>", [&] {
+        coolstd::vector<float> vec;
+        vec.resize_for_overwrite(count);
+
+        std::FILE* in = std::fopen(path.c_str(), "rb");
+        if (in == nullptr || std::fread(vec.data(), sizeof(float), count, in) != count) {
+            std::perror("fread");
+            std::exit(1);
+        }
+        std::fclose(in);
+        return vec;
+    });
+
+    for (auto [name, mode] : {std::pair{"open_mapped read_only", coolstd::map_mode::read_only},
+                              std::pair{"open_mapped copy_on_write",
+                                        coolstd::map_mode::copy_on_write}}) {
+        dropCaches(drop);
+        run(name, [&, mode = mode] {
+            // Leaked: the child exits right after using it.
+            auto* file = new coolstd::mapped_file(path.c_str(), mode);
+            file->advise(coolstd::advice::sequential);
+            return coolstd::open_mapped<float>(*file);
+        });
+    }
+
+    std::remove(path.c_str());
+}
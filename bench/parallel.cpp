@@ -0,0 +1,154 @@
+// Scaling of the coolstd::par algorithms: for_each, transform, reduce, sort and erase_if on
+// coolstd::vector<int> with 10^6 to 10^9 elements, on pools of 1 to 64 threads. Each line
+// reports the time and the speedup over the single-thread pool, which runs the plain sequential
+// algorithm.
+//
+//   parallel [--max-threads=N] [--max-bytes=N] [--repetitions=N] [--filter=SUBSTRING]
+//
+// Sizes whose working set would exceed --max-bytes (default 1 GiB) are skipped, so the 10^9 runs
+// need --max-bytes=16000000000 or so.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "../parallel.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+struct Options {
+    std::size_t maxThreads = 64;
+    std::size_t maxBytes = std::size_t(1) << 30;
+    int repetitions = 3;
+    std::string filter;
+};
+
+// Deterministic pseudo-random fill, so every run sorts the same data.
+void scramble(coolstd::vector<int>& vec) {
+    std::uint32_t state = 12345;
+    for (int& n : vec) {
+        state = state * 1664525u + 1013904223u;
+        n = int(state >> 1);
+    }
+}
+
+class Scaling {
+public:
+    explicit Scaling(const Options& options) : options_(options) {
+    }
+
+    template <class Setup, class Op>
+    void run(const std::string& name, std::size_t threads, std::size_t size, Setup setup, Op op) {
+        if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) {
+            return;
+        }
+
+        coolstd::par::thread_pool pool(threads);
+        const coolstd::par::options opts{&pool, 0};
+        const double ns = bench::measureWithSetup(
+            setup, [&](auto& state) { op(state, opts); }, options_.repetitions);
+
+        const std::string key = name + "/" + std::to_string(size);
+        if (threads == 1) {
+            baseline_[key] = ns;
+        }
+
+        std::printf("%-24s %12zu items %3zu threads %10.2f ms %8.2fx\n", name.c_str(), size,
+                    threads, ns / 1e6, baseline_[key] / ns);
+    }
+
+private:
+    Options options_;
+    std::map<std::string, double> baseline_;
+};
+
+bool parseOption(const char* argument, const char* name, const char** value) {
+    const std::size_t length = std::strlen(name);
+
+    if (std::strncmp(argument, name, length) == 0 && argument[length] == '=') {
+        *value = argument + length + 1;
+        return true;
+    }
+
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* value = nullptr;
+
+        if (parseOption(argv[i], "--max-threads", &value)) {
+            options.maxThreads = std::strtoull(value, nullptr, 10);
+        } else if (parseOption(argv[i], "--max-bytes", &value)) {
+            options.maxBytes = std::strtoull(value, nullptr, 10);
+        } else if (parseOption(argv[i], "--repetitions", &value)) {
+            options.repetitions = std::max(1, std::atoi(value));
+        } else if (parseOption(argv[i], "--filter", &value)) {
+            options.filter = value;
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--max-threads=N] [--max-bytes=N] [--repetitions=N] "
+                         "[--filter=SUBSTRING]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    Scaling scaling(options);
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    for (std::size_t size = 1000000; size <= 1000000000; size *= 10) {
+        // Input, output and sort buffer: three ints per element.
+        if (3 * size * sizeof(int) > options.maxBytes) {
+            break;
+        }
+
+        auto filled = [size] {
+            coolstd::vector<int> vec(size);
+            scramble(vec);
+            return vec;
+        };
+        auto pair = [&] { return std::make_pair(filled(), coolstd::vector<int>(size)); };
+
+        for (std::size_t threads = 1; threads <= options.maxThreads; threads *= 2) {
+            scaling.run("for_each", threads, size, filled,
+                        [](coolstd::vector<int>& vec, const coolstd::par::options& opts) {
+                            coolstd::par::for_each(
+                                vec, [](int& n) { n = n / 3 + (n & 7); }, opts);
+                        });
+
+            scaling.run("transform", threads, size, pair, [](auto& state, const auto& opts) {
+                coolstd::par::transform(
+                    state.first, state.second.begin(),
+                    [](int n) { return int(std::sqrt(double(n & 0xFFFF))); }, opts);
+            });
+
+            scaling.run("reduce", threads, size, filled,
+                        [](coolstd::vector<int>& vec, const coolstd::par::options& opts) {
+                            bench::doNotOptimize(
+                                coolstd::par::reduce(vec, std::int64_t(0), std::plus<>(), opts));
+                        });
+
+            scaling.run("sort", threads, size, filled,
+                        [](coolstd::vector<int>& vec, const coolstd::par::options& opts) {
+                            coolstd::par::sort(vec, std::less<>(), opts);
+                        });
+
+            scaling.run("erase_if", threads, size, filled,
+                        [](coolstd::vector<int>& vec, const coolstd::par::options& opts) {
+                            coolstd::par::erase_if(
+                                vec, [](int n) { return n % 3 == 0; }, opts);
+                        });
+        }
+    }
+}
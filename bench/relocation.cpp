@@ -0,0 +1,93 @@
+// Reallocation-heavy workloads for a handle type with and without the trivially_relocatable
+// opt-in. Both variants have identical nothrow move constructors; the tagged one lets vector
+// relocate whole blocks with memcpy/memmove instead of moving and destroying element by element.
+
+#include <memory>
+
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+// Owns nothing so that the measurements are not dominated by the allocator, but keeps
+// unique_ptr's non-trivial move constructor and destructor.
+template <bool Relocatable>
+struct Handle {
+    std::unique_ptr<int> ptr;
+
+    explicit Handle(int) : ptr(nullptr) {
+    }
+    Handle(Handle&&) noexcept = default;
+    Handle& operator=(Handle&&) noexcept = default;
+};
+
+struct RelocatableHandle : Handle<true> {
+    using trivially_relocatable = std::true_type;
+    using Handle<true>::Handle;
+};
+
+using PlainHandle = Handle<false>;
+
+template <class T>
+void pushBack(const char* name, std::size_t count) {
+    const double ns = bench::measure([&] {
+        coolstd::vector<T> vec;
+        vec.reserve(1);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.emplace_back(int(i));
+        }
+        bench::doNotOptimize(vec.data());
+    });
+
+    bench::report(name, count, ns);
+}
+
+template <class T>
+void insertFront(const char* name, std::size_t count) {
+    const double ns = bench::measure([&] {
+        coolstd::vector<T> vec;
+        vec.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.emplace(vec.begin(), int(i));
+        }
+        bench::doNotOptimize(vec.data());
+    });
+
+    bench::report(name, count, ns);
+}
+
+template <class T>
+void eraseFront(const char* name, std::size_t count) {
+    const double ns = bench::measure([&] {
+        coolstd::vector<T> vec;
+        vec.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.emplace_back(int(i));
+        }
+        while (!vec.empty()) {
+            vec.erase(vec.begin());
+        }
+        bench::doNotOptimize(vec.data());
+    });
+
+    bench::report(name, count, ns);
+}
+
+}  // namespace
+
+int main() {
+    for (std::size_t count : {1000u, 100000u, 1000000u}) {
+        pushBack<PlainHandle>("push_back/move+destroy", count);
+        pushBack<RelocatableHandle>("push_back/trivially_relocatable", count);
+    }
+
+    for (std::size_t count : {1000u, 10000u, 30000u}) {
+        insertFront<PlainHandle>("insert_front/move+destroy", count);
+        insertFront<RelocatableHandle>("insert_front/trivially_relocatable", count);
+        eraseFront<PlainHandle>("erase_front/move+destroy", count);
+        eraseFront<RelocatableHandle>("erase_front/trivially_relocatable", count);
+    }
+}
@@ -0,0 +1,66 @@
+// Bulk I/O fills: a payload buffer is sized and then overwritten in full, the way a read() into
+// a vector<char> or a decoder writing vector<float> would. resize() zeroes every byte before
+// the payload lands; resize_for_overwrite() and resize_and_overwrite() skip that pass.
+
+#include <cstring>
+
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+constexpr std::size_t MiB = std::size_t(1) << 20;
+
+// Stands in for the read: touches every byte once.
+template <class T>
+void receive(T* data, std::size_t count) {
+    std::memset(static_cast<void*>(data), 0x5a, count * sizeof(T));
+}
+
+template <class T>
+void fill(const char* name, std::size_t bytes, int repetitions) {
+    const std::size_t count = bytes / sizeof(T);
+    char label[64];
+
+    coolstd::vector<T> vec;
+    vec.reserve(count);
+
+    std::snprintf(label, sizeof(label), "%s/resize/%zuMiB", name, bytes / MiB);
+    bench::report(label, count, bench::measure([&] {
+                      vec.clear();
+                      vec.resize(count);
+                      receive(vec.data(), count);
+                      bench::doNotOptimize(vec.data());
+                  }, repetitions));
+
+    std::snprintf(label, sizeof(label), "%s/resize_for_overwrite/%zuMiB", name, bytes / MiB);
+    bench::report(label, count, bench::measure([&] {
+                      vec.clear();
+                      vec.resize_for_overwrite(count);
+                      receive(vec.data(), count);
+                      bench::doNotOptimize(vec.data());
+                  }, repetitions));
+
+    std::snprintf(label, sizeof(label), "%s/resize_and_overwrite/%zuMiB", name, bytes / MiB);
+    bench::report(label, count, bench::measure([&] {
+                      vec.clear();
+                      vec.resize_and_overwrite(count, [](T* data, std::size_t n) {
+                          receive(data, n);
+                          return n;
+                      });
+                      bench::doNotOptimize(vec.data());
+                  }, repetitions));
+}
+
+}  // namespace
+
+int main() {
+    // The buffer is reserved once per size, so page faults are paid outside the measurement and
+    // the comparison isolates the zeroing pass.
+    for (std::size_t bytes : {MiB, 16 * MiB, 256 * MiB, 1024 * MiB}) {
+        const int repetitions = bytes >= 256 * MiB ? 3 : 10;
+
+        fill<char>("char", bytes, repetitions);
+        fill<float>("float", bytes, repetitions);
+    }
+}
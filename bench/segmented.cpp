@@ -0,0 +1,97 @@
+// Appending 10^7 to 10^9 elements one push_back at a time, to coolstd::vector and to
+// coolstd::segmented_vector. Each run happens in a child process so that its peak resident set
+// (getrusage's ru_maxrss) belongs to that container alone, plus the 4-byte-per-element latency
+// log both variants share. Every append is timed separately and the report gives the latency
+// percentiles: vector's median is lower, but each doubling stalls one append for a copy of
+// everything, which shows in the tail and in a peak RSS of up to 3x the data, where
+// segmented_vector stays at the data plus one segment.
+//
+//   segmented [--max-bytes=N]
+//
+// Sizes whose data would exceed --max-bytes (default 1 GiB) are skipped; vector needs about three
+// times that at its peak. POSIX only.
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../segmented_vector.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+// Appends count elements, timing each; prints the latency percentiles and the peak RSS.
+template <class Container>
+void appendAndReport(const char* name, std::size_t count) {
+    std::vector<std::uint32_t> latencies(count);  // touched up front, before the container grows
+    Container container;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        container.push_back(std::uint64_t(i));
+        const auto stop = std::chrono::steady_clock::now();
+
+        latencies[i] = std::uint32_t(std::min<std::int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count(),
+            UINT32_MAX));
+    }
+    bench::doNotOptimize(container.back());
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::sort(latencies.begin(), latencies.end());
+
+    auto percentile = [&](double p) { return latencies[std::size_t(double(count - 1) * p)]; };
+    std::printf("%-20s %12zu items %8.0f MiB data %8.0f MiB peak RSS   p50 %5u ns  p99 %5u ns"
+                "  p99.99 %7u ns  max %10u ns\n",
+                name, count, double(count * sizeof(std::uint64_t)) / (1 << 20),
+                double(usage.ru_maxrss) / 1024, percentile(0.5), percentile(0.99),
+                percentile(0.9999), latencies.back());
+}
+
+// Runs fn in a child process and waits for it.
+template <class Fn>
+void isolated(Fn fn) {
+    std::fflush(stdout);
+
+    const pid_t child = fork();
+    if (child == 0) {
+        fn();
+        std::fflush(stdout);
+        std::_Exit(0);
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t maxBytes = std::size_t(1) << 30;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--max-bytes=", 12) == 0) {
+            maxBytes = std::strtoull(argv[i] + 12, nullptr, 10);
+        } else {
+            std::fprintf(stderr, "usage: %s [--max-bytes=N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    for (std::size_t count = 10000000; count * sizeof(std::uint64_t) <= maxBytes; count *= 10) {
+        isolated([count] { appendAndReport<coolstd::vector<std::uint64_t>>("vector", count); });
+        isolated([count] {
+            appendAndReport<coolstd::segmented_vector<std::uint64_t>>("segmented_vector", count);
+        });
+    }
+}
@@ -0,0 +1,122 @@
+// Round-trip throughput of a coolstd::vector<double> through a file: write_to/read_from on a
+// file descriptor (one writev, one read) and on a std::fstream, against writing and reading the
+// elements one at a time through the stream, the way a generic serializer would. The last line
+// is the cost of opening the written file as a vector_view over a mapping, which copies nothing
+// and so doesn't depend on the size. Reported in GB/s of payload per direction.
+//
+//   serialize [--bytes=N] [--path=FILE]
+//
+// POSIX only. The file stays in the page cache, so this measures the copies, not the disk.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <string>
+
+#include "../mapped_file.h"
+#include "../serialize.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+void reportThroughput(const char* name, std::size_t bytes, double writeNs, double readNs) {
+    std::printf("%-32s write %8.2f GB/s   read %8.2f GB/s\n", name, double(bytes) / writeNs,
+                double(bytes) / readNs);
+}
+
+int openOrDie(const std::string& path, int flags) {
+    const int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        std::perror("open");
+        std::exit(1);
+    }
+    return fd;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t bytes = std::size_t(256) << 20;
+    std::string path = "coolstd_serialize_bench.bin";
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--bytes=", 8) == 0) {
+            bytes = std::strtoull(argv[i] + 8, nullptr, 10);
+        } else if (std::strncmp(argv[i], "--path=", 7) == 0) {
+            path = argv[i] + 7;
+        } else {
+            std::fprintf(stderr, "usage: %s [--bytes=N] [--path=FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const std::size_t count = bytes / sizeof(double);
+    coolstd::vector<double> source(count);
+    std::iota(source.begin(), source.end(), 0.0);
+    coolstd::vector<double> loaded;
+
+    const double fdWrite = bench::measure([&] {
+        const int fd = openOrDie(path, O_WRONLY | O_CREAT | O_TRUNC);
+        coolstd::write_to(fd, source);
+        ::close(fd);
+    });
+    const double fdRead = bench::measure([&] {
+        const int fd = openOrDie(path, O_RDONLY);
+        coolstd::read_from(fd, loaded);
+        ::close(fd);
+    });
+    reportThroughput("write_to/read_from fd", bytes, fdWrite, fdRead);
+
+    const double streamWrite = bench::measure([&] {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        coolstd::write_to(out, source);
+    });
+    const double streamRead = bench::measure([&] {
+        std::ifstream in(path, std::ios::binary);
+        coolstd::read_from(in, loaded);
+    });
+    reportThroughput("write_to/read_from fstream", bytes, streamWrite, streamRead);
+
+    const double elementWrite = bench::measure([&] {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        const std::uint64_t size = source.size();
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        for (double value : source) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    });
+    const double elementRead = bench::measure([&] {
+        std::ifstream in(path, std::ios::binary);
+        std::uint64_t size = 0;
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+        loaded.clear();
+        loaded.reserve(size);
+        for (std::uint64_t i = 0; i < size; ++i) {
+            double value;
+            in.read(reinterpret_cast<char*>(&value), sizeof(value));
+            loaded.push_back(value);
+        }
+    });
+    reportThroughput("per-element fstream", bytes, elementWrite, elementRead);
+    bench::doNotOptimize(loaded.back());
+
+    {
+        const int fd = openOrDie(path, O_WRONLY | O_CREAT | O_TRUNC);
+        coolstd::write_to(fd, source);
+        ::close(fd);
+    }
+    const double viewOpen = bench::measure([&] {
+        coolstd::mapped_file file(path.c_str());
+        const coolstd::vector_view<double> view(file.data(), file.size());
+        bench::doNotOptimize(view.size());
+    });
+    bench::report("mapped_file + vector_view open", count, viewOpen);
+
+    std::remove(path.c_str());
+}
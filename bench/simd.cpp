@@ -0,0 +1,124 @@
+// Fill, copy and compare throughput for arithmetic element types, in GB/s of elements written or
+// compared. Each kernel runs at every SIMD level the CPU supports and is compared against the
+// element-by-element loops vector used before (which the compiler may or may not vectorize).
+// Buffers are allocated and touched up front, so the numbers exclude page faults; sizes cover
+// L1, L2 and main memory.
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../simd.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+void reportBandwidth(const std::string& name, std::size_t bytes, double nanoseconds) {
+    std::printf("%-48s %12zu bytes %10.2f GB/s\n", name.c_str(), bytes,
+                double(bytes) / nanoseconds);
+}
+
+template <class T>
+std::size_t loopMismatch(const T* lhs, const T* rhs, std::size_t count) {
+    std::size_t i = 0;
+    for (; i < count && lhs[i] == rhs[i]; ++i) {
+    }
+    return i;
+}
+
+template <class T>
+void run(const char* type, std::size_t bytes) {
+    const std::size_t count = bytes / sizeof(T);
+    const std::size_t repeat = std::max<std::size_t>(1, (std::size_t(64) << 20) / bytes);
+    const std::size_t total = repeat * count * sizeof(T);
+    const std::string suffix = std::string("/") + type + "/" + std::to_string(bytes);
+    const T value = T(42);
+
+    std::vector<T> source(count, value);
+    std::vector<T> target(count, T(0));
+    coolstd::vector<T> custom_vec(count, T(0));
+    coolstd::vector<T> other(count, value);
+
+    auto time = [&](const std::string& name, auto fn) {
+        reportBandwidth(name + suffix, total, bench::measure([&] {
+                            for (std::size_t r = 0; r < repeat; ++r) {
+                                fn();
+                            }
+                        }));
+    };
+
+    time("fill/loop", [&] {
+        T* out = target.data();
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = value;
+        }
+        bench::doNotOptimize(out);
+    });
+
+    for (coolstd::simd::isa level : {coolstd::simd::isa::scalar, coolstd::simd::isa::sse2,
+                                     coolstd::simd::isa::avx2, coolstd::simd::isa::avx512}) {
+        if (coolstd::simd::select(level) != level) {
+            continue;
+        }
+
+        time(std::string("fill/") + coolstd::simd::name(level), [&] {
+            coolstd::simd::fill(target.data(), count, value);
+            bench::doNotOptimize(target.data());
+        });
+        time(std::string("equal/") + coolstd::simd::name(level), [&] {
+            bench::doNotOptimize(coolstd::simd::mismatch(source.data(), target.data(), count));
+        });
+    }
+    coolstd::simd::select(coolstd::simd::isa::avx512);
+
+    time("vector::assign(n, value)", [&] {
+        custom_vec.assign(count, value);
+        bench::doNotOptimize(custom_vec.data());
+    });
+
+    time("copy/loop", [&] {
+        const T* in = source.data();
+        T* out = target.data();
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = in[i];
+        }
+        bench::doNotOptimize(out);
+    });
+    time("copy/vector::assign(first, last)", [&] {
+        custom_vec.assign(source.begin(), source.end());
+        bench::doNotOptimize(custom_vec.data());
+    });
+
+    time("equal/loop", [&] {
+        bench::doNotOptimize(loopMismatch(source.data(), target.data(), count));
+    });
+    time("equal/vector::operator==", [&] { bench::doNotOptimize(custom_vec == other); });
+
+    time("compare/std::lex_compare_three_way", [&] {
+        const auto order = std::lexicographical_compare_three_way(
+            source.begin(), source.end(), target.begin(), target.end());
+        bench::doNotOptimize(order == 0);
+    });
+    time("compare/vector::operator<=>", [&] {
+        bench::doNotOptimize((custom_vec <=> other) == 0);
+    });
+}
+
+}  // namespace
+
+int main() {
+    std::printf("best SIMD level: %s\n", coolstd::simd::name(coolstd::simd::level()));
+
+    for (std::size_t kib : {16, 256, 65536}) {
+        const std::size_t bytes = kib << 10;
+        std::printf("-- %zu KiB\n", kib);
+        run<float>("float", bytes);
+        run<std::int32_t>("int32", bytes);
+        run<std::uint8_t>("uint8", bytes);
+    }
+}
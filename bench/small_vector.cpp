@@ -0,0 +1,86 @@
+// Short-lived per-request lists: each simulated request collects a handful of small records and
+// throws them away. Most requests stay under the inline capacity, so small_vector should serve
+// them without touching the allocator; the report shows allocations per request alongside time.
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+#include "../small_vector.h"
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+std::size_t allocations = 0;
+
+template <class T>
+struct CountingAllocator : std::allocator<T> {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {
+    }
+
+    T* allocate(std::size_t n) {
+        ++allocations;
+        return std::allocator<T>::allocate(n);
+    }
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        std::allocator<T>::deallocate(ptr, n);
+    }
+
+    template <class U>
+    struct rebind {
+        using other = CountingAllocator<U>;
+    };
+};
+
+struct Token {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+// Deterministic request sizes: mostly 0-8 tokens, one request in sixteen needs 9-40.
+std::size_t tokensFor(std::size_t request) {
+    const std::size_t hash = request * 2654435761u;
+
+    return (hash >> 7) % 16 == 0 ? 9 + (hash >> 11) % 32 : (hash >> 11) % 9;
+}
+
+template <class Vector>
+void serve(const char* name, std::size_t requests) {
+    std::size_t counted = 0;
+
+    const double ns = bench::measure([&] {
+        allocations = 0;
+
+        for (std::size_t r = 0; r < requests; ++r) {
+            Vector tokens;
+            const std::size_t n = tokensFor(r);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                tokens.push_back(Token{std::uint32_t(i * 4), 4});
+            }
+            bench::doNotOptimize(tokens.data());
+        }
+
+        counted = allocations;
+    });
+
+    bench::report(name, requests, ns);
+    std::printf("%-48s %12.3f allocations/request\n", "", double(counted) / double(requests));
+}
+
+}  // namespace
+
+int main() {
+    using Allocator = CountingAllocator<Token>;
+
+    for (std::size_t requests : {10000u, 1000000u}) {
+        serve<coolstd::vector<Token, Allocator>>("vector", requests);
+        serve<coolstd::small_vector<Token, 8, Allocator>>("small_vector<8>", requests);
+        serve<coolstd::small_vector<Token, 16, Allocator>>("small_vector<16>", requests);
+    }
+}
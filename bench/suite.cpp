@@ -0,0 +1,332 @@
+// Regression suite: every common vector operation, timed for coolstd::vector and std::vector
+// across int, std::string, a 64-byte POD and a move-only type, at sizes from 8 to 10^8. A table
+// goes to stdout and the results to a JSON file in Google Benchmark's format.
+//
+//   suite [--filter=SUBSTRING] [--max-size=N] [--max-bytes=N] [--repetitions=N] [--json=PATH]
+//
+// Sizes whose working set (two vectors of N elements) would exceed --max-bytes, 1 GiB by
+// default, are skipped. Insert and erase at the front and middle do at most 1024 operations
+// per vector so that the large sizes finish.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../vector.h"
+#include "bench.h"
+
+namespace {
+
+struct Pod64 {
+    std::uint64_t fields[8];
+};
+
+using MoveOnly = std::unique_ptr<int>;
+
+template <class T>
+struct Element;
+
+template <>
+struct Element<int> {
+    static constexpr const char* name = "int";
+    static constexpr std::size_t footprint = sizeof(int);
+
+    static int make(std::size_t i) {
+        return int(i);
+    }
+    template <class Vector>
+    static void emplace(Vector& vec, std::size_t i) {
+        vec.emplace_back(int(i));
+    }
+};
+
+// 32 characters: longer than any small-string buffer, so every element owns a heap block.
+template <>
+struct Element<std::string> {
+    static constexpr const char* name = "string";
+    static constexpr std::size_t footprint = sizeof(std::string) + 48;
+
+    static std::string make(std::size_t i) {
+        return std::string(32, char('a' + i % 26));
+    }
+    template <class Vector>
+    static void emplace(Vector& vec, std::size_t i) {
+        vec.emplace_back(32, char('a' + i % 26));
+    }
+};
+
+template <>
+struct Element<Pod64> {
+    static constexpr const char* name = "pod64";
+    static constexpr std::size_t footprint = sizeof(Pod64);
+
+    static Pod64 make(std::size_t i) {
+        return Pod64{{i, i, i, i, i, i, i, i}};
+    }
+    template <class Vector>
+    static void emplace(Vector& vec, std::size_t i) {
+        vec.emplace_back(make(i));
+    }
+};
+
+template <>
+struct Element<MoveOnly> {
+    static constexpr const char* name = "move_only";
+    static constexpr std::size_t footprint = sizeof(MoveOnly) + 32;
+
+    static MoveOnly make(std::size_t i) {
+        return std::make_unique<int>(int(i));
+    }
+    template <class Vector>
+    static void emplace(Vector& vec, std::size_t i) {
+        vec.emplace_back(new int(int(i)));
+    }
+};
+
+template <class T>
+using CoolVector = coolstd::vector<T>;
+
+template <class T>
+using StdVector = std::vector<T>;
+
+struct Options {
+    std::string filter;
+    std::size_t maxSize = 100000000;
+    std::size_t maxBytes = std::size_t(1) << 30;
+    int repetitions = 5;
+    std::string json = "bench_suite.json";
+};
+
+class Suite {
+public:
+    explicit Suite(Options options) : options_(std::move(options)) {
+    }
+
+    const Options& options() const {
+        return options_;
+    }
+    const std::vector<bench::Result>& results() const {
+        return results_;
+    }
+
+    // Times op(state) on enough fresh states from setup() to cover ~16K elements, and records
+    // the time per state. items is the number of elements one op call processes.
+    template <class Setup, class Op>
+    void run(const std::string& name, std::size_t size, std::size_t items, Setup setup, Op op) {
+        if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) {
+            return;
+        }
+
+        const std::size_t batch = std::max<std::size_t>(1, (std::size_t(1) << 14) / size);
+        using State = decltype(setup());
+
+        const double ns = bench::measureWithSetup(
+            [&] {
+                std::vector<State> states;
+                states.reserve(batch);
+                for (std::size_t i = 0; i < batch; ++i) {
+                    states.push_back(setup());
+                }
+                return states;
+            },
+            [&](std::vector<State>& states) {
+                for (State& state : states) {
+                    op(state);
+                }
+            },
+            options_.repetitions);
+
+        results_.push_back({name, batch, items, ns / double(batch)});
+        bench::report(name.c_str(), items, ns / double(batch));
+    }
+
+private:
+    Options options_;
+    std::vector<bench::Result> results_;
+};
+
+template <class Vector>
+struct Pair {
+    Vector source;
+    std::optional<Vector> target;
+};
+
+template <template <class> class Vector, class T>
+void runType(Suite& suite, const char* container) {
+    using V = Vector<T>;
+    using E = Element<T>;
+
+    const std::size_t sizes[] = {8,      64,      512,      4096,     32768,
+                                 262144, 2097152, 16777216, 100000000};
+
+    for (const std::size_t size : sizes) {
+        if (size > suite.options().maxSize || 2 * size * E::footprint > suite.options().maxBytes) {
+            break;
+        }
+
+        const std::string prefix = std::string(container) + "/" + E::name + "/";
+        const std::string suffix = "/" + std::to_string(size);
+        const std::size_t ops = std::min<std::size_t>(size, 1024);
+
+        auto filled = [size] {
+            V vec;
+            vec.reserve(size);
+            for (std::size_t i = 0; i < size; ++i) {
+                vec.push_back(E::make(i));
+            }
+            return vec;
+        };
+        auto pair = [&] { return Pair<V>{filled(), std::nullopt}; };
+        auto empty = [] { return V(); };
+        auto reserved = [size] {
+            V vec;
+            vec.reserve(size);
+            return vec;
+        };
+
+        suite.run(
+            prefix + "construct" + suffix, size, size, [] { return std::optional<V>(); },
+            [size](std::optional<V>& vec) { vec.emplace(size); });
+
+        if constexpr (std::is_copy_constructible_v<T>) {
+            suite.run(prefix + "copy" + suffix, size, size, pair,
+                      [](Pair<V>& state) { state.target.emplace(state.source); });
+
+            suite.run(
+                prefix + "assign" + suffix, size, size,
+                [&] {
+                    Pair<V> state{filled(), filled()};
+                    state.target->resize(size / 2);
+                    return state;
+                },
+                [](Pair<V>& state) {
+                    state.target->assign(state.source.begin(), state.source.end());
+                });
+        }
+
+        suite.run(prefix + "move" + suffix, size, size, pair,
+                  [](Pair<V>& state) { state.target.emplace(std::move(state.source)); });
+
+        auto pushBack = [size](V& vec) {
+            for (std::size_t i = 0; i < size; ++i) {
+                vec.push_back(E::make(i));
+            }
+        };
+        auto emplaceBack = [size](V& vec) {
+            for (std::size_t i = 0; i < size; ++i) {
+                E::emplace(vec, i);
+            }
+        };
+
+        suite.run(prefix + "push_back" + suffix, size, size, empty, pushBack);
+        suite.run(prefix + "push_back_reserved" + suffix, size, size, reserved, pushBack);
+        suite.run(prefix + "emplace_back" + suffix, size, size, empty, emplaceBack);
+        suite.run(prefix + "emplace_back_reserved" + suffix, size, size, reserved, emplaceBack);
+
+        const auto front = [](const V&) { return std::size_t(0); };
+        const auto middle = [](const V& vec) { return vec.size() / 2; };
+        const auto back = [](const V& vec) { return vec.size(); };
+
+        auto insertAt = [ops](auto position) {
+            return [ops, position](V& vec) {
+                for (std::size_t i = 0; i < ops; ++i) {
+                    vec.insert(vec.begin() + std::ptrdiff_t(position(vec)), E::make(i));
+                }
+            };
+        };
+        auto eraseAt = [ops](auto position) {
+            return [ops, position](V& vec) {
+                for (std::size_t i = 0; i < ops; ++i) {
+                    vec.erase(vec.begin() + std::ptrdiff_t(std::min(position(vec),
+                                                                    vec.size() - 1)));
+                }
+            };
+        };
+
+        suite.run(prefix + "insert_front" + suffix, size, ops, filled, insertAt(front));
+        suite.run(prefix + "insert_middle" + suffix, size, ops, filled, insertAt(middle));
+        suite.run(prefix + "insert_back" + suffix, size, ops, filled, insertAt(back));
+        suite.run(prefix + "erase_front" + suffix, size, ops, filled, eraseAt(front));
+        suite.run(prefix + "erase_middle" + suffix, size, ops, filled, eraseAt(middle));
+        suite.run(prefix + "erase_back" + suffix, size, ops, filled, eraseAt(back));
+
+        suite.run(prefix + "resize" + suffix, size, size, empty,
+                  [size](V& vec) { vec.resize(size); });
+
+        suite.run(
+            prefix + "shrink_to_fit" + suffix, size, size,
+            [&] {
+                V vec = filled();
+                vec.reserve(size + size / 2);
+                return vec;
+            },
+            [](V& vec) { vec.shrink_to_fit(); });
+    }
+}
+
+template <class T>
+void runBoth(Suite& suite) {
+    runType<CoolVector, T>(suite, "coolstd");
+    runType<StdVector, T>(suite, "std");
+}
+
+bool parseOption(const char* argument, const char* name, const char** value) {
+    const std::size_t length = std::strlen(name);
+
+    if (std::strncmp(argument, name, length) == 0 && argument[length] == '=') {
+        *value = argument + length + 1;
+        return true;
+    }
+
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* value = nullptr;
+
+        if (parseOption(argv[i], "--filter", &value)) {
+            options.filter = value;
+        } else if (parseOption(argv[i], "--max-size", &value)) {
+            options.maxSize = std::strtoull(value, nullptr, 10);
+        } else if (parseOption(argv[i], "--max-bytes", &value)) {
+            options.maxBytes = std::strtoull(value, nullptr, 10);
+        } else if (parseOption(argv[i], "--repetitions", &value)) {
+            options.repetitions = std::max(1, std::atoi(value));
+        } else if (parseOption(argv[i], "--json", &value)) {
+            options.json = value;
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--filter=SUBSTRING] [--max-size=N] [--max-bytes=N] "
+                         "[--repetitions=N] [--json=PATH]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    Suite suite(options);
+
+    runBoth<int>(suite);
+    runBoth<std::string>(suite);
+    runBoth<Pod64>(suite);
+    runBoth<MoveOnly>(suite);
+
+    std::FILE* out = std::fopen(options.json.c_str(), "w");
+    if (out == nullptr) {
+        std::perror(options.json.c_str());
+        return 1;
+    }
+    bench::writeJson(out, argv[0], suite.results());
+    std::fclose(out);
+
+    std::printf("wrote %zu results to %s\n", suite.results().size(), options.json.c_str());
+}
@@ -0,0 +1,583 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+#include "vector.h"
+
+namespace coolstd {
+// An append-only vector for many producer threads. Storage is a list of segments that double in
+// size, so growing allocates a new segment instead of relocating: elements never move and
+// references, pointers and iterators stay valid until clear() or destruction.
+//
+// push_back, emplace_back and grow_by may run concurrently with each other and with reads of
+// elements already published to the reader: each claims its indices with one atomic increment
+// and, when it is the first to reach a segment that doesn't exist yet, allocates it and installs
+// it with a compare-exchange (a thread that loses that race frees its block). No thread ever
+// waits for another. size() counts claimed indices, including elements still being constructed,
+// so a reader must learn of an element from its producer (the returned iterator, or joining the
+// producer) before reading it. Everything else, from clear() to copy and assignment, needs
+// exclusive access. Allocator must be safe to call from several threads at once.
+//
+// An element whose constructor throws is replaced by a value-initialized T before the exception
+// propagates, since its index has already been handed out; T must therefore be nothrow default
+// constructible. If a segment can't be allocated the exception propagates and the elements of
+// that segment and all later ones are never destroyed, only deallocated.
+template <class T, class Allocator = std::allocator<T>>
+class concurrent_vector {
+    static_assert(std::is_nothrow_default_constructible_v<T>,
+                  "failed constructions are replaced by value-initialized elements");
+
+    template <bool Const>
+    class Iterator;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Elements in segment 0; segment k > 0 holds first_segment << (k - 1) of them, so the first
+    // k segments hold first_segment << (k - 1) in total. A power of two close to one page.
+    static constexpr size_type first_segment =
+        std::bit_floor(std::max<size_type>(1, 4096 / sizeof(T)));
+
+    // construct/copy/destroy
+    concurrent_vector() noexcept(noexcept(Allocator())) : concurrent_vector(Allocator()) {
+    }
+    explicit concurrent_vector(const Allocator& alloc) noexcept : allocator(alloc) {
+    }
+    explicit concurrent_vector(size_type count, const Allocator& alloc = Allocator())
+        : concurrent_vector(alloc) {
+        guarded([&] { grow_by(count); });
+    }
+    concurrent_vector(size_type count, const T& value, const Allocator& alloc = Allocator())
+        : concurrent_vector(alloc) {
+        guarded([&] { grow_by(count, value); });
+    }
+    concurrent_vector(std::initializer_list<T> initializerList,
+                      const Allocator& alloc = Allocator())
+        : concurrent_vector(alloc) {
+        guarded([&] { appendCopy(initializerList.begin(), initializerList.size()); });
+    }
+    concurrent_vector(const concurrent_vector& copyVector)
+        : concurrent_vector(std::allocator_traits<Allocator>::select_on_container_copy_construction(
+              copyVector.allocator)) {
+        guarded([&] { appendCopy(copyVector.begin(), copyVector.size()); });
+    }
+    concurrent_vector(concurrent_vector&& moveVector) noexcept
+        : allocator(std::move(moveVector.allocator)) {
+        takeFrom(moveVector);
+    }
+
+    ~concurrent_vector() {
+        clear();
+        releaseSegments();
+    }
+
+    concurrent_vector& operator=(const concurrent_vector& copyVector);
+    concurrent_vector& operator=(concurrent_vector&& moveVector) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+    allocator_type get_allocator() const noexcept {
+        return allocator;
+    }
+
+    // iterators
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size());
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size());
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    // capacity
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+    size_type size() const noexcept {
+        return sz_.load(std::memory_order_acquire);
+    }
+    // Elements that fit in the segments allocated so far, counting from index 0.
+    size_type capacity() const noexcept;
+    size_type max_size() const noexcept {
+        return std::allocator_traits<Allocator>::max_size(allocator) / 2;
+    }
+    // Allocates the segments holding indices [0, count). Safe to call concurrently with appends.
+    void reserve(size_type count);
+
+    // element access
+    reference operator[](size_type n) noexcept {
+        return slot(n);
+    }
+    const_reference operator[](size_type n) const noexcept {
+        return slot(n);
+    }
+    reference at(size_type pos) {
+        if (pos < size()) {
+            return slot(pos);
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    const_reference at(size_type pos) const {
+        if (pos < size()) {
+            return slot(pos);
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    reference front() noexcept {
+        return slot(0);
+    }
+    const_reference front() const noexcept {
+        return slot(0);
+    }
+    reference back() noexcept {
+        return slot(size() - 1);
+    }
+    const_reference back() const noexcept {
+        return slot(size() - 1);
+    }
+
+    // modifiers
+    template <class... Args>
+    iterator emplace_back(Args&&... args);
+    iterator push_back(const T& value) {
+        return emplace_back(value);
+    }
+    iterator push_back(T&& value) {
+        return emplace_back(std::move(value));
+    }
+    // Appends count contiguous elements, value-initialized or copies of value, and returns an
+    // iterator to the first.
+    iterator grow_by(size_type count);
+    iterator grow_by(size_type count, const T& value);
+
+    // Destroys every element and keeps the segments for reuse.
+    void clear() noexcept;
+    void swap(concurrent_vector& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+private:
+    static constexpr size_type firstSegmentBits = size_type(std::countr_zero(first_segment));
+    // Enough segments to address every size_type index.
+    static constexpr size_type segmentCount =
+        size_type(std::numeric_limits<size_type>::digits) - firstSegmentBits + 1;
+
+    std::array<std::atomic<T*>, segmentCount> segments_{};
+    std::atomic<size_type> sz_{0};
+    // Lowest segment whose allocation failed; elements from there on are not destroyed.
+    std::atomic<size_type> broken_{segmentCount};
+    [[no_unique_address]] Allocator allocator;
+
+    static size_type segmentOf(size_type index) noexcept {
+        return index < first_segment ? 0
+                                     : size_type(std::bit_width(index)) - firstSegmentBits;
+    }
+    static size_type segmentBegin(size_type segment) noexcept {
+        return segment == 0 ? 0 : first_segment << (segment - 1);
+    }
+    static size_type segmentSize(size_type segment) noexcept {
+        return segment == 0 ? first_segment : first_segment << (segment - 1);
+    }
+
+    T& slot(size_type index) const noexcept {
+        const size_type segment = segmentOf(index);
+
+        return segments_[segment].load(std::memory_order_acquire)[index - segmentBegin(segment)];
+    }
+
+    // Returns the given segment, allocating it if no thread has yet.
+    T* segment(size_type segment);
+
+    // Claims count indices and constructs them with construct(destination, n), segment piece by
+    // segment piece. construct must construct all n elements or, on throwing, none of them.
+    template <class Construct>
+    iterator append(size_type count, Construct construct);
+
+    // Appends copies of count elements starting at first; used with exclusive access only.
+    template <class Iterator>
+    void appendCopy(Iterator first, size_type count) {
+        append(count, [&](T* destination, size_type n) {
+            detail::uninitializedCopyN(allocator, first, n, destination);
+            std::advance(first, n);
+        });
+    }
+
+    // Runs a constructor body, cleaning up on failure since the destructor won't run.
+    template <class Body>
+    void guarded(Body body) {
+        try {
+            body();
+        } catch (...) {
+            clear();
+            releaseSegments();
+            throw;
+        }
+    }
+
+    // Moves the segments of other, with an equal allocator, into *this, which has none.
+    void takeFrom(concurrent_vector& other) noexcept;
+    // Frees every segment; elements must already have been destroyed.
+    void releaseSegments() noexcept;
+};
+
+template <class T, class Allocator>
+template <bool Const>
+class concurrent_vector<T, Allocator>::Iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    Iterator() = default;
+    Iterator(std::conditional_t<Const, const concurrent_vector*, concurrent_vector*> owner,
+             size_type index)
+        : owner_(owner), index_(index) {
+    }
+    // iterator converts to const_iterator.
+    template <bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    Iterator(const Iterator<OtherConst>& other) : owner_(other.owner_), index_(other.index_) {
+    }
+
+    reference operator*() const {
+        return owner_->slot(index_);
+    }
+    pointer operator->() const {
+        return &owner_->slot(index_);
+    }
+    reference operator[](difference_type n) const {
+        return owner_->slot(size_type(difference_type(index_) + n));
+    }
+
+    Iterator& operator++() {
+        ++index_;
+        return *this;
+    }
+    Iterator operator++(int) {
+        Iterator old = *this;
+        ++index_;
+        return old;
+    }
+    Iterator& operator--() {
+        --index_;
+        return *this;
+    }
+    Iterator operator--(int) {
+        Iterator old = *this;
+        --index_;
+        return old;
+    }
+    Iterator& operator+=(difference_type n) {
+        index_ = size_type(difference_type(index_) + n);
+        return *this;
+    }
+    Iterator& operator-=(difference_type n) {
+        index_ = size_type(difference_type(index_) - n);
+        return *this;
+    }
+    Iterator operator+(difference_type n) const {
+        return Iterator(owner_, size_type(difference_type(index_) + n));
+    }
+    friend Iterator operator+(difference_type n, const Iterator& it) {
+        return it + n;
+    }
+    Iterator operator-(difference_type n) const {
+        return Iterator(owner_, size_type(difference_type(index_) - n));
+    }
+    difference_type operator-(const Iterator& it) const {
+        return difference_type(index_) - difference_type(it.index_);
+    }
+
+    bool operator==(const Iterator& rhs) const {
+        return index_ == rhs.index_;
+    }
+    auto operator<=>(const Iterator& rhs) const {
+        return index_ <=> rhs.index_;
+    }
+
+private:
+    template <bool>
+    friend class Iterator;
+
+    std::conditional_t<Const, const concurrent_vector*, concurrent_vector*> owner_ = nullptr;
+    size_type index_ = 0;
+};
+
+template <class T, class Allocator>
+concurrent_vector<T, Allocator>& concurrent_vector<T, Allocator>::operator=(
+    const concurrent_vector& copyVector) {
+    if (this == &copyVector) {
+        return *this;
+    }
+
+    clear();
+    if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+        if (allocator != copyVector.allocator) {
+            releaseSegments();
+        }
+        allocator = copyVector.allocator;
+    }
+    appendCopy(copyVector.begin(), copyVector.size());
+
+    return *this;
+}
+
+template <class T, class Allocator>
+concurrent_vector<T, Allocator>&
+concurrent_vector<T, Allocator>::operator=(concurrent_vector&& moveVector) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this == &moveVector) {
+        return *this;
+    }
+
+    clear();
+    if (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value ||
+        allocator == moveVector.allocator) {
+        releaseSegments();
+        if constexpr (std::allocator_traits<
+                          Allocator>::propagate_on_container_move_assignment::value) {
+            allocator = std::move(moveVector.allocator);
+        }
+        takeFrom(moveVector);
+    } else {
+        // Segments can't change allocators, so the elements are moved one by one.
+        appendCopy(std::make_move_iterator(moveVector.begin()), moveVector.size());
+        moveVector.clear();
+    }
+
+    return *this;
+}
+
+template <class T, class Allocator>
+typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::capacity()
+    const noexcept {
+    size_type segment = 0;
+
+    while (segment < segmentCount && segments_[segment].load(std::memory_order_acquire)) {
+        ++segment;
+    }
+
+    return segment == 0 ? 0 : segmentBegin(segment - 1) + segmentSize(segment - 1);
+}
+
+template <class T, class Allocator>
+void concurrent_vector<T, Allocator>::reserve(size_type count) {
+    if (count > max_size()) {
+        throw std::length_error("Count is more than max_size!");
+    }
+
+    for (size_type index = 0; index < count; index = segmentBegin(segmentOf(index) + 1)) {
+        segment(segmentOf(index));
+    }
+}
+
+template <class T, class Allocator>
+template <class... Args>
+typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::emplace_back(
+    Args&&... args) {
+    return append(1, [&](T* destination, size_type) {
+        std::allocator_traits<Allocator>::construct(allocator, destination,
+                                                    std::forward<Args>(args)...);
+    });
+}
+
+template <class T, class Allocator>
+typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::grow_by(
+    size_type count) {
+    return append(count, [&](T* destination, size_type n) {
+        detail::uninitializedFill(allocator, destination, n);
+    });
+}
+
+template <class T, class Allocator>
+typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::grow_by(
+    size_type count, const T& value) {
+    return append(count, [&](T* destination, size_type n) {
+        detail::uninitializedFill(allocator, destination, n, value);
+    });
+}
+
+template <class T, class Allocator>
+void concurrent_vector<T, Allocator>::clear() noexcept {
+    const size_type count = size();
+    const size_type broken = broken_.load(std::memory_order_relaxed);
+
+    for (size_type segment = 0; segment < broken && segmentBegin(segment) < count; ++segment) {
+        T* const data = segments_[segment].load(std::memory_order_relaxed);
+        const size_type used = std::min(count - segmentBegin(segment), segmentSize(segment));
+
+        detail::destroyRange(allocator, data, data + used);
+    }
+
+    sz_.store(0, std::memory_order_relaxed);
+    broken_.store(segmentCount, std::memory_order_relaxed);
+}
+
+template <class T, class Allocator>
+void concurrent_vector<T, Allocator>::swap(concurrent_vector& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    for (size_type segment = 0; segment < segmentCount; ++segment) {
+        T* const mine = segments_[segment].load(std::memory_order_relaxed);
+        segments_[segment].store(other.segments_[segment].load(std::memory_order_relaxed),
+                                 std::memory_order_relaxed);
+        other.segments_[segment].store(mine, std::memory_order_relaxed);
+    }
+
+    const size_type sz = sz_.load(std::memory_order_relaxed);
+    sz_.store(other.sz_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other.sz_.store(sz, std::memory_order_relaxed);
+
+    const size_type broken = broken_.load(std::memory_order_relaxed);
+    broken_.store(other.broken_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other.broken_.store(broken, std::memory_order_relaxed);
+
+    if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator, other.allocator);
+    }
+}
+
+template <class T, class Allocator>
+T* concurrent_vector<T, Allocator>::segment(size_type segment) {
+    T* data = segments_[segment].load(std::memory_order_acquire);
+
+    if (data != nullptr) {
+        return data;
+    }
+
+    T* const fresh = std::allocator_traits<Allocator>::allocate(allocator, segmentSize(segment));
+
+    if (segments_[segment].compare_exchange_strong(data, fresh, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+        return fresh;
+    }
+
+    // Another thread installed the segment first; data now holds its block.
+    std::allocator_traits<Allocator>::deallocate(allocator, fresh, segmentSize(segment));
+    return data;
+}
+
+template <class T, class Allocator>
+template <class Construct>
+typename concurrent_vector<T, Allocator>::iterator concurrent_vector<T, Allocator>::append(
+    size_type count, Construct construct) {
+    if (count > max_size()) {
+        throw std::length_error("Count is more than max_size!");
+    }
+
+    // The claim only has to be unique; segment pointers carry the synchronization.
+    const size_type first = sz_.fetch_add(count, std::memory_order_relaxed);
+    std::exception_ptr error;
+
+    for (size_type index = first; index < first + count;) {
+        const size_type current = segmentOf(index);
+        const size_type n = std::min(first + count, segmentBegin(current + 1)) - index;
+        T* data = nullptr;
+
+        try {
+            data = segment(current) + (index - segmentBegin(current));
+        } catch (...) {
+            size_type broken = broken_.load(std::memory_order_relaxed);
+            while (current < broken &&
+                   !broken_.compare_exchange_weak(broken, current, std::memory_order_relaxed)) {
+            }
+            throw;
+        }
+
+        // The indices are taken, so once construction fails every remaining one still gets a
+        // value-initialized element.
+        if (!error) {
+            try {
+                construct(data, n);
+            } catch (...) {
+                error = std::current_exception();
+                detail::uninitializedFill(allocator, data, n);
+            }
+        } else {
+            detail::uninitializedFill(allocator, data, n);
+        }
+
+        index += n;
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return iterator(this, first);
+}
+
+template <class T, class Allocator>
+void concurrent_vector<T, Allocator>::takeFrom(concurrent_vector& other) noexcept {
+    for (size_type segment = 0; segment < segmentCount; ++segment) {
+        segments_[segment].store(
+            other.segments_[segment].exchange(nullptr, std::memory_order_relaxed),
+            std::memory_order_relaxed);
+    }
+
+    sz_.store(other.sz_.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    broken_.store(other.broken_.exchange(segmentCount, std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+}
+
+template <class T, class Allocator>
+void concurrent_vector<T, Allocator>::releaseSegments() noexcept {
+    for (size_type segment = 0; segment < segmentCount; ++segment) {
+        if (T* const data = segments_[segment].exchange(nullptr, std::memory_order_relaxed)) {
+            std::allocator_traits<Allocator>::deallocate(allocator, data, segmentSize(segment));
+        }
+    }
+}
+
+template <class T, class Allocator>
+void swap(concurrent_vector<T, Allocator>& lhs,
+          concurrent_vector<T, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+}  // namespace coolstd
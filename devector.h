@@ -0,0 +1,793 @@
+#pragma once
+
+#include "vector.h"
+
+namespace coolstd {
+// A vector with free capacity at both ends of its buffer, so push_front and pop_front are O(1)
+// amortized like push_back and pop_back, and the elements stay contiguous: data() and
+// coolstd::vector's iterator types work as in vector. Inserting or erasing in the middle shifts
+// whichever side of the position holds fewer elements.
+//
+// When the end being pushed at is full and at least half of the buffer is free, the elements
+// slide back to the middle of the buffer instead of reallocating, which a queue (push_back,
+// pop_front) does about once per size() pushes without ever growing; otherwise the buffer grows
+// through GrowthPolicy, keeping the free capacity at the other end as it was, so a devector
+// used only at the back grows like a vector. Sliding memmoves bitwise relocatable types, moves
+// nothrow-movable ones in place and reallocates everything else, so it never loses elements
+// to an exception.
+template <class T, class Allocator = std::allocator<T>, class GrowthPolicy = growth::doubling>
+class devector {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = std::allocator_traits<Allocator>::pointer;
+    using const_pointer = std::allocator_traits<Allocator>::const_pointer;
+    using iterator = typename vector<T, Allocator, GrowthPolicy>::iterator;
+    using const_iterator = typename vector<T, Allocator, GrowthPolicy>::const_iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // construct/copy/destroy
+    devector() noexcept(noexcept(Allocator())) : devector(Allocator()) {
+    }
+    explicit devector(const Allocator& alloc) noexcept : allocator(alloc) {
+    }
+
+    explicit devector(size_type count, const Allocator& alloc = Allocator()) : devector(alloc) {
+        guarded([&] { resize(count); });
+    }
+    devector(size_type count, const T& value, const Allocator& alloc = Allocator())
+        : devector(alloc) {
+        guarded([&] { insert(end(), count, value); });
+    }
+
+    template <class InputIterator>
+    devector(InputIterator first, InputIterator last, const Allocator& alloc = Allocator(),
+             typename std::enable_if<std::is_base_of<
+                 std::input_iterator_tag,
+                 typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+                 nullptr)
+        : devector(alloc) {
+        guarded([&] { insert(end(), first, last); });
+    }
+    devector(const devector& copyVector)
+        : devector(std::allocator_traits<Allocator>::select_on_container_copy_construction(
+              copyVector.allocator)) {
+        guarded([&] { insert(end(), copyVector.begin(), copyVector.end()); });
+    }
+    devector(devector&& moveVector) noexcept : allocator(std::move(moveVector.allocator)) {
+        takeBuffer(moveVector);
+    }
+
+    devector(std::initializer_list<T> initializerList, const Allocator& alloc = Allocator())
+        : devector(initializerList.begin(), initializerList.end(), alloc) {
+    }
+
+    ~devector() {
+        clear();
+        releaseBuffer();
+    }
+
+    devector& operator=(const devector& copyVector);
+    devector& operator=(devector&& moveVector) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+    devector& operator=(std::initializer_list<T> initializerList) {
+        assign(initializerList.begin(), initializerList.end());
+
+        return *this;
+    }
+
+    template <class InputIterator>
+    void assign(
+        InputIterator first, InputIterator last,
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr) {
+        clear();
+        insert(end(), first, last);
+    }
+    void assign(size_type count, const T& value) {
+        T temp(value);
+
+        clear();
+        insert(end(), count, temp);
+    }
+    allocator_type get_allocator() const noexcept {
+        return allocator;
+    }
+
+    // iterators
+    iterator begin() noexcept {
+        return iterator(data_);
+    }
+    iterator end() noexcept {
+        return iterator(data_ + sz_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(data_);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(data_ + sz_);
+    }
+    const_iterator cbegin() const noexcept {
+        return const_iterator(data_);
+    }
+    const_iterator cend() const noexcept {
+        return const_iterator(data_ + sz_);
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(cend());
+    }
+    const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(cbegin());
+    }
+
+    // capacity
+    bool empty() const noexcept {
+        return (sz_ == 0);
+    }
+    size_type size() const noexcept {
+        return sz_;
+    }
+    // The whole buffer, free slots at both ends included.
+    size_type capacity() const noexcept {
+        return cap_;
+    }
+    // Elements push_front and push_back can add before the next slide or reallocation.
+    size_type front_free_capacity() const noexcept {
+        return size_type(data_ - buffer_);
+    }
+    size_type back_free_capacity() const noexcept {
+        return cap_ - front_free_capacity() - sz_;
+    }
+    size_type max_size() const noexcept {
+        return std::allocator_traits<Allocator>::max_size(allocator) / 2;
+    }
+    void resize(size_type count);
+    void resize(size_type count, const T& value);
+    // As in vector: count elements fit from the first one to the end of the buffer.
+    void reserve(size_type count);
+    // count elements fit from the start of the buffer to the last one.
+    void reserve_front(size_type count);
+    void shrink_to_fit();
+
+    // element access
+    reference operator[](size_type n) {
+        COOLSTD_CHECK(n < sz_, "devector index out of range");
+        return data_[n];
+    }
+    const_reference operator[](size_type n) const {
+        COOLSTD_CHECK(n < sz_, "devector index out of range");
+        return data_[n];
+    }
+    reference at(size_type pos) {
+        if (pos < sz_) {
+            return data_[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    const_reference at(size_type pos) const {
+        if (pos < sz_) {
+            return data_[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+
+    reference front() {
+        COOLSTD_CHECK(sz_ > 0, "front() on an empty devector");
+        return data_[0];
+    }
+    const_reference front() const {
+        COOLSTD_CHECK(sz_ > 0, "front() on an empty devector");
+        return data_[0];
+    }
+    reference back() {
+        COOLSTD_CHECK(sz_ > 0, "back() on an empty devector");
+        return data_[sz_ - 1];
+    }
+    const_reference back() const {
+        COOLSTD_CHECK(sz_ > 0, "back() on an empty devector");
+        return data_[sz_ - 1];
+    }
+
+    // data access
+    T* data() noexcept {
+        return data_;
+    }
+    const T* data() const noexcept {
+        return data_;
+    }
+
+    // modifiers
+    template <class... Args>
+    reference emplace_back(Args&&... args);
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+    void pop_back() {
+        COOLSTD_CHECK(sz_ > 0, "pop_back() on an empty devector");
+        --sz_;
+        std::allocator_traits<Allocator>::destroy(allocator, data_ + sz_);
+    }
+
+    template <class... Args>
+    reference emplace_front(Args&&... args);
+    void push_front(const T& value) {
+        emplace_front(value);
+    }
+    void push_front(T&& value) {
+        emplace_front(std::move(value));
+    }
+    void pop_front() {
+        COOLSTD_CHECK(sz_ > 0, "pop_front() on an empty devector");
+        std::allocator_traits<Allocator>::destroy(allocator, data_);
+        ++data_;
+        --sz_;
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator position, Args&&... args);
+    iterator insert(const_iterator position, const T& value) {
+        return emplace(position, value);
+    }
+    iterator insert(const_iterator position, T&& value) {
+        return emplace(position, std::move(value));
+    }
+    iterator insert(const_iterator position, size_type count, const T& value);
+    template <class InputIterator>
+    iterator insert(
+        const_iterator position, InputIterator first, InputIterator last,
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr);
+    iterator insert(const_iterator position, std::initializer_list<T> initializerList) {
+        return insert(position, initializerList.begin(), initializerList.end());
+    }
+
+    iterator erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+    iterator erase(const_iterator first, const_iterator last);
+
+    void swap(devector& swapVector) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+    void clear() noexcept {
+        detail::destroyRange(allocator, data_, data_ + sz_);
+        sz_ = 0;
+    }
+
+private:
+    T* buffer_ = nullptr;
+    size_type cap_ = 0;
+    // The first element, front_free_capacity() slots into the buffer.
+    T* data_ = nullptr;
+    size_type sz_ = 0;
+    [[no_unique_address]] Allocator allocator;
+
+    // helpers
+    // Returns the buffer to the allocator. Elements must already have been destroyed or
+    // relocated.
+    void releaseBuffer() noexcept;
+    // Takes other's buffer and leaves it empty; the allocators must be equal.
+    void takeBuffer(devector& other) noexcept;
+
+    size_type nextCapacity(size_type required) const;
+
+    // Whether sliding makes room for count more elements: when at least half of the buffer
+    // would still be free, so the slide, O(size()), is paid for by the pushes before the next.
+    bool canSlide(size_type count) const noexcept {
+        return cap_ - sz_ >= sz_ + count;
+    }
+    // Moves the elements within the buffer so that at least frontCount slots are free in front
+    // and backCount behind, with the rest of the free slots split evenly.
+    void slide(size_type frontCount, size_type backCount);
+
+    // Moves everything into a new buffer of newCap elements, as in vector::grow, leaving a gap of
+    // gapSize elements at gapIndex that fill constructs first. The sequence, gap included,
+    // starts newFront slots into the new buffer.
+    template <class Fill>
+    void grow(size_type newCap, size_type newFront, size_type gapIndex, size_type gapSize,
+              Fill fill);
+
+    // Opens a gap of gapSize elements at gapIndex by shifting the shorter side, sliding or
+    // growing first when that side is out of room, and lets fill construct them; sz_ counts
+    // them afterwards. fill must not read from *this.
+    template <class Fill>
+    void insertGap(size_type gapIndex, size_type gapSize, Fill fill);
+
+    template <class InputIterator, class Sentinel>
+    iterator insertUnsized(size_type positionAsIndex, InputIterator first, Sentinel last);
+
+    // Runs a constructor body, cleaning up on failure since the destructor won't run.
+    template <class Body>
+    void guarded(Body body) {
+        try {
+            body();
+        } catch (...) {
+            clear();
+            releaseBuffer();
+            throw;
+        }
+    }
+};
+
+template <class T, class Allocator, class GrowthPolicy>
+devector<T, Allocator, GrowthPolicy>& devector<T, Allocator, GrowthPolicy>::operator=(
+    const devector& copyVector) {
+    if (this == &copyVector) {
+        return *this;
+    }
+
+    clear();
+    if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+        if (allocator != copyVector.allocator) {
+            releaseBuffer();
+        }
+        allocator = copyVector.allocator;
+    }
+    insert(end(), copyVector.begin(), copyVector.end());
+
+    return *this;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+devector<T, Allocator, GrowthPolicy>& devector<T, Allocator, GrowthPolicy>::operator=(
+    devector&& moveVector) noexcept(std::allocator_traits<
+                                        Allocator>::propagate_on_container_move_assignment::value ||
+                                    std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this == &moveVector) {
+        return *this;
+    }
+
+    clear();
+    if (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value ||
+        allocator == moveVector.allocator) {
+        releaseBuffer();
+        if constexpr (std::allocator_traits<
+                          Allocator>::propagate_on_container_move_assignment::value) {
+            allocator = std::move(moveVector.allocator);
+        }
+        takeBuffer(moveVector);
+    } else {
+        // The buffer can't change allocators, so the elements are moved one by one.
+        insert(end(), std::make_move_iterator(moveVector.begin()),
+               std::make_move_iterator(moveVector.end()));
+        moveVector.clear();
+    }
+
+    return *this;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void devector<T, Allocator, GrowthPolicy>::resize(size_type count) {
+    if (count < sz_) {
+        erase(begin() + count, end());
+    } else if (count > sz_) {
+        const size_type added = count - sz_;
+
+        insertGap(sz_, added,
+                  [&](pointer gap) { detail::uninitializedFill(allocator, gap, added); });
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void devector<T, Allocator, GrowthPolicy>::resize(size_type count, const T& value) {
+    if (count < sz_) {
+        erase(begin() + count, end());
+    } else if (count > sz_) {
+        insert(end(), count - sz_, value);
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void devector<T, Allocator, GrowthPolicy>::reserve(size_type count) {
+    if (count > sz_ + back_free_capacity()) {
+        if (count > max_size()) {
+            throw(std::length_error("Required capacity exceeds max_size()!"));
+        }
+        grow(front_free_capacity() + count, front_free_capacity(), sz_, 0, [](pointer) {});
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void devector<T, Allocator, GrowthPolicy>::reserve_front(size_type count) {
+    if (count > sz_ + front_free_capacity()) {
+        if (count > max_size()) {
+            throw(std::length_error("Required capacity exceeds max_size()!"));
+        }
+        grow(count + back_free_capacity(), count - sz_, sz_, 0, [](pointer) {});
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void devector<T, Allocator, GrowthPolicy>::shrink_to_fit() {
+    if (sz_ == 0) {
+        releaseBuffer();
+    } else if (sz_ < cap_) {
+        grow(sz_, 0, sz_, 0, [](pointer) {});
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class... Args>
+devector<T, Allocator, GrowthPolicy>::reference devector<T, Allocator, GrowthPolicy>::emplace_back(
+    Args&&... args) {
+    if (back_free_capacity() > 0) {
+        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_,
+                                                    std::forward<Args>(args)...);
+    } else if (canSlide(1)) {
+        // args may refer to an element, which the slide moves.
+        T temp(std::forward<Args>(args)...);
+
+        slide(0, 1);
+        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_, std::move(temp));
+    } else {
+        const size_type newCap = nextCapacity(sz_ + 1);
+
+        grow(newCap, std::min(front_free_capacity(), newCap - sz_ - 1), sz_, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap,
+                                                        std::forward<Args>(args)...);
+        });
+    }
+
+    ++sz_;
+    return data_[sz_ - 1];
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class... Args>
+devector<T, Allocator, GrowthPolicy>::reference devector<T, Allocator, GrowthPolicy>::emplace_front(
+    Args&&... args) {
+    if (front_free_capacity() > 0) {
+        std::allocator_traits<Allocator>::construct(allocator, data_ - 1,
+                                                    std::forward<Args>(args)...);
+        --data_;
+    } else if (canSlide(1)) {
+        T temp(std::forward<Args>(args)...);
+
+        slide(1, 0);
+        std::allocator_traits<Allocator>::construct(allocator, data_ - 1, std::move(temp));
+        --data_;
+    } else {
+        const size_type newCap = nextCapacity(sz_ + 1);
+        const size_type newBack = std::min(back_free_capacity(), newCap - sz_ - 1);
+
+        grow(newCap, newCap - sz_ - 1 - newBack, 0, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap,
+                                                        std::forward<Args>(args)...);
+        });
+    }
+
+    ++sz_;
+    return data_[0];
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class... Args>
+devector<T, Allocator, GrowthPolicy>::iterator devector<T, Allocator, GrowthPolicy>::emplace(
+    const_iterator position, Args&&... args) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+
+    T temp(std::forward<Args>(args)...);
+
+    insertGap(positionAsIndex, 1, [&](pointer gap) {
+        std::allocator_traits<Allocator>::construct(allocator, gap, std::move(temp));
+    });
+
+    return iterator(data_ + positionAsIndex);
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+devector<T, Allocator, GrowthPolicy>::iterator devector<T, Allocator, GrowthPolicy>::insert(
+    const_iterator position, size_type count, const T& value) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+
+    if (count > 0) {
+        T temp(value);
+
+        insertGap(positionAsIndex, count,
+                  [&](pointer gap) { detail::uninitializedFill(allocator, gap, count, temp); });
+    }
+
+    return iterator(data_ + positionAsIndex);
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class InputIterator>
+devector<T, Allocator, GrowthPolicy>::iterator devector<T, Allocator, GrowthPolicy>::insert(
+    const_iterator position, InputIterator first, InputIterator last,
+    typename std::enable_if<std::is_base_of<
+        std::input_iterator_tag,
+        typename std::iterator_traits<InputIterator>::iterator_category>::value>::type*) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+
+    if constexpr (std::is_base_of_v<
+                      std::forward_iterator_tag,
+                      typename std::iterator_traits<InputIterator>::iterator_category>) {
+        const size_type count = size_type(std::distance(first, last));
+
+        if (count > 0) {
+            insertGap(positionAsIndex, count, [&](pointer gap) {
+                detail::uninitializedCopyN(allocator, first, count, gap);
+            });
+        }
+        return iterator(data_ + positionAsIndex);
+    } else {
+        return insertUnsized(positionAsIndex, first, last);
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+devector<T, Allocator, GrowthPolicy>::iterator devector<T, Allocator, GrowthPolicy>::erase(
+    const_iterator first, const_iterator last) {
+    const size_type positionAsIndex = size_type(first - cbegin());
+    const size_type count = size_type(last - first);
+    COOLSTD_CHECK(positionAsIndex <= sz_ && count <= sz_ - positionAsIndex,
+                  "erase() range is not within [begin(), end()]");
+
+    if (count == 0) {
+        return iterator(data_ + positionAsIndex);
+    }
+    if (positionAsIndex < sz_ - positionAsIndex - count) {
+        // Fewer elements in front: they move up over the erased ones.
+        if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+            detail::destroyRange(allocator, data_ + positionAsIndex,
+                                 data_ + positionAsIndex + count);
+            detail::shiftRange(data_, data_ + positionAsIndex, data_ + count);
+        } else {
+            std::move_backward(data_, data_ + positionAsIndex, data_ + positionAsIndex + count);
+            detail::destroyRange(allocator, data_, data_ + count);
+        }
+        data_ += count;
+    } else if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        detail::destroyRange(allocator, data_ + positionAsIndex, data_ + positionAsIndex + count);
+        detail::shiftRange(data_ + positionAsIndex + count, data_ + sz_, data_ + positionAsIndex);
+    } else {
+        std::move(data_ + positionAsIndex + count, data_ + sz_, data_ + positionAsIndex);
+        detail::destroyRange(allocator, data_ + sz_ - count, data_ + sz_);
+    }
+    sz_ -= count;
+
+    return iterator(data_ + positionAsIndex);
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void devector<T, Allocator, GrowthPolicy>::swap(devector& swapVector) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    std::swap(buffer_, swapVector.buffer_);
+    std::swap(cap_, swapVector.cap_);
+    std::swap(data_, swapVector.data_);
+    std::swap(sz_, swapVector.sz_);
+
+    if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator, swapVector.allocator);
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void devector<T, Allocator, GrowthPolicy>::releaseBuffer() noexcept {
+    if (buffer_ != nullptr) {
+        if constexpr (!detail::is_monotonic<Allocator>::value) {
+            std::allocator_traits<Allocator>::deallocate(allocator, buffer_, cap_);
+        }
+        buffer_ = nullptr;
+        data_ = nullptr;
+        cap_ = 0;
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void devector<T, Allocator, GrowthPolicy>::takeBuffer(devector& other) noexcept {
+    buffer_ = std::exchange(other.buffer_, nullptr);
+    cap_ = std::exchange(other.cap_, 0);
+    data_ = std::exchange(other.data_, nullptr);
+    sz_ = std::exchange(other.sz_, 0);
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+devector<T, Allocator, GrowthPolicy>::size_type devector<T, Allocator, GrowthPolicy>::nextCapacity(
+    size_type required) const {
+    if (required > max_size()) {
+        throw(std::length_error("Required capacity exceeds max_size()!"));
+    }
+
+    const size_type next = GrowthPolicy::next_capacity(cap_, required, sizeof(T));
+
+    return std::min(std::max(next, required), max_size());
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void devector<T, Allocator, GrowthPolicy>::slide(size_type frontCount, size_type backCount) {
+    T* const destination = buffer_ + frontCount + (cap_ - sz_ - frontCount - backCount) / 2;
+
+    if (destination == data_) {
+        return;
+    }
+
+    if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        detail::shiftRange(data_, data_ + sz_, destination);
+    } else if constexpr (std::is_nothrow_move_constructible_v<T> &&
+                         std::is_nothrow_move_assignable_v<T>) {
+        // Slots the elements move onto are constructed if they were free and assigned if not;
+        // the ones they leave behind are destroyed.
+        if (destination < data_) {
+            for (size_type i = 0; i < sz_; ++i) {
+                if (destination + i < data_) {
+                    std::allocator_traits<Allocator>::construct(allocator, destination + i,
+                                                                std::move(data_[i]));
+                } else {
+                    destination[i] = std::move(data_[i]);
+                }
+            }
+            detail::destroyRange(allocator, std::max(destination + sz_, data_), data_ + sz_);
+        } else {
+            for (size_type i = sz_; i > 0; --i) {
+                if (destination + i > data_ + sz_) {
+                    std::allocator_traits<Allocator>::construct(allocator, destination + i - 1,
+                                                                std::move(data_[i - 1]));
+                } else {
+                    destination[i - 1] = std::move(data_[i - 1]);
+                }
+            }
+            detail::destroyRange(allocator, data_, std::min(destination, data_ + sz_));
+        }
+    } else {
+        grow(cap_, size_type(destination - buffer_), sz_, 0, [](pointer) {});
+        return;
+    }
+
+    data_ = destination;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class Fill>
+void devector<T, Allocator, GrowthPolicy>::grow(size_type newCap, size_type newFront,
+                                                size_type gapIndex, size_type gapSize, Fill fill) {
+    auto [newData, allocated] = detail::allocateAtLeast(allocator, newCap);
+    T* const newBegin = newData + newFront;
+
+    try {
+        fill(newBegin + gapIndex);
+    } catch (...) {
+        std::allocator_traits<Allocator>::deallocate(allocator, newData, allocated);
+        throw;
+    }
+
+    try {
+        detail::relocate(allocator, data_, data_ + sz_, newBegin, gapIndex, gapSize);
+    } catch (...) {
+        detail::destroyRange(allocator, newBegin + gapIndex, newBegin + gapIndex + gapSize);
+        std::allocator_traits<Allocator>::deallocate(allocator, newData, allocated);
+        throw;
+    }
+
+    releaseBuffer();
+
+    buffer_ = newData;
+    cap_ = allocated;
+    data_ = newBegin;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class Fill>
+void devector<T, Allocator, GrowthPolicy>::insertGap(size_type gapIndex, size_type gapSize,
+                                                     Fill fill) {
+    const bool atFront = gapIndex < sz_ - gapIndex;
+
+    if ((atFront ? front_free_capacity() : back_free_capacity()) < gapSize) {
+        if (canSlide(gapSize)) {
+            slide(atFront ? gapSize : 0, atFront ? 0 : gapSize);
+        } else {
+            // The free capacity at the end that isn't growing stays as it was.
+            const size_type newCap = nextCapacity(sz_ + gapSize);
+            const size_type spare = newCap - sz_ - gapSize;
+            const size_type newFront = atFront
+                                           ? spare - std::min(back_free_capacity(), spare)
+                                           : std::min(front_free_capacity(), spare);
+
+            grow(newCap, newFront, gapIndex, gapSize, fill);
+            sz_ += gapSize;
+            return;
+        }
+    }
+
+    if (atFront) {
+        T* const newBegin = data_ - gapSize;
+
+        if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+            detail::shiftRange(data_, data_ + gapIndex, newBegin);
+
+            try {
+                fill(newBegin + gapIndex);
+            } catch (...) {
+                detail::shiftRange(newBegin, newBegin + gapIndex, data_);
+                throw;
+            }
+        } else {
+            fill(newBegin);
+            std::rotate(newBegin, data_, data_ + gapIndex);
+        }
+        data_ = newBegin;
+    } else if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        detail::shiftRange(data_ + gapIndex, data_ + sz_, data_ + gapIndex + gapSize);
+
+        try {
+            fill(data_ + gapIndex);
+        } catch (...) {
+            detail::shiftRange(data_ + gapIndex + gapSize, data_ + sz_ + gapSize,
+                               data_ + gapIndex);
+            throw;
+        }
+    } else {
+        fill(data_ + sz_);
+        std::rotate(data_ + gapIndex, data_ + sz_, data_ + sz_ + gapSize);
+    }
+
+    sz_ += gapSize;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class InputIterator, class Sentinel>
+devector<T, Allocator, GrowthPolicy>::iterator devector<T, Allocator, GrowthPolicy>::insertUnsized(
+    size_type positionAsIndex, InputIterator first, Sentinel last) {
+    const size_type oldSize = sz_;
+
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+    std::rotate(data_ + positionAsIndex, data_ + oldSize, data_ + sz_);
+
+    return iterator(data_ + positionAsIndex);
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void swap(devector<T, Allocator, GrowthPolicy>& lhs,
+          devector<T, Allocator, GrowthPolicy>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+bool operator==(const devector<T, Allocator, GrowthPolicy>& lhs,
+                const devector<T, Allocator, GrowthPolicy>& rhs) {
+    return lhs.size() == rhs.size() && detail::equalRanges(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+auto operator<=>(const devector<T, Allocator, GrowthPolicy>& lhs,
+                 const devector<T, Allocator, GrowthPolicy>& rhs) {
+    return detail::compareRanges(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+}  // namespace coolstd
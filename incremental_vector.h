@@ -0,0 +1,579 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+
+namespace coolstd {
+// A vector whose push_back never copies the whole buffer at once. When it is full, growth
+// allocates the bigger buffer but leaves the elements where they are; each later push_back or
+// emplace_back then relocates a few of them, oldest first, the way an incrementally rehashing
+// hash table moves its buckets. The step is chosen when the migration starts so that it ends
+// before the new buffer fills, so the worst push costs one allocation and a bounded number of
+// relocations instead of a copy of size() elements; the total work is the same as vector's.
+// The bound is a constant only for a geometric GrowthPolicy: growing by a factor f makes the
+// step about 1 / (f - 1) elements, while growth::fixed_increment<K> makes it size() / K.
+//
+// While a migration is running, elements [migrated, old size) are still in the old buffer and
+// the rest in the new one, and operator[] and the iterators pick the buffer per element: one
+// extra, well-predicted comparison, also when nothing is migrating. Elements are contiguous only
+// between migrations, so data() finishes the current one first. Elements move when they are
+// migrated, which invalidates references and pointers to them, as vector's growth does; indices
+// and iterators stay valid until the next growth.
+template <class T, class Allocator = std::allocator<T>, class GrowthPolicy = growth::doubling>
+class incremental_vector {
+    template <bool Const>
+    class Iterator;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // construct/copy/destroy
+    incremental_vector() noexcept(noexcept(Allocator())) : incremental_vector(Allocator()) {
+    }
+    explicit incremental_vector(const Allocator& alloc) noexcept : allocator(alloc) {
+    }
+    incremental_vector(size_type count, const T& value, const Allocator& alloc = Allocator())
+        : incremental_vector(alloc) {
+        guarded([&] {
+            reserve(count);
+            while (sz_ < count) {
+                emplace_back(value);
+            }
+        });
+    }
+    incremental_vector(std::initializer_list<T> initializerList,
+                       const Allocator& alloc = Allocator())
+        : incremental_vector(alloc) {
+        guarded([&] {
+            append(initializerList.begin(), initializerList.end(), initializerList.size());
+        });
+    }
+    incremental_vector(const incremental_vector& copyVector)
+        : incremental_vector(
+              std::allocator_traits<Allocator>::select_on_container_copy_construction(
+                  copyVector.allocator)) {
+        guarded([&] { append(copyVector.begin(), copyVector.end(), copyVector.size()); });
+    }
+    incremental_vector(incremental_vector&& moveVector) noexcept
+        : allocator(std::move(moveVector.allocator)) {
+        takeBuffers(moveVector);
+    }
+
+    ~incremental_vector() {
+        clear();
+        std::allocator_traits<Allocator>::deallocate(allocator, data_, cap_);
+    }
+
+    incremental_vector& operator=(const incremental_vector& copyVector);
+    incremental_vector& operator=(incremental_vector&& moveVector) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+    allocator_type get_allocator() const noexcept {
+        return allocator;
+    }
+
+    // iterators
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, sz_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, sz_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    // capacity
+    bool empty() const noexcept {
+        return sz_ == 0;
+    }
+    size_type size() const noexcept {
+        return sz_;
+    }
+    // The new buffer's capacity; while migrating, the old one is still allocated as well.
+    size_type capacity() const noexcept {
+        return cap_;
+    }
+    size_type max_size() const noexcept {
+        return std::allocator_traits<Allocator>::max_size(allocator) / 2;
+    }
+    // Finishes any migration and reallocates at once, like vector::reserve.
+    void reserve(size_type count);
+
+    // Whether elements are still waiting in the old buffer.
+    bool migrating() const noexcept {
+        return old_ != nullptr;
+    }
+    // Relocates every element still in the old buffer and frees it.
+    void finish_migration() {
+        migrate(oldSize_ - migrated_);
+    }
+
+    // element access
+    reference operator[](size_type n) {
+        return *locate(n);
+    }
+    const_reference operator[](size_type n) const {
+        return *locate(n);
+    }
+    reference at(size_type pos) {
+        if (pos < sz_) {
+            return (*this)[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    const_reference at(size_type pos) const {
+        if (pos < sz_) {
+            return (*this)[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    reference front() {
+        return (*this)[0];
+    }
+    const_reference front() const {
+        return (*this)[0];
+    }
+    reference back() {
+        return (*this)[sz_ - 1];
+    }
+    const_reference back() const {
+        return (*this)[sz_ - 1];
+    }
+
+    // The elements as one array, which first finishes any migration: O(size()) right after a
+    // growth, O(1) otherwise.
+    T* data() {
+        finish_migration();
+        return data_;
+    }
+
+    // modifiers
+    template <class... Args>
+    reference emplace_back(Args&&... args);
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+    void pop_back() noexcept;
+
+    // Destroys every element and frees the old buffer; the new one is kept for reuse.
+    void clear() noexcept;
+    void swap(incremental_vector& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+private:
+    // The new buffer, holding [0, migrated_) and [oldSize_, sz_).
+    T* data_ = nullptr;
+    size_type cap_ = 0;
+    size_type sz_ = 0;
+    // The old buffer while migrating, holding [migrated_, oldSize_); otherwise null, and
+    // migrated_ and oldSize_ are zero.
+    T* old_ = nullptr;
+    size_type oldCap_ = 0;
+    size_type migrated_ = 0;
+    size_type oldSize_ = 0;
+    // Elements relocated per push during the current migration: size() divided by the room the
+    // growth added, so constant for geometric policies only.
+    size_type step_ = 0;
+    [[no_unique_address]] Allocator allocator;
+
+    // Unsigned wrap-around turns "migrated_ <= n < oldSize_" into one comparison, which is
+    // always false when nothing migrates.
+    T* locate(size_type n) const noexcept {
+        return n - migrated_ < oldSize_ - migrated_ ? old_ + n : data_ + n;
+    }
+
+    // Makes room for one more element: allocates the next buffer and starts migrating into it.
+    void grow();
+    // Relocates up to count more elements from the old buffer, and frees it once it is empty.
+    // If a relocation throws, the elements relocated before it stay relocated.
+    void migrate(size_type count);
+    void releaseOld() noexcept;
+
+    template <class InputIterator>
+    void append(InputIterator first, InputIterator last, size_type count);
+
+    // Takes other's buffers and leaves it empty; the allocators must be equal.
+    void takeBuffers(incremental_vector& other) noexcept;
+
+    // Runs a constructor body, cleaning up on failure since the destructor won't run.
+    template <class Body>
+    void guarded(Body body) {
+        try {
+            body();
+        } catch (...) {
+            clear();
+            std::allocator_traits<Allocator>::deallocate(allocator, data_, cap_);
+            throw;
+        }
+    }
+};
+
+template <class T, class Allocator, class GrowthPolicy>
+template <bool Const>
+class incremental_vector<T, Allocator, GrowthPolicy>::Iterator {
+    using Owner = std::conditional_t<Const, const incremental_vector, incremental_vector>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    Iterator() = default;
+    Iterator(Owner* owner, size_type index) : owner_(owner), index_(index) {
+    }
+    // iterator converts to const_iterator.
+    template <bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    Iterator(const Iterator<OtherConst>& other) : owner_(other.owner_), index_(other.index_) {
+    }
+
+    reference operator*() const {
+        return (*owner_)[index_];
+    }
+    pointer operator->() const {
+        return &**this;
+    }
+    reference operator[](difference_type n) const {
+        return *(*this + n);
+    }
+
+    Iterator& operator++() {
+        ++index_;
+        return *this;
+    }
+    Iterator operator++(int) {
+        Iterator old = *this;
+        ++index_;
+        return old;
+    }
+    Iterator& operator--() {
+        --index_;
+        return *this;
+    }
+    Iterator operator--(int) {
+        Iterator old = *this;
+        --index_;
+        return old;
+    }
+    Iterator& operator+=(difference_type n) {
+        index_ = size_type(difference_type(index_) + n);
+        return *this;
+    }
+    Iterator& operator-=(difference_type n) {
+        index_ = size_type(difference_type(index_) - n);
+        return *this;
+    }
+    Iterator operator+(difference_type n) const {
+        return Iterator(owner_, size_type(difference_type(index_) + n));
+    }
+    friend Iterator operator+(difference_type n, const Iterator& it) {
+        return it + n;
+    }
+    Iterator operator-(difference_type n) const {
+        return Iterator(owner_, size_type(difference_type(index_) - n));
+    }
+    difference_type operator-(const Iterator& it) const {
+        return difference_type(index_) - difference_type(it.index_);
+    }
+
+    bool operator==(const Iterator& rhs) const {
+        return index_ == rhs.index_;
+    }
+    auto operator<=>(const Iterator& rhs) const {
+        return index_ <=> rhs.index_;
+    }
+
+private:
+    template <bool>
+    friend class Iterator;
+
+    // The container, not a buffer: an element's buffer changes as it is migrated.
+    Owner* owner_ = nullptr;
+    size_type index_ = 0;
+};
+
+template <class T, class Allocator, class GrowthPolicy>
+incremental_vector<T, Allocator, GrowthPolicy>&
+incremental_vector<T, Allocator, GrowthPolicy>::operator=(const incremental_vector& copyVector) {
+    if (this == &copyVector) {
+        return *this;
+    }
+
+    clear();
+    if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+        if (allocator != copyVector.allocator) {
+            std::allocator_traits<Allocator>::deallocate(allocator, data_, cap_);
+            data_ = nullptr;
+            cap_ = 0;
+        }
+        allocator = copyVector.allocator;
+    }
+    append(copyVector.begin(), copyVector.end(), copyVector.size());
+
+    return *this;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+incremental_vector<T, Allocator, GrowthPolicy>&
+incremental_vector<T, Allocator, GrowthPolicy>::operator=(incremental_vector&& moveVector) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this == &moveVector) {
+        return *this;
+    }
+
+    clear();
+    if (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value ||
+        allocator == moveVector.allocator) {
+        std::allocator_traits<Allocator>::deallocate(allocator, data_, cap_);
+        if constexpr (std::allocator_traits<
+                          Allocator>::propagate_on_container_move_assignment::value) {
+            allocator = std::move(moveVector.allocator);
+        }
+        takeBuffers(moveVector);
+    } else {
+        // The buffers can't change allocators, so the elements are moved one by one.
+        append(std::make_move_iterator(moveVector.begin()),
+               std::make_move_iterator(moveVector.end()), moveVector.size());
+        moveVector.clear();
+    }
+
+    return *this;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void incremental_vector<T, Allocator, GrowthPolicy>::reserve(size_type count) {
+    if (count <= cap_) {
+        return;
+    }
+    if (count > max_size()) {
+        throw std::length_error("Count is more than max_size!");
+    }
+
+    finish_migration();
+
+    T* const newData = std::allocator_traits<Allocator>::allocate(allocator, count);
+
+    try {
+        detail::relocate(allocator, data_, data_ + sz_, newData);
+    } catch (...) {
+        std::allocator_traits<Allocator>::deallocate(allocator, newData, count);
+        throw;
+    }
+
+    std::allocator_traits<Allocator>::deallocate(allocator, data_, cap_);
+    data_ = newData;
+    cap_ = count;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class... Args>
+typename incremental_vector<T, Allocator, GrowthPolicy>::reference
+incremental_vector<T, Allocator, GrowthPolicy>::emplace_back(Args&&... args) {
+    if (sz_ == cap_) {
+        grow();
+    }
+
+    // Constructed before anything migrates, so args may still refer to an element.
+    T* const slot = data_ + sz_;
+    std::allocator_traits<Allocator>::construct(allocator, slot, std::forward<Args>(args)...);
+
+    if (migrating()) {
+        try {
+            migrate(step_);
+        } catch (...) {
+            std::allocator_traits<Allocator>::destroy(allocator, slot);
+            throw;
+        }
+    }
+    ++sz_;
+
+    return *slot;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void incremental_vector<T, Allocator, GrowthPolicy>::pop_back() noexcept {
+    --sz_;
+
+    if (sz_ >= oldSize_) {
+        std::allocator_traits<Allocator>::destroy(allocator, data_ + sz_);
+    } else {
+        // Everything pushed since the growth is gone: the last element is an old one.
+        std::allocator_traits<Allocator>::destroy(allocator, old_ + sz_);
+        oldSize_ = sz_;
+        if (migrated_ == oldSize_) {
+            releaseOld();
+        }
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void incremental_vector<T, Allocator, GrowthPolicy>::clear() noexcept {
+    detail::destroyRange(allocator, data_, data_ + migrated_);
+    detail::destroyRange(allocator, old_ + migrated_, old_ + oldSize_);
+    detail::destroyRange(allocator, data_ + oldSize_, data_ + sz_);
+    releaseOld();
+    sz_ = 0;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void incremental_vector<T, Allocator, GrowthPolicy>::swap(incremental_vector& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    std::swap(data_, other.data_);
+    std::swap(cap_, other.cap_);
+    std::swap(sz_, other.sz_);
+    std::swap(old_, other.old_);
+    std::swap(oldCap_, other.oldCap_);
+    std::swap(migrated_, other.migrated_);
+    std::swap(oldSize_, other.oldSize_);
+    std::swap(step_, other.step_);
+
+    if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator, other.allocator);
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void incremental_vector<T, Allocator, GrowthPolicy>::grow() {
+    // The step below finishes every migration before the buffer fills again, so this only
+    // runs if a relocation threw on the way.
+    finish_migration();
+
+    if (sz_ == max_size()) {
+        throw std::length_error("Count is more than max_size!");
+    }
+    const size_type newCap =
+        std::min(GrowthPolicy::next_capacity(cap_, sz_ + 1, sizeof(T)), max_size());
+    T* const newData = std::allocator_traits<Allocator>::allocate(allocator, newCap);
+
+    if (sz_ == 0) {
+        std::allocator_traits<Allocator>::deallocate(allocator, data_, cap_);
+    } else {
+        old_ = data_;
+        oldCap_ = cap_;
+        oldSize_ = sz_;
+        migrated_ = 0;
+        // newCap - sz_ pushes fill the new buffer; together they have to move sz_ elements.
+        step_ = (sz_ + (newCap - sz_) - 1) / (newCap - sz_);
+    }
+    data_ = newData;
+    cap_ = newCap;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void incremental_vector<T, Allocator, GrowthPolicy>::migrate(size_type count) {
+    count = std::min(count, oldSize_ - migrated_);
+
+    if (count > 0) {
+        detail::relocate(allocator, old_ + migrated_, old_ + migrated_ + count,
+                         data_ + migrated_);
+        migrated_ += count;
+    }
+    if (migrated_ == oldSize_) {
+        releaseOld();
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void incremental_vector<T, Allocator, GrowthPolicy>::releaseOld() noexcept {
+    if (old_ != nullptr) {
+        std::allocator_traits<Allocator>::deallocate(allocator, old_, oldCap_);
+    }
+    old_ = nullptr;
+    oldCap_ = 0;
+    migrated_ = 0;
+    oldSize_ = 0;
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+template <class InputIterator>
+void incremental_vector<T, Allocator, GrowthPolicy>::append(InputIterator first,
+                                                            InputIterator last, size_type count) {
+    reserve(sz_ + count);
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void incremental_vector<T, Allocator, GrowthPolicy>::takeBuffers(
+    incremental_vector& other) noexcept {
+    data_ = std::exchange(other.data_, nullptr);
+    cap_ = std::exchange(other.cap_, 0);
+    sz_ = std::exchange(other.sz_, 0);
+    old_ = std::exchange(other.old_, nullptr);
+    oldCap_ = std::exchange(other.oldCap_, 0);
+    migrated_ = std::exchange(other.migrated_, 0);
+    oldSize_ = std::exchange(other.oldSize_, 0);
+    step_ = std::exchange(other.step_, 0);
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+bool operator==(const incremental_vector<T, Allocator, GrowthPolicy>& lhs,
+                const incremental_vector<T, Allocator, GrowthPolicy>& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+auto operator<=>(const incremental_vector<T, Allocator, GrowthPolicy>& lhs,
+                 const incremental_vector<T, Allocator, GrowthPolicy>& rhs) {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                                                  detail::synthThreeWay{});
+}
+
+template <class T, class Allocator, class GrowthPolicy>
+void swap(incremental_vector<T, Allocator, GrowthPolicy>& lhs,
+          incremental_vector<T, Allocator, GrowthPolicy>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+}  // namespace coolstd
@@ -0,0 +1,594 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+namespace coolstd {
+// A vector of at most N elements stored inside the object itself: no allocator, no heap, and
+// every member is constexpr. It has coolstd::vector's iterator types and the same modifiers with
+// the same semantics, except that growing past N throws std::bad_alloc, which stands for the
+// allocation a vector would make. try_push_back and try_emplace_back return nullptr instead of
+// throwing; unchecked_push_back and unchecked_emplace_back leave a full inplace_vector to
+// COOLSTD_CHECK. The copy, move and destruction of an inplace_vector of trivially copyable or
+// trivially destructible elements are the defaulted ones, so it is trivially copyable exactly
+// when T is, and a copy is then a memcpy of the whole buffer. As in small_vector, iterators are
+// made from bare pointers and are not checked.
+template <class T, std::size_t N>
+class inplace_vector {
+    static_assert(N > 0, "an inplace_vector needs room for at least one element");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = typename vector<T>::iterator;
+    using const_iterator = typename vector<T>::const_iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // construct/copy/destroy
+    constexpr inplace_vector() noexcept {
+    }
+    constexpr explicit inplace_vector(size_type count) {
+        resize(count);
+    }
+    constexpr inplace_vector(size_type count, const T& value) {
+        resize(count, value);
+    }
+    template <class InputIterator>
+    constexpr inplace_vector(
+        InputIterator first, InputIterator last,
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr) {
+        append(first, last);
+    }
+    constexpr inplace_vector(std::initializer_list<T> initializerList) {
+        append(initializerList.begin(), initializerList.end());
+    }
+
+    constexpr inplace_vector(const inplace_vector&)
+        requires std::is_trivially_copy_constructible_v<T>
+    = default;
+    constexpr inplace_vector(const inplace_vector& copyVector) noexcept(
+        std::is_nothrow_copy_constructible_v<T>) {
+        append(copyVector.begin(), copyVector.end());
+    }
+    constexpr inplace_vector(inplace_vector&&)
+        requires std::is_trivially_move_constructible_v<T>
+    = default;
+    constexpr inplace_vector(inplace_vector&& moveVector) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        append(std::make_move_iterator(moveVector.begin()),
+               std::make_move_iterator(moveVector.end()));
+    }
+
+    constexpr ~inplace_vector()
+        requires std::is_trivially_destructible_v<T>
+    = default;
+    constexpr ~inplace_vector() {
+        clear();
+    }
+
+    constexpr inplace_vector& operator=(const inplace_vector&)
+        requires std::is_trivially_copy_assignable_v<T> &&
+                 std::is_trivially_copy_constructible_v<T> && std::is_trivially_destructible_v<T>
+    = default;
+    constexpr inplace_vector& operator=(const inplace_vector& copyVector) {
+        if (this != &copyVector) {
+            assignCommon(copyVector.begin(), copyVector.size());
+        }
+
+        return *this;
+    }
+    constexpr inplace_vector& operator=(inplace_vector&&)
+        requires std::is_trivially_move_assignable_v<T> &&
+                 std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T>
+    = default;
+    constexpr inplace_vector& operator=(inplace_vector&& moveVector) noexcept(
+        std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+        if (this != &moveVector) {
+            assignCommon(std::make_move_iterator(moveVector.begin()), moveVector.size());
+        }
+
+        return *this;
+    }
+    constexpr inplace_vector& operator=(std::initializer_list<T> initializerList) {
+        assign(initializerList.begin(), initializerList.end());
+
+        return *this;
+    }
+
+    template <class InputIterator>
+    constexpr void assign(
+        InputIterator first, InputIterator last,
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr) {
+        clear();
+        append(first, last);
+    }
+    constexpr void assign(size_type count, const T& value) {
+        checkCapacity(count);
+
+        T temp(value);
+
+        clear();
+        resize(count, temp);
+    }
+    constexpr void assign(std::initializer_list<T> initializerList) {
+        assign(initializerList.begin(), initializerList.end());
+    }
+
+    // iterators
+    constexpr iterator begin() noexcept {
+        return iterator(data());
+    }
+    constexpr iterator end() noexcept {
+        return iterator(data() + sz_);
+    }
+    constexpr const_iterator begin() const noexcept {
+        return const_iterator(data());
+    }
+    constexpr const_iterator end() const noexcept {
+        return const_iterator(data() + sz_);
+    }
+    constexpr const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    constexpr const_iterator cend() const noexcept {
+        return end();
+    }
+    constexpr reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    constexpr const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    constexpr reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    constexpr const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+    constexpr const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    constexpr const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    // capacity
+    constexpr bool empty() const noexcept {
+        return sz_ == 0;
+    }
+    constexpr size_type size() const noexcept {
+        return sz_;
+    }
+    static constexpr size_type max_size() noexcept {
+        return N;
+    }
+    static constexpr size_type capacity() noexcept {
+        return N;
+    }
+    constexpr void resize(size_type count);
+    constexpr void resize(size_type count, const T& value);
+    // Throws std::bad_alloc if count > N; there is nothing else to do.
+    static constexpr void reserve(size_type count) {
+        checkCapacity(count);
+    }
+    static constexpr void shrink_to_fit() noexcept {
+    }
+
+    // element access
+    constexpr reference operator[](size_type n) {
+        COOLSTD_CHECK(n < sz_, "inplace_vector index out of range");
+        return data()[n];
+    }
+    constexpr const_reference operator[](size_type n) const {
+        COOLSTD_CHECK(n < sz_, "inplace_vector index out of range");
+        return data()[n];
+    }
+    constexpr reference at(size_type pos) {
+        if (pos < sz_) {
+            return data()[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    constexpr const_reference at(size_type pos) const {
+        if (pos < sz_) {
+            return data()[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    constexpr reference front() {
+        COOLSTD_CHECK(sz_ > 0, "front() on an empty inplace_vector");
+        return data()[0];
+    }
+    constexpr const_reference front() const {
+        COOLSTD_CHECK(sz_ > 0, "front() on an empty inplace_vector");
+        return data()[0];
+    }
+    constexpr reference back() {
+        COOLSTD_CHECK(sz_ > 0, "back() on an empty inplace_vector");
+        return data()[sz_ - 1];
+    }
+    constexpr const_reference back() const {
+        COOLSTD_CHECK(sz_ > 0, "back() on an empty inplace_vector");
+        return data()[sz_ - 1];
+    }
+
+    // data access
+    constexpr T* data() noexcept {
+        return storage_.elements;
+    }
+    constexpr const T* data() const noexcept {
+        return storage_.elements;
+    }
+
+    // modifiers
+    template <class... Args>
+    constexpr reference emplace_back(Args&&... args) {
+        checkCapacity(sz_ + 1);
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+    constexpr void push_back(const T& value) {
+        emplace_back(value);
+    }
+    constexpr void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+    // As emplace_back, but a full inplace_vector is left unchanged and nullptr returned.
+    template <class... Args>
+    constexpr T* try_emplace_back(Args&&... args) {
+        if (sz_ == N) {
+            return nullptr;
+        }
+        return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+    }
+    constexpr T* try_push_back(const T& value) {
+        return try_emplace_back(value);
+    }
+    constexpr T* try_push_back(T&& value) {
+        return try_emplace_back(std::move(value));
+    }
+    // As emplace_back, but the inplace_vector must not be full.
+    template <class... Args>
+    constexpr reference unchecked_emplace_back(Args&&... args) {
+        COOLSTD_CHECK(sz_ < N, "unchecked_emplace_back() on a full inplace_vector");
+        T* const slot = std::construct_at(data() + sz_, std::forward<Args>(args)...);
+        ++sz_;
+
+        return *slot;
+    }
+    constexpr reference unchecked_push_back(const T& value) {
+        return unchecked_emplace_back(value);
+    }
+    constexpr reference unchecked_push_back(T&& value) {
+        return unchecked_emplace_back(std::move(value));
+    }
+    constexpr void pop_back() {
+        COOLSTD_CHECK(sz_ > 0, "pop_back() on an empty inplace_vector");
+        --sz_;
+        std::destroy_at(data() + sz_);
+    }
+
+    template <class... Args>
+    constexpr iterator emplace(const_iterator position, Args&&... args);
+    constexpr iterator insert(const_iterator position, const T& value) {
+        return emplace(position, value);
+    }
+    constexpr iterator insert(const_iterator position, T&& value) {
+        return emplace(position, std::move(value));
+    }
+    constexpr iterator insert(const_iterator position, size_type count, const T& value);
+    template <class InputIterator>
+    constexpr iterator insert(
+        const_iterator position, InputIterator first, InputIterator last,
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr) {
+        return insertAppended(position, [&] { append(first, last); });
+    }
+    constexpr iterator insert(const_iterator position, std::initializer_list<T> initializerList) {
+        return insert(position, initializerList.begin(), initializerList.end());
+    }
+    template <std::ranges::input_range Range>
+    constexpr iterator insert_range(const_iterator position, Range&& range) {
+        return insertAppended(position, [&] {
+            append(std::ranges::begin(range), std::ranges::end(range));
+        });
+    }
+    template <std::ranges::input_range Range>
+    constexpr void append_range(Range&& range) {
+        append(std::ranges::begin(range), std::ranges::end(range));
+    }
+
+    constexpr iterator erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+    constexpr iterator erase(const_iterator first, const_iterator last);
+
+    constexpr void swap(inplace_vector& other) noexcept(
+        std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>);
+    constexpr void clear() noexcept {
+        destroyFrom(0);
+        sz_ = 0;
+    }
+
+private:
+    // A constant expression needs every element of a plain array initialized, so the elements of
+    // a trivial T are value-initialized there; at run time they are left alone.
+    struct plainStorage {
+        constexpr plainStorage() noexcept {
+            if (std::is_constant_evaluated()) {
+                for (T& element : elements) {
+                    std::construct_at(std::addressof(element));
+                }
+            }
+        }
+
+        T elements[N];
+    };
+
+    // Any other T lives in a union, which keeps the elements past sz_ from being constructed.
+    union unionStorage {
+        constexpr unionStorage() noexcept {
+        }
+        constexpr unionStorage(const unionStorage&) = default;
+        constexpr unionStorage(unionStorage&&) = default;
+        constexpr unionStorage& operator=(const unionStorage&) = default;
+        constexpr unionStorage& operator=(unionStorage&&) = default;
+        constexpr ~unionStorage()
+            requires std::is_trivially_destructible_v<T>
+        = default;
+        constexpr ~unionStorage() {
+        }
+
+        T elements[N];
+    };
+
+    // Elements [0, sz_) are alive.
+    std::conditional_t<std::is_trivially_default_constructible_v<T> &&
+                           std::is_trivially_destructible_v<T>,
+                       plainStorage, unionStorage>
+        storage_;
+    size_type sz_ = 0;
+
+    static constexpr void checkCapacity(size_type count) {
+        if (count > N) {
+            throw std::bad_alloc();
+        }
+    }
+
+    constexpr void destroyFrom(size_type first) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::destroy(data() + first, data() + sz_);
+        }
+    }
+
+    // Appends [first, last), checking the capacity up front when the count is known. If an
+    // element can't be added, the ones appended before it are removed again.
+    template <class InputIterator, class Sentinel>
+    constexpr void append(InputIterator first, Sentinel last);
+
+    // Runs appendRange, which appends the elements to insert, and rotates them into place.
+    template <class AppendRange>
+    constexpr iterator insertAppended(const_iterator position, AppendRange appendRange);
+
+    // Copy and move assignment of non-trivial elements: assigns over the elements both have,
+    // then constructs or destroys the rest.
+    template <class InputIterator>
+    constexpr void assignCommon(InputIterator first, size_type count);
+};
+
+template <class T, std::size_t N>
+constexpr void inplace_vector<T, N>::resize(size_type count) {
+    checkCapacity(count);
+
+    if (count < sz_) {
+        destroyFrom(count);
+        sz_ = count;
+    } else {
+        while (sz_ < count) {
+            unchecked_emplace_back();
+        }
+    }
+}
+
+template <class T, std::size_t N>
+constexpr void inplace_vector<T, N>::resize(size_type count, const T& value) {
+    checkCapacity(count);
+
+    if (count < sz_) {
+        destroyFrom(count);
+        sz_ = count;
+    } else if (count > sz_) {
+        insert(end(), count - sz_, value);
+    }
+}
+
+template <class T, std::size_t N>
+template <class... Args>
+constexpr inplace_vector<T, N>::iterator inplace_vector<T, N>::emplace(const_iterator position,
+                                                                       Args&&... args) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+    checkCapacity(sz_ + 1);
+
+    if (positionAsIndex == sz_) {
+        unchecked_emplace_back(std::forward<Args>(args)...);
+    } else {
+        // args may refer to an element that is about to move.
+        T temp(std::forward<Args>(args)...);
+
+        unchecked_emplace_back(std::move(data()[sz_ - 1]));
+        std::move_backward(data() + positionAsIndex, data() + sz_ - 2, data() + sz_ - 1);
+        data()[positionAsIndex] = std::move(temp);
+    }
+
+    return iterator(data() + positionAsIndex);
+}
+
+template <class T, std::size_t N>
+constexpr inplace_vector<T, N>::iterator inplace_vector<T, N>::insert(const_iterator position,
+                                                                      size_type count,
+                                                                      const T& value) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+    checkCapacity(sz_ + count);
+
+    if (count == 0) {
+        return iterator(data() + positionAsIndex);
+    }
+
+    T temp(value);
+    const size_type oldSize = sz_;
+    const size_type tail = oldSize - positionAsIndex;
+
+    // As in vector: slots past the old end are constructed, the others assigned.
+    try {
+        if (count <= tail) {
+            for (size_type i = oldSize - count; i < oldSize; ++i) {
+                unchecked_emplace_back(std::move(data()[i]));
+            }
+            std::move_backward(data() + positionAsIndex, data() + oldSize - count,
+                               data() + oldSize);
+            std::fill_n(data() + positionAsIndex, count, temp);
+        } else {
+            while (sz_ < positionAsIndex + count) {
+                unchecked_emplace_back(temp);
+            }
+            for (size_type i = positionAsIndex; i < oldSize; ++i) {
+                unchecked_emplace_back(std::move(data()[i]));
+            }
+            std::fill_n(data() + positionAsIndex, tail, temp);
+        }
+    } catch (...) {
+        destroyFrom(oldSize);
+        sz_ = oldSize;
+        throw;
+    }
+
+    return iterator(data() + positionAsIndex);
+}
+
+template <class T, std::size_t N>
+constexpr inplace_vector<T, N>::iterator inplace_vector<T, N>::erase(const_iterator first,
+                                                                     const_iterator last) {
+    const size_type positionAsIndex = size_type(first - cbegin());
+    const size_type count = size_type(last - first);
+    COOLSTD_CHECK(positionAsIndex <= sz_ && count <= sz_ - positionAsIndex,
+                  "erase() range is not within [begin(), end()]");
+
+    if (count > 0) {
+        std::move(data() + positionAsIndex + count, data() + sz_, data() + positionAsIndex);
+        destroyFrom(sz_ - count);
+        sz_ -= count;
+    }
+
+    return iterator(data() + positionAsIndex);
+}
+
+template <class T, std::size_t N>
+constexpr void inplace_vector<T, N>::swap(inplace_vector& other) noexcept(
+    std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>) {
+    inplace_vector& shorter = sz_ < other.sz_ ? *this : other;
+    inplace_vector& longer = sz_ < other.sz_ ? other : *this;
+    const size_type common = shorter.sz_;
+
+    std::swap_ranges(shorter.data(), shorter.data() + common, longer.data());
+    for (size_type i = common; i < longer.sz_; ++i) {
+        shorter.unchecked_emplace_back(std::move(longer.data()[i]));
+    }
+    longer.destroyFrom(common);
+    longer.sz_ = common;
+}
+
+template <class T, std::size_t N>
+template <class InputIterator, class Sentinel>
+constexpr void inplace_vector<T, N>::append(InputIterator first, Sentinel last) {
+    const size_type oldSize = sz_;
+
+    if constexpr (std::forward_iterator<InputIterator>) {
+        checkCapacity(sz_ + size_type(std::ranges::distance(first, last)));
+    }
+
+    try {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    } catch (...) {
+        destroyFrom(oldSize);
+        sz_ = oldSize;
+        throw;
+    }
+}
+
+template <class T, std::size_t N>
+template <class AppendRange>
+constexpr inplace_vector<T, N>::iterator inplace_vector<T, N>::insertAppended(
+    const_iterator position, AppendRange appendRange) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+    const size_type oldSize = sz_;
+
+    appendRange();
+    std::rotate(data() + positionAsIndex, data() + oldSize, data() + sz_);
+
+    return iterator(data() + positionAsIndex);
+}
+
+template <class T, std::size_t N>
+template <class InputIterator>
+constexpr void inplace_vector<T, N>::assignCommon(InputIterator first, size_type count) {
+    const size_type common = std::min(sz_, count);
+
+    for (size_type i = 0; i < common; ++i, ++first) {
+        data()[i] = *first;
+    }
+    if (count < sz_) {
+        destroyFrom(count);
+        sz_ = count;
+    }
+    for (; sz_ < count; ++first) {
+        unchecked_emplace_back(*first);
+    }
+}
+
+template <class T, std::size_t N>
+constexpr void swap(inplace_vector<T, N>& lhs,
+                    inplace_vector<T, N>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <class T, std::size_t N>
+constexpr bool operator==(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, std::size_t N>
+constexpr auto operator<=>(const inplace_vector<T, N>& lhs, const inplace_vector<T, N>& rhs) {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                                                  detail::synthThreeWay{});
+}
+}  // namespace coolstd
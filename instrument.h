@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "vector.h"
+
+namespace coolstd::instrument {
+
+// Running totals for one call site. Vectors on different threads may share a site, so every
+// counter is a relaxed atomic: each value is exact, but a snapshot is not taken atomically
+// across counters.
+struct counters {
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> deallocations{0};
+    std::atomic<std::uint64_t> reallocations{0};
+    std::atomic<std::uint64_t> resized_by_allocator{0};
+    std::atomic<std::uint64_t> relocated_bitwise{0};
+    std::atomic<std::uint64_t> relocated_moved{0};
+    std::atomic<std::uint64_t> relocated_copied{0};
+    std::atomic<std::uint64_t> relocated_bytes{0};
+    std::atomic<std::uint64_t> shifted{0};
+    std::atomic<std::uint64_t> live_bytes{0};
+    std::atomic<std::uint64_t> peak_live_bytes{0};
+    std::atomic<std::uint64_t> peak_capacity_bytes{0};
+    std::atomic<std::uint64_t> released_bytes{0};
+    std::atomic<std::uint64_t> released_slack_bytes{0};
+};
+
+// Plain copy of one site's counters.
+struct site_stats {
+    std::string site;
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t reallocations = 0;
+    std::uint64_t resized_by_allocator = 0;  // reallocations served by try_expand/reallocate
+    std::uint64_t relocated_bitwise = 0;     // elements, memcpy'd
+    std::uint64_t relocated_moved = 0;       // elements, move-constructed
+    std::uint64_t relocated_copied = 0;      // elements, copy-constructed (throwing move)
+    std::uint64_t relocated_bytes = 0;
+    std::uint64_t shifted = 0;               // elements slid by insert/emplace/erase
+    std::uint64_t live_bytes = 0;            // capacity currently held, in bytes
+    std::uint64_t peak_live_bytes = 0;
+    std::uint64_t peak_capacity_bytes = 0;   // largest single block
+    std::uint64_t released_bytes = 0;        // capacity of released blocks, in bytes
+    std::uint64_t released_slack_bytes = 0;  // of which never held an element
+
+    // Fraction of released capacity that was never used.
+    double slack_ratio() const noexcept {
+        return released_bytes == 0 ? 0.0 : double(released_slack_bytes) / double(released_bytes);
+    }
+};
+
+// Process-wide list of instrumented call sites. Sites register themselves the first time a
+// vector tagged with them reports an event, which happens inside noexcept hooks: each site owns
+// its list entry and is pushed onto the list with a compare-and-swap, so registering can neither
+// allocate nor throw.
+class registry {
+public:
+    // One site's counters and its link in the list. Constructing an entry registers it.
+    struct entry {
+        explicit entry(const char* name) noexcept;
+
+        const char* site;
+        counters siteCounters;
+        entry* next = nullptr;
+    };
+
+    static registry& instance() noexcept {
+        static registry global;
+        return global;
+    }
+
+    void add(entry& site) noexcept {
+        site.next = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(site.next, &site, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+    }
+
+    // Sites in the order they registered.
+    std::vector<site_stats> snapshot() const {
+        std::vector<site_stats> result;
+
+        for (const entry* e = head_.load(std::memory_order_acquire); e != nullptr; e = e->next) {
+            const char* site = e->site;
+            const counters* c = &e->siteCounters;
+            auto load = [](const std::atomic<std::uint64_t>& counter) {
+                return counter.load(std::memory_order_relaxed);
+            };
+
+            result.push_back({site, load(c->allocations), load(c->deallocations),
+                              load(c->reallocations), load(c->resized_by_allocator),
+                              load(c->relocated_bitwise), load(c->relocated_moved),
+                              load(c->relocated_copied), load(c->relocated_bytes),
+                              load(c->shifted), load(c->live_bytes), load(c->peak_live_bytes),
+                              load(c->peak_capacity_bytes), load(c->released_bytes),
+                              load(c->released_slack_bytes)});
+        }
+        std::reverse(result.begin(), result.end());
+
+        return result;
+    }
+
+    // Statistics for one site; all zero if nothing was recorded under that name yet.
+    site_stats find(const std::string& site) const {
+        for (site_stats& stats : snapshot()) {
+            if (stats.site == site) {
+                return stats;
+            }
+        }
+
+        return site_stats{site};
+    }
+
+    // Zeroes every counter except live_bytes, which still describes blocks that are held.
+    void reset() {
+        for (entry* e = head_.load(std::memory_order_acquire); e != nullptr; e = e->next) {
+            counters* c = &e->siteCounters;
+
+            for (std::atomic<std::uint64_t>* counter :
+                 {&c->allocations, &c->deallocations, &c->reallocations, &c->resized_by_allocator,
+                  &c->relocated_bitwise, &c->relocated_moved, &c->relocated_copied,
+                  &c->relocated_bytes, &c->shifted, &c->released_bytes,
+                  &c->released_slack_bytes}) {
+                counter->store(0, std::memory_order_relaxed);
+            }
+            c->peak_live_bytes.store(c->live_bytes.load(std::memory_order_relaxed),
+                                     std::memory_order_relaxed);
+            c->peak_capacity_bytes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // One JSON object per site, keyed by site name. Site names must not need escaping.
+    void write_json(std::ostream& out) const {
+        const std::vector<site_stats> sites = snapshot();
+
+        out << "{";
+        for (std::size_t i = 0; i < sites.size(); ++i) {
+            const site_stats& s = sites[i];
+
+            out << (i == 0 ? "\n" : ",\n") << "  \"" << s.site << "\": {"
+                << "\"allocations\": " << s.allocations
+                << ", \"deallocations\": " << s.deallocations
+                << ", \"reallocations\": " << s.reallocations
+                << ", \"resized_by_allocator\": " << s.resized_by_allocator
+                << ", \"relocated_bitwise\": " << s.relocated_bitwise
+                << ", \"relocated_moved\": " << s.relocated_moved
+                << ", \"relocated_copied\": " << s.relocated_copied
+                << ", \"relocated_bytes\": " << s.relocated_bytes
+                << ", \"shifted\": " << s.shifted << ", \"live_bytes\": " << s.live_bytes
+                << ", \"peak_live_bytes\": " << s.peak_live_bytes
+                << ", \"peak_capacity_bytes\": " << s.peak_capacity_bytes
+                << ", \"released_bytes\": " << s.released_bytes
+                << ", \"released_slack_bytes\": " << s.released_slack_bytes
+                << ", \"slack_ratio\": " << s.slack_ratio() << "}";
+        }
+        out << "\n}\n";
+    }
+
+private:
+    registry() = default;
+
+    std::atomic<entry*> head_{nullptr};
+};
+
+inline registry::entry::entry(const char* name) noexcept : site(name) {
+    registry::instance().add(*this);
+}
+
+// String literal usable as a template argument: counted<"parser.tokens">.
+template <std::size_t N>
+struct site_name {
+    char value[N];
+
+    constexpr site_name(const char (&name)[N]) {
+        std::copy_n(name, N, value);
+    }
+};
+
+// Counting instrumentation policy. Every vector whose type names the same site shares one set
+// of counters, wherever it is declared:
+//   coolstd::vector<Token, std::allocator<Token>, coolstd::growth::doubling,
+//                   coolstd::instrument::counted<"lexer.tokens">> tokens;
+template <site_name Site>
+struct counted {
+    static counters& site() noexcept {
+        static registry::entry registered(Site.value);
+
+        return registered.siteCounters;
+    }
+
+    static void on_allocate(std::size_t capacity, std::size_t elementSize) noexcept {
+        counters& c = site();
+        const std::uint64_t bytes = capacity * elementSize;
+
+        c.allocations.fetch_add(1, std::memory_order_relaxed);
+        raise(c.peak_live_bytes, c.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+        raise(c.peak_capacity_bytes, bytes);
+    }
+
+    static void on_deallocate(std::size_t capacity, std::size_t size,
+                              std::size_t elementSize) noexcept {
+        counters& c = site();
+
+        c.deallocations.fetch_add(1, std::memory_order_relaxed);
+        c.live_bytes.fetch_sub(capacity * elementSize, std::memory_order_relaxed);
+        c.released_bytes.fetch_add(capacity * elementSize, std::memory_order_relaxed);
+        c.released_slack_bytes.fetch_add((capacity - std::min(size, capacity)) * elementSize,
+                                         std::memory_order_relaxed);
+    }
+
+    static void on_reallocate(std::size_t oldCapacity, std::size_t newCapacity, bool resized,
+                              std::size_t elementSize) noexcept {
+        counters& c = site();
+
+        c.reallocations.fetch_add(1, std::memory_order_relaxed);
+        if (resized) {
+            // No allocate/deallocate pair is reported for these, so the block's growth is
+            // accounted for here; unsigned wrap-around handles shrinking.
+            const std::uint64_t delta =
+                std::uint64_t(newCapacity * elementSize) - std::uint64_t(oldCapacity * elementSize);
+
+            c.resized_by_allocator.fetch_add(1, std::memory_order_relaxed);
+            raise(c.peak_live_bytes,
+                  c.live_bytes.fetch_add(delta, std::memory_order_relaxed) + delta);
+            raise(c.peak_capacity_bytes, newCapacity * elementSize);
+        }
+    }
+
+    static void on_relocate(std::size_t count, relocation kind, std::size_t elementSize) noexcept {
+        counters& c = site();
+        std::atomic<std::uint64_t>& counter = kind == relocation::bitwise ? c.relocated_bitwise
+                                              : kind == relocation::moved ? c.relocated_moved
+                                                                          : c.relocated_copied;
+
+        counter.fetch_add(count, std::memory_order_relaxed);
+        c.relocated_bytes.fetch_add(count * elementSize, std::memory_order_relaxed);
+    }
+
+    static void on_shift(std::size_t count, std::size_t /*elementSize*/) noexcept {
+        site().shifted.fetch_add(count, std::memory_order_relaxed);
+    }
+
+private:
+    static void raise(std::atomic<std::uint64_t>& peak, std::uint64_t value) noexcept {
+        std::uint64_t current = peak.load(std::memory_order_relaxed);
+
+        while (current < value &&
+               !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+}  // namespace coolstd::instrument
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include "vector.h"
+
+namespace coolstd {
+
+// How a mapped_file maps its file.
+enum class map_mode {
+    read_only,      // PROT_READ, shared: zero-copy, writing to the elements faults
+    read_write,     // shared: writes go to the file, and growing the vector grows the file
+    copy_on_write,  // private: writable, but modified pages are copies the file never sees
+};
+
+// madvise() hints for a mapped range.
+enum class advice { normal, sequential, random, will_need, dont_need };
+
+// A file mapped into memory, to back one coolstd::vector through mmap_allocator (see
+// open_mapped below). The mapping reserves address space beyond the end of the file up front,
+// `reserve` bytes or by default twice the file size and at least 1 GiB, so a read_write vector
+// grows the file with ftruncate() alone while its buffer keeps its address; past the
+// reservation the mapping is enlarged with mremap(), moving it if it has to. read_only and
+// copy_on_write mappings can't grow past the file: pages beyond its end would fault.
+//
+// The file is left holding the vector's capacity, not its size: call shrink_to_fit() on the
+// vector before it goes to trim the file to the elements. POSIX; mremap() is Linux-only, and
+// elsewhere growth stops at the reservation.
+class mapped_file {
+public:
+    // read_write creates the file if it doesn't exist. Throws std::system_error on failure.
+    explicit mapped_file(const char* path, map_mode mode = map_mode::read_only,
+                         std::size_t reserve = 0)
+        : mode_(mode) {
+        fd_ = ::open(path, mode == map_mode::read_write ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+        if (fd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "open");
+        }
+
+        struct stat status {};
+        if (::fstat(fd_, &status) != 0) {
+            const int error = errno;
+            ::close(fd_);
+            throw std::system_error(error, std::generic_category(), "fstat");
+        }
+        size_ = std::size_t(status.st_size);
+        reserved_ = roundToPage(std::max({reserve, size_, std::min(size_ * 2, maxReserve),
+                                          std::size_t(1) << 30}));
+
+        const int protection =
+            mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        const int flags = mode == map_mode::copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+
+        void* address = ::mmap(nullptr, reserved_, protection, flags | MAP_NORESERVE, fd_, 0);
+        if (address == MAP_FAILED) {
+            const int error = errno;
+            ::close(fd_);
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        data_ = static_cast<std::byte*>(address);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file() {
+        ::munmap(data_, reserved_);
+        ::close(fd_);
+    }
+
+    // The file's contents: size() bytes at data(). Growth through the vector may move them.
+    std::byte* data() const noexcept {
+        return data_;
+    }
+    std::size_t size() const noexcept {
+        return size_;
+    }
+    map_mode mode() const noexcept {
+        return mode_;
+    }
+
+    // madvise() over [offset, offset + bytes) of the file, clamped to its size; offset is
+    // rounded down to a page.
+    void advise(advice hint, std::size_t offset = 0,
+                std::size_t bytes = std::numeric_limits<std::size_t>::max()) const {
+        static constexpr int hints[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM,
+                                        MADV_WILLNEED, MADV_DONTNEED};
+
+        if (offset >= size_) {
+            return;
+        }
+
+        const std::size_t first = offset / pageSize() * pageSize();
+        const std::size_t last = offset + std::min(bytes, size_ - offset);
+        if (::madvise(data_ + first, last - first, hints[int(hint)]) != 0) {
+            throw std::system_error(errno, std::generic_category(), "madvise");
+        }
+    }
+
+    // The single block handed to mmap_allocator: the start of the mapping, with the file grown
+    // to at least `bytes`. A second live block can't exist, since both would be the file.
+    void* acquire(std::size_t bytes) {
+        if (acquired_) {
+            throw std::logic_error("mapped_file backs a single buffer at a time");
+        }
+
+        if (bytes > size_ && !resize(bytes, false)) {
+            throw std::length_error("a read_only or copy_on_write mapping can't grow");
+        }
+        acquired_ = true;
+        return data_;
+    }
+
+    void release() noexcept {
+        acquired_ = false;
+    }
+
+    // Resizes the file to `bytes`, keeping the mapping where it is; false if it would have to
+    // move or the mode doesn't allow growing.
+    bool try_resize(std::size_t bytes) noexcept {
+        try {
+            return resize(bytes, false);
+        } catch (...) {
+            return false;
+        }
+    }
+
+    // Resizes the file to `bytes`, moving the mapping with mremap() if it must. Returns its
+    // new address; throws if the mode doesn't allow growing.
+    void* relocate(std::size_t bytes) {
+        if (!resize(bytes, true)) {
+            throw std::length_error("a read_only or copy_on_write mapping can't grow");
+        }
+
+        return data_;
+    }
+
+private:
+    // Keeps the default reservation within reach of a 32-bit address space.
+    static constexpr std::size_t maxReserve = std::numeric_limits<std::size_t>::max() / 4;
+
+    static std::size_t pageSize() noexcept {
+        static const std::size_t size = std::size_t(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    static std::size_t roundToPage(std::size_t bytes) noexcept {
+        return (bytes + pageSize() - 1) / pageSize() * pageSize();
+    }
+
+    bool resize(std::size_t bytes, bool mayMove) {
+        if (mode_ != map_mode::read_write) {
+            return bytes <= size_;
+        }
+        if (bytes == size_) {
+            return true;
+        }
+
+        if (bytes > reserved_) {
+            const std::size_t reserved = roundToPage(std::max(bytes, std::min(reserved_ * 2,
+                                                                               maxReserve)));
+#if defined(MREMAP_MAYMOVE)
+            void* address =
+                ::mremap(data_, reserved_, reserved, mayMove ? MREMAP_MAYMOVE : 0);
+            if (address == MAP_FAILED) {
+                if (!mayMove) {
+                    return false;
+                }
+                throw std::system_error(errno, std::generic_category(), "mremap");
+            }
+            data_ = static_cast<std::byte*>(address);
+            reserved_ = reserved;
+#else
+            (void)reserved;
+            (void)mayMove;
+            return false;
+#endif
+        }
+
+        if (::ftruncate(fd_, off_t(bytes)) != 0) {
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+        }
+        size_ = bytes;
+        return true;
+    }
+
+    int fd_ = -1;
+    map_mode mode_;
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t reserved_ = 0;
+    bool acquired_ = false;
+};
+
+// Allocator whose one block is a mapped_file. It implements try_expand() and reallocate(), so a
+// vector over it grows the file in place (ftruncate within the reservation) or by mremap()
+// instead of allocating a second block and copying; only trivially copyable types make sense,
+// since the file outlives their lifetimes. It declares is_single_block, so insertions anywhere in
+// the vector grow it the same way. Like arena_allocator it does not propagate, and a copy of the
+// vector needs a different allocator: coolstd::vector<T> copy(first, last).
+template <class T>
+class mmap_allocator {
+    static_assert(std::is_trivially_copyable_v<T>, "a file holds bytes, not objects");
+
+public:
+    using value_type = T;
+    using is_single_block = std::true_type;
+
+    explicit mmap_allocator(mapped_file& file) noexcept : file_(&file) {
+    }
+
+    template <class U>
+    constexpr mmap_allocator(const mmap_allocator<U>& other) noexcept : file_(other.resource()) {
+    }
+
+    T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(file_->acquire(n * sizeof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {
+        file_->release();
+    }
+
+    bool try_expand(T*, std::size_t, std::size_t newCount) const noexcept {
+        return newCount <= std::numeric_limits<std::size_t>::max() / sizeof(T) &&
+               file_->try_resize(newCount * sizeof(T));
+    }
+
+    T* reallocate(T*, std::size_t, std::size_t newCount) {
+        if (newCount > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(file_->relocate(newCount * sizeof(T)));
+    }
+
+    mapped_file* resource() const noexcept {
+        return file_;
+    }
+
+    friend bool operator==(const mmap_allocator& lhs, const mmap_allocator& rhs) noexcept {
+        return lhs.resource() == rhs.resource();
+    }
+
+private:
+    mapped_file* file_;
+};
+
+template <class T, class GrowthPolicy = growth::doubling>
+using mapped_vector = vector<T, mmap_allocator<T>, GrowthPolicy>;
+
+// A vector over the whole of file: its size() is the file size in elements, and its data() is
+// the mapping itself, so nothing is read until an element is touched. T must be trivially
+// default constructible too, so that the elements are adopted as they are in the file.
+template <class T, class GrowthPolicy = growth::doubling>
+mapped_vector<T, GrowthPolicy> open_mapped(mapped_file& file) {
+    static_assert(std::is_trivially_default_constructible_v<T>,
+                  "the file's bytes are adopted without constructing anything");
+
+    mapped_vector<T, GrowthPolicy> vec{mmap_allocator<T>(file)};
+    if (file.size() >= sizeof(T)) {
+        // Exactly the file: a policy that rounds capacities up would grow a read_only mapping.
+        vec.reserve(file.size() / sizeof(T));
+        vec.resize_for_overwrite(file.size() / sizeof(T));
+    }
+    return vec;
+}
+
+}  // namespace coolstd
@@ -0,0 +1,679 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace coolstd::par {
+
+// Work-stealing thread pool. Every worker owns a deque: tasks it submits go on the back and it
+// runs its own newest task first, while idle workers steal the oldest task from the front of
+// someone else's deque. Fork-join algorithms split ranges in halves, so the oldest task is the
+// largest piece of outstanding work and a single steal moves a lot of it.
+//
+// The thread count includes the caller: a thread that waits for parallel work runs queued tasks
+// until it is done, so thread_pool(1) starts no workers and runs everything inline. Threads that
+// aren't workers share one queue.
+class thread_pool {
+public:
+    explicit thread_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+        : queues_(std::max<std::size_t>(threads, 1)) {
+        for (std::unique_ptr<Queue>& queue : queues_) {
+            queue = std::make_unique<Queue>();
+        }
+        workers_.reserve(queues_.size() - 1);
+        for (std::size_t index = 1; index < queues_.size(); ++index) {
+            workers_.emplace_back([this, index] { work(index); });
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // Tasks still queued are dropped; the algorithms below never leave any behind.
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    std::size_t size() const noexcept {
+        return queues_.size();
+    }
+
+    void submit(std::function<void()> task) {
+        Queue& queue = *queues_[ownQueue()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        queued_.fetch_add(1);
+        if (sleeping_.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            wake_.notify_one();
+        }
+    }
+
+    // Runs one queued task on the calling thread: its own newest task if it has one, otherwise
+    // the oldest task of another queue. Returns false if every queue was empty.
+    bool run_pending() {
+        const std::size_t own = ownQueue();
+        std::function<void()> task;
+
+        if (runPinned(own)) {
+            return true;
+        }
+
+        if (!pop(own, task)) {
+            for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+                if (steal((own + offset) % queues_.size(), task)) {
+                    break;
+                }
+            }
+        }
+
+        if (!task) {
+            return false;
+        }
+
+        queued_.fetch_sub(1);
+        task();
+        return true;
+    }
+
+    // Runs fn(index) exactly once on each of the size() threads, the caller being thread 0, and
+    // returns once all calls have finished. These tasks are never stolen, so the same index
+    // always runs on the same thread: work split this way touches the same memory from the same
+    // thread (and NUMA node) every time. The first exception is rethrown; the other calls still
+    // run.
+    template <class Fn>
+    void run_on_each(const Fn& fn) {
+        std::atomic<std::size_t> remaining{queues_.size() - 1};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        auto call = [&](std::size_t index) {
+            try {
+                fn(index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        };
+
+        for (std::size_t index = 1; index < queues_.size(); ++index) {
+            Queue& queue = *queues_[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.pinned.push_back([&call, &remaining, index] {
+                call(index);
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+            queue.pinnedCount.fetch_add(1);
+        }
+        if (queues_.size() > 1) {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            wake_.notify_all();
+        }
+
+        call(0);
+        while (remaining.load(std::memory_order_acquire) > 0) {
+            if (!run_pending()) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::deque<std::function<void()>> pinned;  // run_on_each() calls, owner only
+        std::atomic<std::size_t> pinnedCount{0};
+    };
+
+    bool runPinned(std::size_t index) {
+        Queue& queue = *queues_[index];
+        std::function<void()> task;
+
+        if (queue.pinnedCount.load() == 0) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            task = std::move(queue.pinned.front());
+            queue.pinned.pop_front();
+        }
+        queue.pinnedCount.fetch_sub(1);
+
+        task();
+        return true;
+    }
+
+    std::size_t ownQueue() const noexcept {
+        return currentPool == this ? currentQueue : 0;
+    }
+
+    bool pop(std::size_t index, std::function<void()>& task) {
+        Queue& queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(std::size_t index, std::function<void()>& task) {
+        Queue& queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+
+    void work(std::size_t index) {
+        currentPool = this;
+        currentQueue = index;
+
+        while (true) {
+            if (run_pending()) {
+                continue;
+            }
+
+            // sleeping_ and queued_ are sequentially consistent: either submit() sees this
+            // thread as sleeping and notifies under the mutex, or the predicate sees its task.
+            // run_on_each() queues pinned work before notifying under the same mutex.
+            Queue& own = *queues_[index];
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleeping_.fetch_add(1);
+            wake_.wait(lock, [&] {
+                return stop_ || queued_.load() > 0 || own.pinnedCount.load() > 0;
+            });
+            sleeping_.fetch_sub(1);
+
+            if (stop_) {
+                return;
+            }
+        }
+    }
+
+    static inline thread_local const thread_pool* currentPool = nullptr;
+    static inline thread_local std::size_t currentQueue = 0;
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> sleeping_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+};
+
+// Pool used when options::pool is null, sized to the hardware.
+inline thread_pool& default_pool() {
+    static thread_pool pool;
+    return pool;
+}
+
+// How a parallel call divides its range among threads.
+enum class schedule {
+    // Chunks of `grain` elements, load-balanced by work stealing.
+    dynamic,
+    // One contiguous block per thread, always assigned the same way: thread k of the pool
+    // processes the k-th block of any range of the same length. Pages first touched by a fixed
+    // pass (see vector's executor constructors) are later read by the same threads.
+    fixed,
+};
+
+struct options {
+    thread_pool* pool = nullptr;  // null: default_pool()
+    std::size_t grain = 0;  // elements per task; 0 picks one from the size and thread count
+    schedule scheduling = schedule::dynamic;  // grain is ignored for schedule::fixed
+
+    // The executor interface of coolstd::vector: calls body(begin, end) over [0, count) in chunks
+    // whose sizes are multiples of `multiple` (except the last), and returns when all are done.
+    template <class Body>
+    void for_each_chunk(std::size_t count, std::size_t multiple, const Body& body) const;
+};
+
+namespace detail {
+
+// Tasks forked by one parallel call. wait() runs queued tasks until all of them have finished
+// and rethrows the first exception any of them threw; once one has failed, the tasks that
+// haven't started yet are skipped.
+class task_group {
+public:
+    explicit task_group(thread_pool& pool) noexcept : pool_(pool) {
+    }
+
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    ~task_group() {
+        drain();
+    }
+
+    template <class Fn>
+    void run(Fn&& fn) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_.submit([this, fn = std::forward<Fn>(fn)]() mutable {
+            if (!failed_.load(std::memory_order_relaxed)) {
+                try {
+                    fn();
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+            }
+            pending_.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void wait() {
+        drain();
+        if (error_) {
+            std::rethrow_exception(std::exchange(error_, nullptr));
+        }
+    }
+
+private:
+    void drain() {
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            if (!pool_.run_pending()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void fail(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        if (!error_) {
+            error_ = std::move(error);
+            failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    thread_pool& pool_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<bool> failed_{false};
+    std::mutex errorMutex_;
+    std::exception_ptr error_;
+};
+
+inline thread_pool& poolOf(const options& opts) {
+    return opts.pool != nullptr ? *opts.pool : default_pool();
+}
+
+// Elements per chunk, rounded up to a multiple of `multiple`. For schedule::fixed that is one
+// block per thread. Otherwise it is the requested grain, or enough pieces for about eight tasks
+// per thread (so stealing can even out uneven work) but never fewer than `minimum` elements
+// each, which keeps the per-task overhead of cheap operations in check.
+inline std::size_t grainFor(const options& opts, std::size_t count, std::size_t minimum,
+                            std::size_t multiple = 1) {
+    const std::size_t threads = poolOf(opts).size();
+    std::size_t grain;
+
+    if (opts.scheduling == schedule::fixed) {
+        grain = (count + threads - 1) / threads;
+    } else if (opts.grain > 0) {
+        grain = opts.grain;
+    } else {
+        grain = threads == 1 ? count
+                             : std::max(minimum, (count + threads * 8 - 1) / (threads * 8));
+    }
+
+    return std::max<std::size_t>((grain + multiple - 1) / multiple * multiple, 1);
+}
+
+template <class Body>
+void splitChunks(task_group& group, std::size_t first, std::size_t last, const Body& body) {
+    while (last - first > 1) {
+        const std::size_t middle = first + (last - first) / 2;
+        group.run([&group, middle, last, &body] { splitChunks(group, middle, last, body); });
+        last = middle;
+    }
+    body(first);
+}
+
+// Calls body(chunk, begin, end) for consecutive chunks of `grain` elements covering
+// [0, count). Dynamic schedules fork by halves so that thieves take the largest remaining
+// pieces; fixed schedules run chunk k on thread k.
+template <class Body>
+void forEachChunk(const options& opts, std::size_t count, std::size_t grain, const Body& body) {
+    thread_pool& pool = poolOf(opts);
+    const std::size_t chunks = (count + grain - 1) / grain;
+    auto chunk = [&](std::size_t index) {
+        body(index, index * grain, std::min(count, (index + 1) * grain));
+    };
+
+    if (chunks <= 1) {
+        if (count > 0) {
+            chunk(0);
+        }
+    } else if (opts.scheduling == schedule::fixed) {
+        pool.run_on_each([&](std::size_t index) {
+            if (index < chunks) {
+                chunk(index);
+            }
+        });
+    } else {
+        task_group group(pool);
+        splitChunks(group, 0, chunks, chunk);
+        group.wait();
+    }
+}
+
+// Runs first() and second() in parallel.
+template <class First, class Second>
+void invoke(thread_pool& pool, First&& first, Second&& second) {
+    task_group group(pool);
+    group.run(std::forward<Second>(second));
+    first();
+    group.wait();
+}
+
+// Merges the sorted ranges [a, aLast) and [b, bLast) into out, moving the elements. Large
+// merges are split at the median of the longer range and its lower bound in the shorter one.
+template <class Input, class Output, class Compare>
+void merge(thread_pool& pool, Input a, Input aLast, Input b, Input bLast, Output out,
+           Compare& comp, std::size_t grain) {
+    if ((aLast - a) < (bLast - b)) {
+        std::swap(a, b);
+        std::swap(aLast, bLast);
+    }
+
+    if (std::size_t((aLast - a) + (bLast - b)) <= grain) {
+        std::merge(std::make_move_iterator(a), std::make_move_iterator(aLast),
+                   std::make_move_iterator(b), std::make_move_iterator(bLast), out, comp);
+        return;
+    }
+
+    const Input aMiddle = a + (aLast - a) / 2;
+    const Input bMiddle = std::lower_bound(b, bLast, *aMiddle, comp);
+    const Output outMiddle = out + ((aMiddle - a) + (bMiddle - b));
+
+    invoke(
+        pool, [&] { merge(pool, a, aMiddle, b, bMiddle, out, comp, grain); },
+        [&] { merge(pool, aMiddle, aLast, bMiddle, bLast, outMiddle, comp, grain); });
+}
+
+// Merge sort over two equally sized ranges of live elements. Sorts the count elements at data
+// and leaves the result in scratch when toScratch is set, in data otherwise.
+template <class Data, class Scratch, class Compare>
+void mergeSort(thread_pool& pool, Data data, Scratch scratch, std::size_t count, bool toScratch,
+               Compare& comp, std::size_t grain) {
+    if (count <= grain) {
+        std::sort(data, data + count, comp);
+        if (toScratch) {
+            std::move(data, data + count, scratch);
+        }
+        return;
+    }
+
+    const std::size_t half = count / 2;
+
+    // Each half ends up in the opposite range, so the merge reads from there and writes here.
+    invoke(
+        pool, [&] { mergeSort(pool, data, scratch, half, !toScratch, comp, grain); },
+        [&] {
+            mergeSort(pool, data + half, scratch + half, count - half, !toScratch, comp, grain);
+        });
+
+    if (toScratch) {
+        merge(pool, data, data + half, data + half, data + count, scratch, comp, grain);
+    } else {
+        merge(pool, scratch, scratch + half, scratch + half, scratch + count, data, comp, grain);
+    }
+}
+
+// Uninitialized storage for count elements of T, destroyed element by element on release.
+template <class T>
+class scratch_buffer {
+public:
+    explicit scratch_buffer(std::size_t count) : data_(allocator_.allocate(count)), count_(count) {
+    }
+
+    scratch_buffer(const scratch_buffer&) = delete;
+    scratch_buffer& operator=(const scratch_buffer&) = delete;
+
+    ~scratch_buffer() {
+        std::destroy_n(data_, constructed_);
+        allocator_.deallocate(data_, count_);
+    }
+
+    T* data() const noexcept {
+        return data_;
+    }
+
+    // Every element is constructed; they are destroyed with the buffer.
+    void set_constructed() noexcept {
+        constructed_ = count_;
+    }
+
+private:
+    std::allocator<T> allocator_;
+    T* data_;
+    std::size_t count_;
+    std::size_t constructed_ = 0;
+};
+
+}  // namespace detail
+
+template <class Body>
+void options::for_each_chunk(std::size_t count, std::size_t multiple, const Body& body) const {
+    detail::forEachChunk(*this, count, detail::grainFor(*this, count, 4096, multiple),
+                         [&](std::size_t, std::size_t begin, std::size_t end) {
+                             body(begin, end);
+                         });
+}
+
+// Calls fn on every element of [first, last).
+template <std::random_access_iterator Iterator, class Function>
+void for_each(Iterator first, Iterator last, Function fn, const options& opts = {}) {
+    const std::size_t count = std::size_t(last - first);
+
+    detail::forEachChunk(opts, count, detail::grainFor(opts, count, 4096),
+                         [&](std::size_t, std::size_t begin, std::size_t end) {
+                             std::for_each(first + begin, first + end, fn);
+                         });
+}
+
+// Writes fn(*i) for every i in [first, last) to the range starting at out.
+template <std::random_access_iterator Iterator, std::random_access_iterator Output,
+          class Function>
+Output transform(Iterator first, Iterator last, Output out, Function fn,
+                 const options& opts = {}) {
+    const std::size_t count = std::size_t(last - first);
+
+    detail::forEachChunk(opts, count, detail::grainFor(opts, count, 4096),
+                         [&](std::size_t, std::size_t begin, std::size_t end) {
+                             std::transform(first + begin, first + end, out + begin, fn);
+                         });
+
+    return out + count;
+}
+
+// Folds [first, last) into init with op, which must be associative. Chunks are combined in
+// order, so op need not be commutative.
+template <std::random_access_iterator Iterator, class T, class BinaryOperation = std::plus<>>
+T reduce(Iterator first, Iterator last, T init, BinaryOperation op = {},
+         const options& opts = {}) {
+    const std::size_t count = std::size_t(last - first);
+    const std::size_t grain = detail::grainFor(opts, count, 4096);
+    std::vector<std::optional<T>> partials((count + grain - 1) / grain);
+
+    detail::forEachChunk(opts, count, grain,
+                         [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                             T partial = first[begin];
+                             for (std::size_t i = begin + 1; i < end; ++i) {
+                                 partial = op(std::move(partial), first[i]);
+                             }
+                             partials[chunk].emplace(std::move(partial));
+                         });
+
+    for (std::optional<T>& partial : partials) {
+        init = op(std::move(init), std::move(*partial));
+    }
+
+    return init;
+}
+
+// Sorts [first, last) with a parallel merge sort: chunks are sorted with std::sort, then merged
+// pairwise, each merge itself split across threads. Uses a buffer of last - first elements.
+// Types whose move constructor can throw are sorted with std::sort on the calling thread.
+template <std::random_access_iterator Iterator, class Compare = std::less<>>
+void sort(Iterator first, Iterator last, Compare comp = {}, const options& opts = {}) {
+    using T = std::iter_value_t<Iterator>;
+    const std::size_t count = std::size_t(last - first);
+    const std::size_t grain = detail::grainFor(opts, count, 16384);
+
+    if (count <= grain || !std::is_nothrow_move_constructible_v<T>) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    thread_pool& pool = detail::poolOf(opts);
+    detail::scratch_buffer<T> buffer(count);
+
+    // The elements are moved to the buffer and sorted back into [first, last).
+    detail::forEachChunk(opts, count, grain, [&](std::size_t, std::size_t begin, std::size_t end) {
+        std::uninitialized_move(first + begin, first + end, buffer.data() + begin);
+    });
+    buffer.set_constructed();
+
+    detail::mergeSort(pool, buffer.data(), first, count, true, comp, grain);
+}
+
+// Reorders [first, last) so that the elements satisfying pred come first, keeping the relative
+// order within both groups, and returns the start of the second group. pred is called once per
+// element. Runs in three parallel passes over a flag array and an element buffer; types whose
+// move constructor can throw fall back to std::stable_partition.
+template <std::random_access_iterator Iterator, class Predicate>
+Iterator stable_partition(Iterator first, Iterator last, Predicate pred,
+                          const options& opts = {}) {
+    using T = std::iter_value_t<Iterator>;
+    const std::size_t count = std::size_t(last - first);
+    const std::size_t grain = detail::grainFor(opts, count, 4096);
+
+    if (count <= grain || !std::is_nothrow_move_constructible_v<T>) {
+        return std::stable_partition(first, last, pred);
+    }
+
+    const std::size_t chunks = (count + grain - 1) / grain;
+    std::unique_ptr<bool[]> flags(new bool[count]);
+    std::vector<std::size_t> selected(chunks + 1, 0);
+
+    detail::forEachChunk(opts, count, grain,
+                         [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                             std::size_t kept = 0;
+                             for (std::size_t i = begin; i < end; ++i) {
+                                 flags[i] = bool(pred(first[i]));
+                                 kept += flags[i];
+                             }
+                             selected[chunk + 1] = kept;
+                         });
+
+    // selected[chunk] becomes the number of selected elements before the chunk.
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        selected[chunk + 1] += selected[chunk];
+    }
+    const std::size_t total = selected[chunks];
+
+    detail::scratch_buffer<T> buffer(count);
+    T* const out = buffer.data();
+
+    detail::forEachChunk(opts, count, grain,
+                         [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                             std::size_t yes = selected[chunk];
+                             std::size_t no = total + (begin - selected[chunk]);
+
+                             for (std::size_t i = begin; i < end; ++i) {
+                                 ::new (static_cast<void*>(out + (flags[i] ? yes++ : no++)))
+                                     T(std::move(first[i]));
+                             }
+                         });
+    buffer.set_constructed();
+
+    detail::forEachChunk(opts, count, grain, [&](std::size_t, std::size_t begin, std::size_t end) {
+        std::move(out + begin, out + end, first + begin);
+    });
+
+    return first + total;
+}
+
+// Moves the elements not satisfying pred to the front, keeping their order, and returns the new
+// end. The elements after it are left in a valid but unspecified state.
+template <std::random_access_iterator Iterator, class Predicate>
+Iterator remove_if(Iterator first, Iterator last, Predicate pred, const options& opts = {}) {
+    return par::stable_partition(
+        first, last, [&pred](const auto& element) { return !bool(pred(element)); }, opts);
+}
+
+// Erases every element satisfying pred from a random-access container and returns how many
+// were erased.
+template <class Container, class Predicate>
+std::size_t erase_if(Container& container, Predicate pred, const options& opts = {}) {
+    const auto newEnd = par::remove_if(container.begin(), container.end(), pred, opts);
+    const std::size_t erased = std::size_t(container.end() - newEnd);
+
+    container.erase(newEnd, container.end());
+    return erased;
+}
+
+// Range overloads, for coolstd::vector and any other random-access range.
+
+template <std::ranges::random_access_range Range, class Function>
+void for_each(Range&& range, Function fn, const options& opts = {}) {
+    par::for_each(std::ranges::begin(range), std::ranges::end(range), std::move(fn), opts);
+}
+
+template <std::ranges::random_access_range Range, std::random_access_iterator Output,
+          class Function>
+Output transform(Range&& range, Output out, Function fn, const options& opts = {}) {
+    return par::transform(std::ranges::begin(range), std::ranges::end(range), out,
+                          std::move(fn), opts);
+}
+
+template <std::ranges::random_access_range Range, class T, class BinaryOperation = std::plus<>>
+T reduce(Range&& range, T init, BinaryOperation op = {}, const options& opts = {}) {
+    return par::reduce(std::ranges::begin(range), std::ranges::end(range), std::move(init),
+                       std::move(op), opts);
+}
+
+template <std::ranges::random_access_range Range, class Compare = std::less<>>
+void sort(Range&& range, Compare comp = {}, const options& opts = {}) {
+    par::sort(std::ranges::begin(range), std::ranges::end(range), std::move(comp), opts);
+}
+
+}  // namespace coolstd::par
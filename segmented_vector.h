@@ -0,0 +1,593 @@
+#pragma once
+
+#include <bit>
+#include <iterator>
+#include <stdexcept>
+
+#include "vector.h"
+
+namespace coolstd {
+// A vector for very large element counts that never relocates. Elements live in equal segments
+// of SegmentSize (a power of two) elements, reached through a directory of segment pointers, so
+// element i is segment i >> log2(SegmentSize), offset i & (SegmentSize - 1). Growing allocates
+// one more segment: peak memory stays at the element count plus one segment instead of the 3x a
+// doubling reallocation briefly needs, no element is ever copied, and references stay valid
+// until the element is erased. Only the directory, a coolstd::vector of segment pointers,
+// reallocates, which invalidates iterators as in vector. Elements are not contiguous: there is
+// no data(), and the iterators are random access.
+template <class T, class Allocator = std::allocator<T>,
+          std::size_t SegmentSize = std::bit_floor(std::max<std::size_t>(1, 65536 / sizeof(T)))>
+class segmented_vector {
+    static_assert(std::has_single_bit(SegmentSize), "SegmentSize must be a power of two");
+
+    template <bool Const>
+    class Iterator;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type segment_size = SegmentSize;
+
+    // construct/copy/destroy
+    segmented_vector() noexcept(noexcept(Allocator())) : segmented_vector(Allocator()) {
+    }
+    explicit segmented_vector(const Allocator& alloc) noexcept
+        : segments_(SegmentAllocator(alloc)), allocator(alloc) {
+    }
+    explicit segmented_vector(size_type count, const Allocator& alloc = Allocator())
+        : segmented_vector(alloc) {
+        guarded([&] { resize(count); });
+    }
+    segmented_vector(size_type count, const T& value, const Allocator& alloc = Allocator())
+        : segmented_vector(alloc) {
+        guarded([&] { resize(count, value); });
+    }
+    template <class InputIterator>
+    segmented_vector(
+        InputIterator first, InputIterator last, const Allocator& alloc = Allocator(),
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr)
+        : segmented_vector(alloc) {
+        guarded([&] { append(first, last); });
+    }
+    segmented_vector(std::initializer_list<T> initializerList,
+                     const Allocator& alloc = Allocator())
+        : segmented_vector(initializerList.begin(), initializerList.end(), alloc) {
+    }
+    segmented_vector(const segmented_vector& copyVector)
+        : segmented_vector(std::allocator_traits<Allocator>::select_on_container_copy_construction(
+              copyVector.allocator)) {
+        guarded([&] { append(copyVector.begin(), copyVector.end()); });
+    }
+    segmented_vector(segmented_vector&& moveVector) noexcept
+        : segments_(std::move(moveVector.segments_)),
+          sz_(moveVector.sz_),
+          allocator(std::move(moveVector.allocator)) {
+        moveVector.sz_ = 0;
+    }
+
+    ~segmented_vector() {
+        clear();
+        releaseSegments(0);
+    }
+
+    segmented_vector& operator=(const segmented_vector& copyVector);
+    segmented_vector& operator=(segmented_vector&& moveVector) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+    segmented_vector& operator=(std::initializer_list<T> initializerList) {
+        assign(initializerList.begin(), initializerList.end());
+
+        return *this;
+    }
+
+    template <class InputIterator>
+    void assign(
+        InputIterator first, InputIterator last,
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr) {
+        clear();
+        append(first, last);
+    }
+    void assign(size_type count, const T& value) {
+        T temp(value);
+
+        clear();
+        resize(count, temp);
+    }
+    allocator_type get_allocator() const noexcept {
+        return allocator;
+    }
+
+    // iterators
+    iterator begin() noexcept {
+        return iterator(segments_.data(), 0);
+    }
+    iterator end() noexcept {
+        return iterator(segments_.data(), sz_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(segments_.data(), 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(segments_.data(), sz_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    // capacity
+    bool empty() const noexcept {
+        return sz_ == 0;
+    }
+    size_type size() const noexcept {
+        return sz_;
+    }
+    size_type capacity() const noexcept {
+        return segments_.size() * SegmentSize;
+    }
+    size_type max_size() const noexcept {
+        return std::allocator_traits<Allocator>::max_size(allocator) / 2;
+    }
+    void resize(size_type count);
+    void resize(size_type count, const T& value);
+    // Allocates segments until count elements fit.
+    void reserve(size_type count);
+    // Frees the segments past the one holding the last element, and the directory's slack.
+    void shrink_to_fit();
+
+    // element access
+    reference operator[](size_type n) {
+        return segments_[n >> segmentBits][n & segmentMask];
+    }
+    const_reference operator[](size_type n) const {
+        return segments_[n >> segmentBits][n & segmentMask];
+    }
+    reference at(size_type pos) {
+        if (pos < sz_) {
+            return (*this)[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    const_reference at(size_type pos) const {
+        if (pos < sz_) {
+            return (*this)[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    reference front() {
+        return (*this)[0];
+    }
+    const_reference front() const {
+        return (*this)[0];
+    }
+    reference back() {
+        return (*this)[sz_ - 1];
+    }
+    const_reference back() const {
+        return (*this)[sz_ - 1];
+    }
+
+    // The count elements of segment k are contiguous at segment(k); count is segment_size for
+    // every segment but the last occupied one.
+    T* segment(size_type k) noexcept {
+        return segments_[k];
+    }
+    const T* segment(size_type k) const noexcept {
+        return segments_[k];
+    }
+    size_type segment_count() const noexcept {
+        return (sz_ + segmentMask) >> segmentBits;
+    }
+
+    // modifiers
+    template <class... Args>
+    reference emplace_back(Args&&... args);
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+    void pop_back() {
+        --sz_;
+        std::allocator_traits<Allocator>::destroy(allocator, &(*this)[sz_]);
+    }
+
+    // Destroys every element; the segments are kept for reuse.
+    void clear() noexcept {
+        destroyFrom(0);
+        sz_ = 0;
+    }
+    void swap(segmented_vector& other) noexcept(
+        std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value);
+
+private:
+    using SegmentAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T*>;
+
+    static constexpr size_type segmentBits = size_type(std::countr_zero(SegmentSize));
+    static constexpr size_type segmentMask = SegmentSize - 1;
+
+    vector<T*, SegmentAllocator> segments_;
+    size_type sz_ = 0;
+    [[no_unique_address]] Allocator allocator;
+
+    // Appends one more segment to the directory.
+    void addSegment();
+    // Frees the segments from index first on.
+    void releaseSegments(size_type first) noexcept;
+    // Destroys the elements from index first on, without changing sz_.
+    void destroyFrom(size_type first) noexcept;
+
+    // Constructs count elements after the last one, segment piece by segment piece, with
+    // construct(destination, n), which must construct all n or none. Elements of earlier pieces
+    // are destroyed if a later piece throws.
+    template <class Construct>
+    void appendPieces(size_type count, Construct construct);
+
+    template <class InputIterator>
+    void append(InputIterator first, InputIterator last);
+
+    // Runs a constructor body, cleaning up on failure since the destructor won't run.
+    template <class Body>
+    void guarded(Body body) {
+        try {
+            body();
+        } catch (...) {
+            clear();
+            releaseSegments(0);
+            throw;
+        }
+    }
+};
+
+template <class T, class Allocator, std::size_t SegmentSize>
+template <bool Const>
+class segmented_vector<T, Allocator, SegmentSize>::Iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    Iterator() = default;
+    Iterator(T* const* segments, size_type index) : segments_(segments), index_(index) {
+    }
+    // iterator converts to const_iterator.
+    template <bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    Iterator(const Iterator<OtherConst>& other) : segments_(other.segments_), index_(other.index_) {
+    }
+
+    reference operator*() const {
+        return segments_[index_ >> segmentBits][index_ & segmentMask];
+    }
+    pointer operator->() const {
+        return &**this;
+    }
+    reference operator[](difference_type n) const {
+        return *(*this + n);
+    }
+
+    Iterator& operator++() {
+        ++index_;
+        return *this;
+    }
+    Iterator operator++(int) {
+        Iterator old = *this;
+        ++index_;
+        return old;
+    }
+    Iterator& operator--() {
+        --index_;
+        return *this;
+    }
+    Iterator operator--(int) {
+        Iterator old = *this;
+        --index_;
+        return old;
+    }
+    Iterator& operator+=(difference_type n) {
+        index_ = size_type(difference_type(index_) + n);
+        return *this;
+    }
+    Iterator& operator-=(difference_type n) {
+        index_ = size_type(difference_type(index_) - n);
+        return *this;
+    }
+    Iterator operator+(difference_type n) const {
+        return Iterator(segments_, size_type(difference_type(index_) + n));
+    }
+    friend Iterator operator+(difference_type n, const Iterator& it) {
+        return it + n;
+    }
+    Iterator operator-(difference_type n) const {
+        return Iterator(segments_, size_type(difference_type(index_) - n));
+    }
+    difference_type operator-(const Iterator& it) const {
+        return difference_type(index_) - difference_type(it.index_);
+    }
+
+    bool operator==(const Iterator& rhs) const {
+        return index_ == rhs.index_;
+    }
+    auto operator<=>(const Iterator& rhs) const {
+        return index_ <=> rhs.index_;
+    }
+
+private:
+    template <bool>
+    friend class Iterator;
+
+    // The directory's address: growth that reallocates the directory invalidates iterators,
+    // though never references to elements.
+    T* const* segments_ = nullptr;
+    size_type index_ = 0;
+};
+
+template <class T, class Allocator, std::size_t SegmentSize>
+segmented_vector<T, Allocator, SegmentSize>& segmented_vector<T, Allocator, SegmentSize>::operator=(
+    const segmented_vector& copyVector) {
+    if (this == &copyVector) {
+        return *this;
+    }
+
+    clear();
+    if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+        if (allocator != copyVector.allocator) {
+            releaseSegments(0);
+        }
+        allocator = copyVector.allocator;
+    }
+    append(copyVector.begin(), copyVector.end());
+
+    return *this;
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+segmented_vector<T, Allocator, SegmentSize>&
+segmented_vector<T, Allocator, SegmentSize>::operator=(segmented_vector&& moveVector) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    if (this == &moveVector) {
+        return *this;
+    }
+
+    clear();
+    if (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value ||
+        allocator == moveVector.allocator) {
+        releaseSegments(0);
+        if constexpr (std::allocator_traits<
+                          Allocator>::propagate_on_container_move_assignment::value) {
+            allocator = std::move(moveVector.allocator);
+        }
+        segments_ = std::move(moveVector.segments_);
+        sz_ = moveVector.sz_;
+        moveVector.sz_ = 0;
+    } else {
+        // Segments can't change allocators, so the elements are moved one by one.
+        append(std::make_move_iterator(moveVector.begin()),
+               std::make_move_iterator(moveVector.end()));
+        moveVector.clear();
+    }
+
+    return *this;
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+void segmented_vector<T, Allocator, SegmentSize>::resize(size_type count) {
+    if (count <= sz_) {
+        destroyFrom(count);
+        sz_ = count;
+    } else {
+        appendPieces(count - sz_, [&](T* destination, size_type n) {
+            detail::uninitializedFill(allocator, destination, n);
+        });
+    }
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+void segmented_vector<T, Allocator, SegmentSize>::resize(size_type count, const T& value) {
+    if (count <= sz_) {
+        destroyFrom(count);
+        sz_ = count;
+    } else {
+        // Elements never move, so value stays valid even if it is one of them.
+        appendPieces(count - sz_, [&](T* destination, size_type n) {
+            detail::uninitializedFill(allocator, destination, n, value);
+        });
+    }
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+void segmented_vector<T, Allocator, SegmentSize>::reserve(size_type count) {
+    if (count > max_size()) {
+        throw std::length_error("Count is more than max_size!");
+    }
+
+    segments_.reserve((count + segmentMask) >> segmentBits);
+    while (capacity() < count) {
+        addSegment();
+    }
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+void segmented_vector<T, Allocator, SegmentSize>::shrink_to_fit() {
+    releaseSegments(segment_count());
+    segments_.shrink_to_fit();
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+template <class... Args>
+typename segmented_vector<T, Allocator, SegmentSize>::reference
+segmented_vector<T, Allocator, SegmentSize>::emplace_back(Args&&... args) {
+    if (sz_ == capacity()) {
+        addSegment();
+    }
+
+    T* const slot = segments_[sz_ >> segmentBits] + (sz_ & segmentMask);
+    std::allocator_traits<Allocator>::construct(allocator, slot, std::forward<Args>(args)...);
+    ++sz_;
+
+    return *slot;
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+void segmented_vector<T, Allocator, SegmentSize>::swap(segmented_vector& other) noexcept(
+    std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+    std::allocator_traits<Allocator>::is_always_equal::value) {
+    segments_.swap(other.segments_);
+    std::swap(sz_, other.sz_);
+
+    if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator, other.allocator);
+    }
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+void segmented_vector<T, Allocator, SegmentSize>::addSegment() {
+    if (capacity() > max_size() - SegmentSize) {
+        throw std::length_error("Count is more than max_size!");
+    }
+
+    T* const segment = std::allocator_traits<Allocator>::allocate(allocator, SegmentSize);
+
+    try {
+        segments_.push_back(segment);
+    } catch (...) {
+        std::allocator_traits<Allocator>::deallocate(allocator, segment, SegmentSize);
+        throw;
+    }
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+void segmented_vector<T, Allocator, SegmentSize>::releaseSegments(size_type first) noexcept {
+    while (segments_.size() > first) {
+        std::allocator_traits<Allocator>::deallocate(allocator, segments_.back(), SegmentSize);
+        segments_.pop_back();
+    }
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+void segmented_vector<T, Allocator, SegmentSize>::destroyFrom(size_type first) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T> ||
+                  detail::has_custom_destroy<Allocator, T>::value) {
+        while (first < sz_) {
+            T* const from = segments_[first >> segmentBits] + (first & segmentMask);
+            const size_type n = std::min(sz_ - first, SegmentSize - (first & segmentMask));
+
+            detail::destroyRange(allocator, from, from + n);
+            first += n;
+        }
+    }
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+template <class Construct>
+void segmented_vector<T, Allocator, SegmentSize>::appendPieces(size_type count,
+                                                               Construct construct) {
+    const size_type first = sz_;
+
+    if (count > max_size() - first) {
+        throw std::length_error("Count is more than max_size!");
+    }
+    reserve(first + count);
+
+    try {
+        while (sz_ < first + count) {
+            const size_type n = std::min(first + count - sz_, SegmentSize - (sz_ & segmentMask));
+
+            construct(segments_[sz_ >> segmentBits] + (sz_ & segmentMask), n);
+            sz_ += n;
+        }
+    } catch (...) {
+        destroyFrom(first);
+        sz_ = first;
+        throw;
+    }
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+template <class InputIterator>
+void segmented_vector<T, Allocator, SegmentSize>::append(InputIterator first, InputIterator last) {
+    if constexpr (std::is_base_of_v<
+                      std::forward_iterator_tag,
+                      typename std::iterator_traits<InputIterator>::iterator_category>) {
+        appendPieces(size_type(std::distance(first, last)), [&](T* destination, size_type n) {
+            detail::uninitializedCopyN(allocator, first, n, destination);
+            std::advance(first, n);
+        });
+    } else {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+bool operator==(const segmented_vector<T, Allocator, SegmentSize>& lhs,
+                const segmented_vector<T, Allocator, SegmentSize>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+
+    for (std::size_t k = 0; k < lhs.segment_count(); ++k) {
+        const std::size_t begin = k * SegmentSize;
+        const std::size_t n = std::min(SegmentSize, lhs.size() - begin);
+
+        if (!detail::equalRanges(lhs.segment(k), rhs.segment(k), n)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+auto operator<=>(const segmented_vector<T, Allocator, SegmentSize>& lhs,
+                 const segmented_vector<T, Allocator, SegmentSize>& rhs) {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                                                  detail::synthThreeWay{});
+}
+
+template <class T, class Allocator, std::size_t SegmentSize>
+void swap(segmented_vector<T, Allocator, SegmentSize>& lhs,
+          segmented_vector<T, Allocator, SegmentSize>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+}  // namespace coolstd
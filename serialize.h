@@ -0,0 +1,343 @@
+#pragma once
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include "vector.h"
+
+namespace coolstd {
+
+// Binary format of a serialized vector: this header, zero padding up to payload_offset, then
+// count * element_size bytes of elements as they are in memory. payload_offset is a multiple of
+// 64 and of the element alignment, so a buffer mapped at a page boundary can be viewed in place
+// (vector_view). The header itself is written in the writer's byte order, which `endianness`
+// records; readers reject a foreign order for everything but arithmetic elements, which they
+// byte-swap. Readers also reject a payload_offset past max_payload_offset (or the element
+// alignment, if that is larger), so a corrupt header can't make them skip gigabytes of padding.
+struct serialized_header {
+    static constexpr std::array<char, 4> expected_magic{'C', 'V', 'E', 'C'};
+    static constexpr std::uint16_t current_version = 1;
+    static constexpr std::uint64_t max_payload_offset = 4096;
+
+    std::array<char, 4> magic = expected_magic;
+    std::uint16_t version = current_version;
+    std::uint8_t endianness = std::endian::native == std::endian::little ? 1 : 2;
+    std::uint8_t reserved = 0;
+    std::uint32_t element_size = 0;
+    std::uint32_t alignment = 0;
+    std::uint64_t count = 0;
+    std::uint64_t payload_offset = 0;
+};
+static_assert(sizeof(serialized_header) == 32);
+
+// Thrown when a header is malformed or describes elements other than the reader's T.
+class serialization_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+
+template <class T>
+serialized_header headerFor(std::size_t count) {
+    serialized_header header;
+    header.element_size = std::uint32_t(sizeof(T));
+    header.alignment = std::uint32_t(alignof(T));
+    header.count = count;
+    header.payload_offset = std::max<std::uint64_t>(64, alignof(T));
+
+    return header;
+}
+
+template <class U>
+U byteSwap(U value) noexcept {
+    auto bytes = std::bit_cast<std::array<unsigned char, sizeof(U)>>(value);
+    std::reverse(bytes.begin(), bytes.end());
+
+    return std::bit_cast<U>(bytes);
+}
+
+inline void swapHeader(serialized_header& header) noexcept {
+    header.version = byteSwap(header.version);
+    header.element_size = byteSwap(header.element_size);
+    header.alignment = byteSwap(header.alignment);
+    header.count = byteSwap(header.count);
+    header.payload_offset = byteSwap(header.payload_offset);
+}
+
+// Checks a header read from a file against T, converting it to native byte order. Returns
+// whether the payload needs byte-swapping.
+template <class T>
+bool checkHeader(serialized_header& header) {
+    if (header.magic != serialized_header::expected_magic) {
+        throw serialization_error("not a serialized coolstd::vector");
+    }
+
+    const serialized_header native = headerFor<T>(0);
+    const bool foreign = header.endianness != native.endianness;
+    if (foreign) {
+        swapHeader(header);
+        if constexpr (!std::is_arithmetic_v<T>) {
+            throw serialization_error("elements were written with the other byte order");
+        }
+    }
+
+    if (header.version != serialized_header::current_version) {
+        throw serialization_error("unsupported serialized vector version");
+    }
+    if (header.element_size != sizeof(T) || header.alignment != alignof(T)) {
+        throw serialization_error("serialized elements have a different size or alignment");
+    }
+    if (header.payload_offset < sizeof(serialized_header) ||
+        header.payload_offset >
+            std::max<std::uint64_t>(serialized_header::max_payload_offset, alignof(T)) ||
+        header.payload_offset % alignof(T) != 0 ||
+        header.count > std::numeric_limits<std::uint64_t>::max() / sizeof(T)) {
+        throw serialization_error("corrupt serialized vector header");
+    }
+
+    return foreign && sizeof(T) > 1;
+}
+
+template <class T>
+void byteSwapAll(T* data, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        data[i] = byteSwap(data[i]);
+    }
+}
+
+// write() and read() until done, retrying after partial transfers and EINTR.
+inline void writeAll(int fd, iovec* parts, int partCount) {
+    while (partCount > 0) {
+        const ssize_t written = ::writev(fd, parts, std::min(partCount, IOV_MAX));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "writev");
+        }
+
+        std::size_t done = std::size_t(written);
+        while (partCount > 0 && done >= parts->iov_len) {
+            done -= parts->iov_len;
+            ++parts;
+            --partCount;
+        }
+        if (partCount > 0) {
+            parts->iov_base = static_cast<char*>(parts->iov_base) + done;
+            parts->iov_len -= done;
+        }
+    }
+}
+
+inline void readAll(int fd, void* destination, std::size_t bytes) {
+    char* out = static_cast<char*>(destination);
+
+    while (bytes > 0) {
+        const ssize_t got = ::read(fd, out, bytes);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (got == 0) {
+            throw serialization_error("serialized vector is truncated");
+        }
+
+        out += got;
+        bytes -= std::size_t(got);
+    }
+}
+
+}  // namespace detail
+
+// Writes vec to a file descriptor: header, padding and elements in a single writev() (more
+// only if the kernel writes part of it). Throws std::system_error if writing fails.
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+void write_to(int fd, const vector<T, Allocator, GrowthPolicy, Instrumentation>& vec) {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements are bytes");
+
+    serialized_header header = detail::headerFor<T>(vec.size());
+    const vector<char> padding(std::size_t(header.payload_offset) - sizeof(header));
+    iovec parts[3] = {
+        {&header, sizeof(header)},
+        {const_cast<char*>(padding.data()), padding.size()},
+        {const_cast<T*>(vec.data()), vec.size() * sizeof(T)},
+    };
+
+    detail::writeAll(fd, parts, 3);
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+void write_to(std::ostream& out, const vector<T, Allocator, GrowthPolicy, Instrumentation>& vec) {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements are bytes");
+
+    const serialized_header header = detail::headerFor<T>(vec.size());
+    const vector<char> padding(std::size_t(header.payload_offset) - sizeof(header));
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(padding.data(), std::streamsize(padding.size()));
+    out.write(reinterpret_cast<const char*>(vec.data()), std::streamsize(vec.size() * sizeof(T)));
+}
+
+// Replaces the contents of vec with a vector written by write_to: the elements are read straight
+// into its buffer with one read() (more only for partial reads). Throws serialization_error if
+// the data doesn't describe T elements or holds more than vec.max_size() of them; vec is then
+// unchanged. If allocating or reading fails part-way, vec is left empty.
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+void read_from(int fd, vector<T, Allocator, GrowthPolicy, Instrumentation>& vec) {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements are bytes");
+
+    serialized_header header;
+    detail::readAll(fd, &header, sizeof(header));
+    const bool swap = detail::checkHeader<T>(header);
+
+    vector<char> padding(std::size_t(header.payload_offset) - sizeof(header));
+    detail::readAll(fd, padding.data(), padding.size());
+
+    if (header.count > vec.max_size()) {
+        throw serialization_error("serialized vector is larger than max_size()");
+    }
+
+    vec.clear();
+    vec.resize_for_overwrite(std::size_t(header.count));
+    try {
+        detail::readAll(fd, vec.data(), vec.size() * sizeof(T));
+    } catch (...) {
+        vec.clear();
+        throw;
+    }
+
+    if constexpr (std::is_arithmetic_v<T>) {
+        if (swap) {
+            detail::byteSwapAll(vec.data(), vec.size());
+        }
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+void read_from(std::istream& in, vector<T, Allocator, GrowthPolicy, Instrumentation>& vec) {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements are bytes");
+
+    serialized_header header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw serialization_error("serialized vector is truncated");
+    }
+    const bool swap = detail::checkHeader<T>(header);
+
+    if (!in.ignore(std::streamsize(header.payload_offset - sizeof(header)))) {
+        throw serialization_error("serialized vector is truncated");
+    }
+
+    if (header.count > vec.max_size()) {
+        throw serialization_error("serialized vector is larger than max_size()");
+    }
+
+    vec.clear();
+    vec.resize_for_overwrite(std::size_t(header.count));
+    if (!in.read(reinterpret_cast<char*>(vec.data()), std::streamsize(vec.size() * sizeof(T)))) {
+        vec.clear();
+        throw serialization_error("serialized vector is truncated");
+    }
+
+    if constexpr (std::is_arithmetic_v<T>) {
+        if (swap) {
+            detail::byteSwapAll(vec.data(), vec.size());
+        }
+    }
+}
+
+// Read-only view of a vector serialized by write_to in a buffer that is already in memory,
+// typically a mapped_file: the elements are used where they are, nothing is copied. The
+// buffer must outlive the view, be in native byte order, and place the payload at an address
+// aligned for T, which holds when the buffer itself is 64-byte aligned.
+template <class T>
+class vector_view {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements are bytes");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using const_reference = const T&;
+    using const_pointer = const T*;
+    using const_iterator = const T*;
+
+    vector_view() = default;
+
+    // Validates the header at buffer and views the elements after it. Throws
+    // serialization_error if the header doesn't describe T elements or the buffer is short.
+    vector_view(const void* buffer, std::size_t bytes) {
+        serialized_header header;
+        if (bytes < sizeof(header)) {
+            throw serialization_error("serialized vector is truncated");
+        }
+        std::memcpy(&header, buffer, sizeof(header));
+
+        if (detail::checkHeader<T>(header)) {
+            throw serialization_error("elements were written with the other byte order");
+        }
+        if (header.payload_offset > bytes ||
+            header.count > (bytes - header.payload_offset) / sizeof(T)) {
+            throw serialization_error("serialized vector is truncated");
+        }
+
+        const auto* payload = static_cast<const std::byte*>(buffer) + header.payload_offset;
+        if (reinterpret_cast<std::uintptr_t>(payload) % alignof(T) != 0) {
+            throw serialization_error("serialized elements are misaligned in this buffer");
+        }
+
+        data_ = reinterpret_cast<const T*>(payload);
+        sz_ = std::size_t(header.count);
+    }
+
+    const T* data() const noexcept {
+        return data_;
+    }
+    size_type size() const noexcept {
+        return sz_;
+    }
+    bool empty() const noexcept {
+        return sz_ == 0;
+    }
+    const_iterator begin() const noexcept {
+        return data_;
+    }
+    const_iterator end() const noexcept {
+        return data_ + sz_;
+    }
+    const T& operator[](size_type n) const noexcept {
+        return data_[n];
+    }
+    const T& front() const noexcept {
+        return data_[0];
+    }
+    const T& back() const noexcept {
+        return data_[sz_ - 1];
+    }
+    std::span<const T> span() const noexcept {
+        return {data_, sz_};
+    }
+
+private:
+    const T* data_ = nullptr;
+    size_type sz_ = 0;
+};
+
+}  // namespace coolstd
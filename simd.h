@@ -0,0 +1,487 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define COOLSTD_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define COOLSTD_SIMD_X86 0
+#endif
+
+namespace coolstd::simd {
+
+// Fill and compare kernels for arithmetic element types. Each kernel exists as portable scalar
+// code and, on x86 with GCC or Clang, as SSE2, AVX2 and AVX-512 versions compiled with target
+// attributes, so the header needs no special compiler flags. The widest level the CPU supports
+// is picked on first use; select() overrides it for tests and benchmarks.
+//
+// Copies have no kernels of their own: contiguous trivially copyable ranges already go through
+// memcpy/memmove, which the C library dispatches the same way and which beat hand-written loops
+// at every size measured (including non-temporal stores for large blocks).
+enum class isa { scalar, sse2, avx2, avx512 };
+
+// 1-, 2-, 4- and 8-byte arithmetic types: integers, characters, bool, float and double.
+template <class T>
+inline constexpr bool is_element_v =
+    std::is_arithmetic_v<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+                                sizeof(T) == 8);
+
+inline const char* name(isa level) noexcept {
+    switch (level) {
+        case isa::sse2:
+            return "sse2";
+        case isa::avx2:
+            return "avx2";
+        case isa::avx512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
+
+namespace detail {
+
+// fill() works on the value replicated into 8 bytes. Destinations are aligned to the element
+// size, so every store that starts at a multiple of 8 (or at the overlapping tail, a multiple of
+// the element size from the end) lines up with element boundaries.
+inline std::uint64_t replicate(const void* value, std::size_t size) noexcept {
+    std::uint64_t pattern = 0;
+
+    for (std::size_t offset = 0; offset < 8; offset += size) {
+        std::memcpy(reinterpret_cast<unsigned char*>(&pattern) + offset, value, size);
+    }
+
+    return pattern;
+}
+
+inline void fillScalar(void* destination, std::uint64_t pattern, std::size_t bytes) noexcept {
+    unsigned char* out = static_cast<unsigned char*>(destination);
+    std::size_t i = 0;
+
+    for (; i + 8 <= bytes; i += 8) {
+        std::memcpy(out + i, &pattern, 8);
+    }
+    std::memcpy(out + i, &pattern, bytes - i);
+}
+
+inline std::size_t mismatchBytesScalar(const void* lhs, const void* rhs,
+                                       std::size_t bytes) noexcept {
+    const unsigned char* a = static_cast<const unsigned char*>(lhs);
+    const unsigned char* b = static_cast<const unsigned char*>(rhs);
+    std::size_t i = 0;
+
+    for (; i + 8 <= bytes; i += 8) {
+        std::uint64_t x;
+        std::uint64_t y;
+        std::memcpy(&x, a + i, 8);
+        std::memcpy(&y, b + i, 8);
+        if (x != y) {
+            break;
+        }
+    }
+    for (; i < bytes && a[i] == b[i]; ++i) {
+    }
+
+    return i;
+}
+
+template <class F>
+std::size_t mismatchFloatingScalar(const F* a, const F* b, std::size_t count) noexcept {
+    std::size_t i = 0;
+
+    for (; i < count && a[i] == b[i]; ++i) {
+    }
+
+    return i;
+}
+
+#if COOLSTD_SIMD_X86
+
+// The x86 kernels share one shape: an unaligned head, an aligned (fill) or unrolled (compare)
+// main loop, and an overlapping or masked tail, so there is no scalar remainder loop.
+
+// First address past ptr that is a multiple of alignment.
+inline char* nextAligned(char* ptr, std::uintptr_t alignment) noexcept {
+    return reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(ptr) + alignment) &
+                                   ~(alignment - 1));
+}
+
+// Mask selecting the low `count` bits, count <= 64.
+inline std::uint64_t lowBits(std::size_t count) noexcept {
+    return count == 0 ? 0 : ~std::uint64_t(0) >> (64 - count);
+}
+
+__attribute__((target("sse2"))) inline void fillSse2(void* destination, std::uint64_t pattern,
+                                                      std::size_t bytes) noexcept {
+    char* out = static_cast<char*>(destination);
+
+    if (bytes < 16) {
+        return fillScalar(out, pattern, bytes);
+    }
+
+    const __m128i value = _mm_set1_epi64x(std::int64_t(pattern));
+    char* const end = out + bytes;
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), value);
+    out = nextAligned(out, 16);
+    for (; out + 64 <= end; out += 64) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(out), value);
+        _mm_store_si128(reinterpret_cast<__m128i*>(out + 16), value);
+        _mm_store_si128(reinterpret_cast<__m128i*>(out + 32), value);
+        _mm_store_si128(reinterpret_cast<__m128i*>(out + 48), value);
+    }
+    for (; out + 16 <= end; out += 16) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(out), value);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(end - 16), value);
+}
+
+__attribute__((target("avx2"))) inline void fillAvx2(void* destination, std::uint64_t pattern,
+                                                      std::size_t bytes) noexcept {
+    char* out = static_cast<char*>(destination);
+
+    if (bytes < 32) {
+        return fillSse2(out, pattern, bytes);
+    }
+
+    const __m256i value = _mm256_set1_epi64x(std::int64_t(pattern));
+    char* const end = out + bytes;
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), value);
+    out = nextAligned(out, 32);
+    for (; out + 128 <= end; out += 128) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out), value);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out + 32), value);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out + 64), value);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out + 96), value);
+    }
+    for (; out + 32 <= end; out += 32) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out), value);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(end - 32), value);
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline void fillAvx512(void* destination,
+                                                                   std::uint64_t pattern,
+                                                                   std::size_t bytes) noexcept {
+    char* out = static_cast<char*>(destination);
+    const __m512i value = _mm512_set1_epi64(std::int64_t(pattern));
+
+    if (bytes < 64) {
+        _mm512_mask_storeu_epi8(out, lowBits(bytes), value);
+        return;
+    }
+
+    char* const end = out + bytes;
+
+    _mm512_storeu_si512(out, value);
+    out = nextAligned(out, 64);
+    for (; out + 256 <= end; out += 256) {
+        _mm512_store_si512(out, value);
+        _mm512_store_si512(out + 64, value);
+        _mm512_store_si512(out + 128, value);
+        _mm512_store_si512(out + 192, value);
+    }
+    for (; out + 64 <= end; out += 64) {
+        _mm512_store_si512(out, value);
+    }
+    _mm512_storeu_si512(end - 64, value);
+}
+
+// Lambdas don't inherit target attributes, so the compare kernels spell their loads out.
+
+__attribute__((target("sse2"))) inline unsigned differingBytesSse2(const char* a,
+                                                                   const char* b) noexcept {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+    const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+
+    return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) ^ 0xFFFFu;
+}
+
+__attribute__((target("sse2"))) inline std::size_t mismatchBytesSse2(const void* lhs,
+                                                                     const void* rhs,
+                                                                     std::size_t bytes) noexcept {
+    const char* a = static_cast<const char*>(lhs);
+    const char* b = static_cast<const char*>(rhs);
+
+    if (bytes < 16) {
+        return mismatchBytesScalar(a, b, bytes);
+    }
+
+    for (std::size_t i = 0; i + 16 <= bytes; i += 16) {
+        if (const unsigned mask = differingBytesSse2(a + i, b + i)) {
+            return i + unsigned(__builtin_ctz(mask));
+        }
+    }
+    if (const unsigned mask = differingBytesSse2(a + bytes - 16, b + bytes - 16)) {
+        return bytes - 16 + unsigned(__builtin_ctz(mask));
+    }
+
+    return bytes;
+}
+
+__attribute__((target("avx2"))) inline std::uint32_t differingBytesAvx2(const char* a,
+                                                                        const char* b) noexcept {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+    const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+
+    return ~std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+}
+
+__attribute__((target("avx2"))) inline std::size_t mismatchBytesAvx2(const void* lhs,
+                                                                     const void* rhs,
+                                                                     std::size_t bytes) noexcept {
+    const char* a = static_cast<const char*>(lhs);
+    const char* b = static_cast<const char*>(rhs);
+
+    if (bytes < 32) {
+        return mismatchBytesSse2(a, b, bytes);
+    }
+
+    std::size_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        const std::uint32_t first = differingBytesAvx2(a + i, b + i);
+        const std::uint32_t second = differingBytesAvx2(a + i + 32, b + i + 32);
+
+        if ((first | second) != 0) {
+            return first != 0 ? i + unsigned(__builtin_ctz(first))
+                              : i + 32 + unsigned(__builtin_ctz(second));
+        }
+    }
+    for (; i + 32 <= bytes; i += 32) {
+        if (const std::uint32_t mask = differingBytesAvx2(a + i, b + i)) {
+            return i + unsigned(__builtin_ctz(mask));
+        }
+    }
+    if (i < bytes) {
+        if (const std::uint32_t mask = differingBytesAvx2(a + bytes - 32, b + bytes - 32)) {
+            return bytes - 32 + unsigned(__builtin_ctz(mask));
+        }
+    }
+
+    return bytes;
+}
+
+__attribute__((target("avx512f,avx512bw"))) inline std::size_t mismatchBytesAvx512(
+    const void* lhs, const void* rhs, std::size_t bytes) noexcept {
+    const char* a = static_cast<const char*>(lhs);
+    const char* b = static_cast<const char*>(rhs);
+    std::size_t i = 0;
+
+    for (; i + 64 <= bytes; i += 64) {
+        const __mmask64 mask =
+            _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        if (mask != 0) {
+            return i + std::size_t(__builtin_ctzll(mask));
+        }
+    }
+    if (i < bytes) {
+        const __mmask64 tail = lowBits(bytes - i);
+        const __mmask64 mask = _mm512_cmpneq_epi8_mask(_mm512_maskz_loadu_epi8(tail, a + i),
+                                                       _mm512_maskz_loadu_epi8(tail, b + i));
+        if (mask != 0) {
+            return i + std::size_t(__builtin_ctzll(mask));
+        }
+    }
+
+    return bytes;
+}
+
+// Floating-point kernels compare as ==, not bitwise: -0.0 matches 0.0 and NaN matches nothing.
+
+__attribute__((target("sse2"))) inline std::size_t mismatchFloatSse2(const float* a,
+                                                                     const float* b,
+                                                                     std::size_t count) noexcept {
+    std::size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const unsigned mask =
+            unsigned(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i))));
+        if (mask != 0xFu) {
+            return i + unsigned(__builtin_ctz(~mask));
+        }
+    }
+
+    return i + mismatchFloatingScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("sse2"))) inline std::size_t mismatchDoubleSse2(const double* a,
+                                                                      const double* b,
+                                                                      std::size_t count) noexcept {
+    std::size_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        const unsigned mask =
+            unsigned(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i))));
+        if (mask != 0x3u) {
+            return i + unsigned(__builtin_ctz(~mask));
+        }
+    }
+
+    return i + mismatchFloatingScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2"))) inline std::size_t mismatchFloatAvx2(const float* a,
+                                                                     const float* b,
+                                                                     std::size_t count) noexcept {
+    std::size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const __m256 eq =
+            _mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _CMP_EQ_OQ);
+        const unsigned mask = unsigned(_mm256_movemask_ps(eq));
+        if (mask != 0xFFu) {
+            return i + unsigned(__builtin_ctz(~mask));
+        }
+    }
+
+    return i + mismatchFloatSse2(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2"))) inline std::size_t mismatchDoubleAvx2(const double* a,
+                                                                      const double* b,
+                                                                      std::size_t count) noexcept {
+    std::size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const __m256d eq =
+            _mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_EQ_OQ);
+        const unsigned mask = unsigned(_mm256_movemask_pd(eq));
+        if (mask != 0xFu) {
+            return i + unsigned(__builtin_ctz(~mask));
+        }
+    }
+
+    return i + mismatchDoubleSse2(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx512f"))) inline std::size_t mismatchFloatAvx512(
+    const float* a, const float* b, std::size_t count) noexcept {
+    std::size_t i = 0;
+
+    for (; i < count; i += 16) {
+        const __mmask16 tail = __mmask16(lowBits(std::min<std::size_t>(count - i, 16)));
+        const __mmask16 mask = _mm512_mask_cmp_ps_mask(tail, _mm512_maskz_loadu_ps(tail, a + i),
+                                                       _mm512_maskz_loadu_ps(tail, b + i),
+                                                       _CMP_NEQ_UQ);
+        if (mask != 0) {
+            return i + unsigned(__builtin_ctz(mask));
+        }
+    }
+
+    return count;
+}
+
+__attribute__((target("avx512f"))) inline std::size_t mismatchDoubleAvx512(
+    const double* a, const double* b, std::size_t count) noexcept {
+    std::size_t i = 0;
+
+    for (; i < count; i += 8) {
+        const __mmask8 tail = __mmask8(lowBits(std::min<std::size_t>(count - i, 8)));
+        const __mmask8 mask = _mm512_mask_cmp_pd_mask(tail, _mm512_maskz_loadu_pd(tail, a + i),
+                                                      _mm512_maskz_loadu_pd(tail, b + i),
+                                                      _CMP_NEQ_UQ);
+        if (mask != 0) {
+            return i + unsigned(__builtin_ctz(mask));
+        }
+    }
+
+    return count;
+}
+
+#endif
+
+struct kernels {
+    isa level;
+    void (*fill)(void*, std::uint64_t, std::size_t) noexcept;
+    std::size_t (*mismatchBytes)(const void*, const void*, std::size_t) noexcept;
+    std::size_t (*mismatchFloat)(const float*, const float*, std::size_t) noexcept;
+    std::size_t (*mismatchDouble)(const double*, const double*, std::size_t) noexcept;
+};
+
+inline constexpr kernels scalarKernels{isa::scalar, fillScalar, mismatchBytesScalar,
+                                       mismatchFloatingScalar<float>,
+                                       mismatchFloatingScalar<double>};
+#if COOLSTD_SIMD_X86
+inline constexpr kernels sse2Kernels{isa::sse2, fillSse2, mismatchBytesSse2, mismatchFloatSse2,
+                                     mismatchDoubleSse2};
+inline constexpr kernels avx2Kernels{isa::avx2, fillAvx2, mismatchBytesAvx2, mismatchFloatAvx2,
+                                     mismatchDoubleAvx2};
+inline constexpr kernels avx512Kernels{isa::avx512, fillAvx512, mismatchBytesAvx512,
+                                       mismatchFloatAvx512, mismatchDoubleAvx512};
+#endif
+
+inline const kernels* kernelsFor(isa level) noexcept {
+#if COOLSTD_SIMD_X86
+    __builtin_cpu_init();
+
+    if (level >= isa::avx512 && __builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512bw")) {
+        return &avx512Kernels;
+    }
+    if (level >= isa::avx2 && __builtin_cpu_supports("avx2")) {
+        return &avx2Kernels;
+    }
+    if (level >= isa::sse2 && __builtin_cpu_supports("sse2")) {
+        return &sse2Kernels;
+    }
+#else
+    (void)level;
+#endif
+    return &scalarKernels;
+}
+
+inline const kernels*& active() noexcept {
+    static const kernels* current = kernelsFor(isa::avx512);
+    return current;
+}
+
+}  // namespace detail
+
+// The level the kernels currently run at.
+inline isa level() noexcept {
+    return detail::active()->level;
+}
+
+// Uses the widest level up to `limit` that the CPU supports and returns it. Not thread-safe:
+// call it before other threads use the kernels.
+inline isa select(isa limit) noexcept {
+    detail::active() = detail::kernelsFor(limit);
+    return level();
+}
+
+// Stores count copies of value at destination.
+template <class T>
+void fill(T* destination, std::size_t count, const T& value) noexcept {
+    static_assert(is_element_v<T>);
+
+    if (count * sizeof(T) < 32) {
+        for (std::size_t i = 0; i < count; ++i) {
+            destination[i] = value;
+        }
+    } else {
+        detail::active()->fill(destination, detail::replicate(&value, sizeof(T)),
+                               count * sizeof(T));
+    }
+}
+
+// Index of the first i where !(lhs[i] == rhs[i]), or count.
+template <class T>
+std::size_t mismatch(const T* lhs, const T* rhs, std::size_t count) noexcept {
+    static_assert(is_element_v<T>);
+
+    if constexpr (std::is_same_v<T, float>) {
+        return detail::active()->mismatchFloat(lhs, rhs, count);
+    } else if constexpr (std::is_same_v<T, double>) {
+        return detail::active()->mismatchDouble(lhs, rhs, count);
+    } else {
+        return detail::active()->mismatchBytes(lhs, rhs, count * sizeof(T)) / sizeof(T);
+    }
+}
+
+}  // namespace coolstd::simd
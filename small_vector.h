@@ -0,0 +1,772 @@
+#pragma once
+
+#include "vector.h"
+
+namespace coolstd {
+// A vector that keeps up to N elements in an inline buffer and only calls the allocator once it
+// outgrows it. It has coolstd::vector's interface and iterator types, and spills to the heap
+// through the same GrowthPolicy and relocation helpers, so once on the heap it behaves exactly
+// like a vector. Moving a small_vector whose elements are inline moves them one by one. With
+// COOLSTD_CHECKS, element access and positions are checked as in vector, but its iterators are
+// made from bare pointers and so are not.
+template <class T, std::size_t N, class Allocator = std::allocator<T>,
+          class GrowthPolicy = growth::doubling>
+class small_vector {
+    static_assert(N > 0, "use coolstd::vector when no inline capacity is wanted");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = std::allocator_traits<Allocator>::pointer;
+    using const_pointer = std::allocator_traits<Allocator>::const_pointer;
+    using iterator = typename vector<T, Allocator, GrowthPolicy>::iterator;
+    using const_iterator = typename vector<T, Allocator, GrowthPolicy>::const_iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr size_type inline_capacity = N;
+
+    // construct/copy/destroy
+    small_vector() noexcept(noexcept(Allocator())) : small_vector(Allocator()) {
+    }
+    explicit small_vector(const Allocator& alloc) noexcept
+        : sz_(0), cap_(N), data_(inlineData()), allocator(alloc) {
+    }
+
+    explicit small_vector(size_type count, const Allocator& alloc = Allocator())
+        : small_vector(alloc) {
+        resize(count);
+    }
+    small_vector(size_type count, const T& value, const Allocator& alloc = Allocator())
+        : small_vector(alloc) {
+        insert(end(), count, value);
+    }
+
+    template <class InputIterator>
+    small_vector(
+        InputIterator first, InputIterator last, const Allocator& alloc = Allocator(),
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr)
+        : small_vector(alloc) {
+        insert(end(), first, last);
+    }
+    small_vector(const small_vector& copyVector)
+        : small_vector(std::allocator_traits<Allocator>::select_on_container_copy_construction(
+              copyVector.allocator)) {
+        insert(end(), copyVector.begin(), copyVector.end());
+    }
+    small_vector(small_vector&& moveVector) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : sz_(0), cap_(N), data_(inlineData()), allocator(std::move(moveVector.allocator)) {
+        takeFrom(moveVector);
+    }
+
+    small_vector(std::initializer_list<T> initializerList, const Allocator& alloc = Allocator())
+        : small_vector(alloc) {
+        insert(end(), initializerList.begin(), initializerList.end());
+    }
+
+    ~small_vector() {
+        clear();
+        releaseHeap();
+    }
+
+    small_vector& operator=(const small_vector& copyVector) {
+        if (this != &copyVector) {
+            if constexpr (std::allocator_traits<
+                              Allocator>::propagate_on_container_copy_assignment::value) {
+                // A heap buffer belongs to the allocator being replaced.
+                if (allocator != copyVector.allocator) {
+                    clear();
+                    releaseHeap();
+                }
+                allocator = copyVector.allocator;
+            }
+
+            assign(copyVector.begin(), copyVector.end());
+        }
+
+        return *this;
+    }
+    // As in vector: the heap buffer is taken over only when the allocator propagates or the two
+    // compare equal; otherwise the elements are moved one by one into this vector's storage.
+    small_vector& operator=(small_vector&& moveVector) noexcept(
+        std::is_nothrow_move_constructible_v<T> &&
+        (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+         std::allocator_traits<Allocator>::is_always_equal::value)) {
+        if (this == &moveVector) {
+            return *this;
+        }
+
+        constexpr bool propagate =
+            std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value;
+
+        if (propagate || std::allocator_traits<Allocator>::is_always_equal::value ||
+            allocator == moveVector.allocator) {
+            clear();
+            releaseHeap();
+
+            if constexpr (propagate) {
+                allocator = std::move(moveVector.allocator);
+            }
+            takeFrom(moveVector);
+        } else {
+            assign(std::make_move_iterator(moveVector.begin()),
+                   std::make_move_iterator(moveVector.end()));
+        }
+
+        return *this;
+    }
+    small_vector& operator=(std::initializer_list<T> initializerList) {
+        assign(initializerList);
+
+        return *this;
+    }
+
+    template <class InputIterator>
+    void assign(
+        InputIterator first, InputIterator last,
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr) {
+        clear();
+        insert(end(), first, last);
+    }
+    void assign(size_type count, const T& value) {
+        T temp(value);
+
+        clear();
+        insert(end(), count, temp);
+    }
+    void assign(std::initializer_list<T> initializerList) {
+        assign(initializerList.begin(), initializerList.end());
+    }
+    allocator_type get_allocator() const noexcept {
+        return allocator;
+    }
+
+    // iterators
+    iterator begin() noexcept {
+        return iterator(data_);
+    }
+    iterator end() noexcept {
+        return iterator(data_ + sz_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(data_);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(data_ + sz_);
+    }
+    const_iterator cbegin() const noexcept {
+        return const_iterator(data_);
+    }
+    const_iterator cend() const noexcept {
+        return const_iterator(data_ + sz_);
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(cend());
+    }
+    const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(cbegin());
+    }
+
+    // capacity
+    bool empty() const noexcept {
+        return (sz_ == 0);
+    }
+    size_type size() const noexcept {
+        return sz_;
+    }
+    size_type capacity() const noexcept {
+        return cap_;
+    }
+    size_type max_size() const noexcept {
+        return std::allocator_traits<Allocator>::max_size(allocator) / 2;
+    }
+    bool is_inline() const noexcept {
+        return data_ == inlineData();
+    }
+    void resize(size_type count);
+    void resize(size_type count, const T& value);
+    void resize_for_overwrite(size_type count);
+    template <class Operation>
+    void resize_and_overwrite(size_type count, Operation op);
+    void reserve(size_type count);
+    void shrink_to_fit();
+
+    // element access
+    reference operator[](size_type n) {
+        COOLSTD_CHECK(n < sz_, "small_vector index out of range");
+        return data_[n];
+    }
+    const_reference operator[](size_type n) const {
+        COOLSTD_CHECK(n < sz_, "small_vector index out of range");
+        return data_[n];
+    }
+    reference at(size_type pos) {
+        if (pos < sz_) {
+            return data_[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    const_reference at(size_type pos) const {
+        if (pos < sz_) {
+            return data_[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+
+    reference front() {
+        COOLSTD_CHECK(sz_ > 0, "front() on an empty small_vector");
+        return data_[0];
+    }
+    const_reference front() const {
+        COOLSTD_CHECK(sz_ > 0, "front() on an empty small_vector");
+        return data_[0];
+    }
+    reference back() {
+        COOLSTD_CHECK(sz_ > 0, "back() on an empty small_vector");
+        return data_[sz_ - 1];
+    }
+    const_reference back() const {
+        COOLSTD_CHECK(sz_ > 0, "back() on an empty small_vector");
+        return data_[sz_ - 1];
+    }
+
+    // data access
+    T* data() noexcept {
+        return data_;
+    }
+    const T* data() const noexcept {
+        return data_;
+    }
+
+    // modifiers
+    template <class... Args>
+    reference emplace_back(Args&&... args);
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+    void pop_back() {
+        COOLSTD_CHECK(sz_ > 0, "pop_back() on an empty small_vector");
+        --sz_;
+        std::allocator_traits<Allocator>::destroy(allocator, data_ + sz_);
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator position, Args&&... args);
+    iterator insert(const_iterator position, const T& value) {
+        return emplace(position, value);
+    }
+    iterator insert(const_iterator position, T&& value) {
+        return emplace(position, std::move(value));
+    }
+    iterator insert(const_iterator position, size_type count, const T& value);
+    template <class InputIterator>
+    iterator insert(
+        const_iterator position, InputIterator first, InputIterator last,
+        typename std::enable_if<std::is_base_of<
+            std::input_iterator_tag,
+            typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
+            nullptr);
+    iterator insert(const_iterator position, std::initializer_list<T> initializerList) {
+        return insert(position, initializerList.begin(), initializerList.end());
+    }
+    template <std::ranges::input_range Range>
+    iterator insert_range(const_iterator position, Range&& range);
+    template <std::ranges::input_range Range>
+    void append_range(Range&& range) {
+        insert_range(end(), std::forward<Range>(range));
+    }
+
+    iterator erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+    iterator erase(const_iterator first, const_iterator last);
+
+    // Heap buffers change hands when the allocators propagate on swap or compare equal, and the
+    // allocators are exchanged only when they propagate. Otherwise each side keeps its allocator
+    // and storage and the elements themselves are swapped, as they are when both are inline.
+    void swap(small_vector& swapVector) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T> &&
+        (std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+         std::allocator_traits<Allocator>::is_always_equal::value));
+    void clear() noexcept {
+        detail::destroyRange(allocator, data_, data_ + sz_);
+        sz_ = 0;
+    }
+
+private:
+    size_type sz_ = 0;
+    size_type cap_ = N;
+    T* data_ = nullptr;
+    [[no_unique_address]] Allocator allocator;
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+
+    // helpers
+    T* inlineData() noexcept {
+        return reinterpret_cast<T*>(inline_);
+    }
+    const T* inlineData() const noexcept {
+        return reinterpret_cast<const T*>(inline_);
+    }
+
+    // Returns a heap buffer to the allocator and points the vector back at the inline buffer.
+    // Elements must already have been destroyed or relocated.
+    void releaseHeap() noexcept;
+
+    // Move construction/assignment into an empty, inline *this: steals a heap buffer, relocates
+    // inline elements.
+    void takeFrom(small_vector& other);
+
+    // Exchanges the elements of *this and other, each keeping its own storage and allocator.
+    void swapElements(small_vector& other);
+
+    size_type nextCapacity(size_type required) const;
+
+    // Same contract as vector::grow: the new buffer is always on the heap.
+    template <class Fill>
+    void grow(size_type newCap, size_type gapIndex, size_type gapSize, Fill fill);
+
+    // Opens a gap of gapSize elements at gapIndex within the current capacity and lets fill
+    // construct them. Trivially relocatable types slide the tail with memmove before fill runs,
+    // so fill must not read from *this; other types are constructed at the end and rotated into
+    // place.
+    template <class Fill>
+    void insertGap(size_type gapIndex, size_type gapSize, Fill fill);
+
+    // As in vector: a counted insertion grows at most once, an unsized one appends and rotates.
+    template <class InputIterator>
+    iterator insertCounted(size_type positionAsIndex, InputIterator first, size_type count);
+    template <class InputIterator, class Sentinel>
+    iterator insertUnsized(size_type positionAsIndex, InputIterator first, Sentinel last);
+};
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::resize(size_type count) {
+    if (count < sz_) {
+        erase(begin() + count, end());
+    } else if (count > sz_) {
+        const size_type added = count - sz_;
+
+        if (count > cap_) {
+            grow(nextCapacity(count), sz_, added,
+                 [&](pointer gap) { detail::uninitializedFill(allocator, gap, added); });
+        } else {
+            detail::uninitializedFill(allocator, data_ + sz_, added);
+        }
+        sz_ = count;
+    }
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::resize(size_type count, const T& value) {
+    if (count < sz_) {
+        erase(begin() + count, end());
+    } else if (count > sz_) {
+        insert(end(), count - sz_, value);
+    }
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::resize_for_overwrite(size_type count) {
+    if (count <= sz_) {
+        detail::destroyRange(allocator, data_ + count, data_ + sz_);
+    } else if (count <= cap_) {
+        detail::uninitializedDefaultFill(allocator, data_ + sz_, count - sz_);
+    } else {
+        grow(nextCapacity(count), sz_, count - sz_, [&](pointer gap) {
+            detail::uninitializedDefaultFill(allocator, gap, count - sz_);
+        });
+    }
+
+    sz_ = count;
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+template <class Operation>
+void small_vector<T, N, Allocator, GrowthPolicy>::resize_and_overwrite(size_type count,
+                                                                      Operation op) {
+    resize_for_overwrite(count);
+
+    const size_type written = size_type(op(data_, count));
+
+    detail::destroyRange(allocator, data_ + written, data_ + sz_);
+    sz_ = written;
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::reserve(size_type count) {
+    if (count > cap_) {
+        grow(count, sz_, 0, [](pointer) {});
+    }
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::shrink_to_fit() {
+    if (is_inline() || sz_ == cap_) {
+        return;
+    }
+
+    if (sz_ <= N) {
+        detail::relocate(allocator, data_, data_ + sz_, inlineData());
+        releaseHeap();
+    } else {
+        grow(sz_, sz_, 0, [](pointer) {});
+    }
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+template <class... Args>
+small_vector<T, N, Allocator, GrowthPolicy>::reference
+small_vector<T, N, Allocator, GrowthPolicy>::emplace_back(Args&&... args) {
+    if (sz_ == cap_) {
+        grow(nextCapacity(sz_ + 1), sz_, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap,
+                                                        std::forward<Args>(args)...);
+        });
+    } else {
+        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_,
+                                                    std::forward<Args>(args)...);
+    }
+
+    ++sz_;
+    return data_[sz_ - 1];
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+template <class... Args>
+small_vector<T, N, Allocator, GrowthPolicy>::iterator
+small_vector<T, N, Allocator, GrowthPolicy>::emplace(const_iterator position, Args&&... args) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+
+    auto fill = [&](pointer gap) {
+        std::allocator_traits<Allocator>::construct(allocator, gap, std::forward<Args>(args)...);
+    };
+
+    if (sz_ == cap_) {
+        grow(nextCapacity(sz_ + 1), positionAsIndex, 1, fill);
+        ++sz_;
+    } else if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        T temp(std::forward<Args>(args)...);
+
+        insertGap(positionAsIndex, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap, std::move(temp));
+        });
+    } else {
+        insertGap(positionAsIndex, 1, fill);
+    }
+
+    return iterator(data_ + positionAsIndex);
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>::iterator
+small_vector<T, N, Allocator, GrowthPolicy>::insert(const_iterator position, size_type count,
+                                                    const T& value) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+
+    auto fill = [&](pointer gap) { detail::uninitializedFill(allocator, gap, count, value); };
+
+    if (sz_ + count > cap_) {
+        grow(nextCapacity(sz_ + count), positionAsIndex, count, fill);
+        sz_ += count;
+    } else if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        if (count > 0) {
+            T temp(value);
+
+            insertGap(positionAsIndex, count, [&](pointer gap) {
+                detail::uninitializedFill(allocator, gap, count, temp);
+            });
+        }
+    } else if (count > 0) {
+        insertGap(positionAsIndex, count, fill);
+    }
+
+    return iterator(data_ + positionAsIndex);
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+template <class InputIterator>
+small_vector<T, N, Allocator, GrowthPolicy>::iterator
+small_vector<T, N, Allocator, GrowthPolicy>::insert(
+    const_iterator position, InputIterator first, InputIterator last,
+    typename std::enable_if<std::is_base_of<
+        std::input_iterator_tag,
+        typename std::iterator_traits<InputIterator>::iterator_category>::value>::type*) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+
+    if constexpr (std::is_base_of_v<
+                      std::forward_iterator_tag,
+                      typename std::iterator_traits<InputIterator>::iterator_category>) {
+        return insertCounted(positionAsIndex, first, size_type(std::distance(first, last)));
+    } else {
+        return insertUnsized(positionAsIndex, first, last);
+    }
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+template <std::ranges::input_range Range>
+small_vector<T, N, Allocator, GrowthPolicy>::iterator
+small_vector<T, N, Allocator, GrowthPolicy>::insert_range(const_iterator position, Range&& range) {
+    const size_type positionAsIndex = size_type(position - cbegin());
+    COOLSTD_CHECK(positionAsIndex <= sz_, "position is outside [begin(), end()]");
+
+    if constexpr (std::ranges::forward_range<Range> || std::ranges::sized_range<Range>) {
+        const size_type count = size_type(std::ranges::distance(range));
+
+        return insertCounted(positionAsIndex, std::ranges::begin(range), count);
+    } else {
+        return insertUnsized(positionAsIndex, std::ranges::begin(range), std::ranges::end(range));
+    }
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>::iterator
+small_vector<T, N, Allocator, GrowthPolicy>::erase(const_iterator first, const_iterator last) {
+    const size_type positionAsIndex = size_type(first - cbegin());
+    const size_type count = size_type(last - first);
+    COOLSTD_CHECK(positionAsIndex <= sz_ && count <= sz_ - positionAsIndex,
+                  "erase() range is not within [begin(), end()]");
+
+    if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        detail::destroyRange(allocator, data_ + positionAsIndex, data_ + positionAsIndex + count);
+        detail::shiftRange(data_ + positionAsIndex + count, data_ + sz_, data_ + positionAsIndex);
+    } else {
+        std::move(data_ + positionAsIndex + count, data_ + sz_, data_ + positionAsIndex);
+        detail::destroyRange(allocator, data_ + sz_ - count, data_ + sz_);
+    }
+    sz_ -= count;
+
+    return iterator(data_ + positionAsIndex);
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::swap(small_vector& swapVector) noexcept(
+    std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T> &&
+    (std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
+     std::allocator_traits<Allocator>::is_always_equal::value)) {
+    if (this == &swapVector) {
+        return;
+    }
+
+    constexpr bool propagate = std::allocator_traits<Allocator>::propagate_on_container_swap::value;
+
+    if ((is_inline() && swapVector.is_inline()) ||
+        (!propagate && !std::allocator_traits<Allocator>::is_always_equal::value &&
+         allocator != swapVector.allocator)) {
+        swapElements(swapVector);
+        return;
+    }
+
+    if (is_inline() || swapVector.is_inline()) {
+        // The heap side's inline buffer is free, so the inline elements relocate straight into
+        // it and the heap buffer moves over to the other side.
+        small_vector& onHeap = is_inline() ? swapVector : *this;
+        small_vector& inlined = is_inline() ? *this : swapVector;
+
+        detail::relocate(onHeap.allocator, inlined.data_, inlined.data_ + inlined.sz_,
+                         onHeap.inlineData());
+        inlined.data_ = std::exchange(onHeap.data_, onHeap.inlineData());
+        inlined.cap_ = std::exchange(onHeap.cap_, N);
+    } else {
+        std::swap(data_, swapVector.data_);
+        std::swap(cap_, swapVector.cap_);
+    }
+    std::swap(sz_, swapVector.sz_);
+
+    if constexpr (propagate) {
+        using std::swap;
+        swap(allocator, swapVector.allocator);
+    }
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::releaseHeap() noexcept {
+    if (!is_inline()) {
+        if constexpr (!detail::is_monotonic<Allocator>::value) {
+            std::allocator_traits<Allocator>::deallocate(allocator, data_, cap_);
+        }
+        data_ = inlineData();
+        cap_ = N;
+    }
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::takeFrom(small_vector& other) {
+    if (other.is_inline()) {
+        detail::relocate(allocator, other.data_, other.data_ + other.sz_, inlineData());
+    } else {
+        data_ = other.data_;
+        cap_ = other.cap_;
+        other.data_ = other.inlineData();
+        other.cap_ = N;
+    }
+
+    sz_ = other.sz_;
+    other.sz_ = 0;
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void small_vector<T, N, Allocator, GrowthPolicy>::swapElements(small_vector& other) {
+    small_vector& longer = sz_ < other.sz_ ? other : *this;
+    small_vector& shorter = sz_ < other.sz_ ? *this : other;
+    const size_type common = shorter.sz_;
+
+    shorter.reserve(longer.sz_);
+    std::swap_ranges(longer.data_, longer.data_ + common, shorter.data_);
+    shorter.insert(shorter.end(), std::make_move_iterator(longer.data_ + common),
+                   std::make_move_iterator(longer.data_ + longer.sz_));
+    detail::destroyRange(longer.allocator, longer.data_ + common, longer.data_ + longer.sz_);
+    longer.sz_ = common;
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+small_vector<T, N, Allocator, GrowthPolicy>::size_type
+small_vector<T, N, Allocator, GrowthPolicy>::nextCapacity(size_type required) const {
+    if (required > max_size()) {
+        throw(std::length_error("Required capacity exceeds max_size()!"));
+    }
+
+    const size_type next = GrowthPolicy::next_capacity(cap_, required, sizeof(T));
+
+    return std::min(std::max(next, required), max_size());
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+template <class Fill>
+void small_vector<T, N, Allocator, GrowthPolicy>::grow(size_type newCap, size_type gapIndex,
+                                                       size_type gapSize, Fill fill) {
+    if (!is_inline() && gapIndex == sz_ && detail::tryExpand(allocator, data_, cap_, newCap)) {
+        cap_ = newCap;
+        fill(data_ + gapIndex);
+        return;
+    }
+
+    // Read before the allocation and fill, which the compiler can't see through, so that it
+    // knows the relocated range ends where a gap at the end starts.
+    const size_type oldSize = sz_;
+    auto [newData, allocated] = detail::allocateAtLeast(allocator, newCap);
+
+    try {
+        fill(newData + gapIndex);
+    } catch (...) {
+        std::allocator_traits<Allocator>::deallocate(allocator, newData, allocated);
+        throw;
+    }
+
+    try {
+        detail::relocate(allocator, data_, data_ + oldSize, newData, gapIndex, gapSize);
+    } catch (...) {
+        detail::destroyRange(allocator, newData + gapIndex, newData + gapIndex + gapSize);
+        std::allocator_traits<Allocator>::deallocate(allocator, newData, allocated);
+        throw;
+    }
+
+    releaseHeap();
+
+    data_ = newData;
+    cap_ = allocated;
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+template <class Fill>
+void small_vector<T, N, Allocator, GrowthPolicy>::insertGap(size_type gapIndex, size_type gapSize,
+                                                            Fill fill) {
+    if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        detail::shiftRange(data_ + gapIndex, data_ + sz_, data_ + gapIndex + gapSize);
+
+        try {
+            fill(data_ + gapIndex);
+        } catch (...) {
+            detail::shiftRange(data_ + gapIndex + gapSize, data_ + sz_ + gapSize,
+                               data_ + gapIndex);
+            throw;
+        }
+    } else {
+        fill(data_ + sz_);
+        std::rotate(data_ + gapIndex, data_ + sz_, data_ + sz_ + gapSize);
+    }
+
+    sz_ += gapSize;
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+template <class InputIterator>
+small_vector<T, N, Allocator, GrowthPolicy>::iterator
+small_vector<T, N, Allocator, GrowthPolicy>::insertCounted(size_type positionAsIndex,
+                                                           InputIterator first, size_type count) {
+    auto fill = [&](pointer gap) { detail::uninitializedCopyN(allocator, first, count, gap); };
+
+    if (sz_ + count > cap_) {
+        grow(nextCapacity(sz_ + count), positionAsIndex, count, fill);
+        sz_ += count;
+    } else if (count > 0) {
+        insertGap(positionAsIndex, count, fill);
+    }
+
+    return iterator(data_ + positionAsIndex);
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+template <class InputIterator, class Sentinel>
+small_vector<T, N, Allocator, GrowthPolicy>::iterator
+small_vector<T, N, Allocator, GrowthPolicy>::insertUnsized(size_type positionAsIndex,
+                                                           InputIterator first, Sentinel last) {
+    const size_type oldSize = sz_;
+
+    for (; first != last; ++first) {
+        emplace_back(*first);
+    }
+    std::rotate(data_ + positionAsIndex, data_ + oldSize, data_ + sz_);
+
+    return iterator(data_ + positionAsIndex);
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+void swap(small_vector<T, N, Allocator, GrowthPolicy>& lhs,
+          small_vector<T, N, Allocator, GrowthPolicy>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+bool operator==(const small_vector<T, N, Allocator, GrowthPolicy>& lhs,
+                const small_vector<T, N, Allocator, GrowthPolicy>& rhs) {
+    return lhs.size() == rhs.size() && detail::equalRanges(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class T, std::size_t N, class Allocator, class GrowthPolicy>
+auto operator<=>(const small_vector<T, N, Allocator, GrowthPolicy>& lhs,
+                 const small_vector<T, N, Allocator, GrowthPolicy>& rhs) {
+    return detail::compareRanges(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+}
+}  // namespace coolstd
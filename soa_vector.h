@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "vector.h"
+
+namespace coolstd {
+// A vector of records whose fields are stored structure-of-arrays: field I of every record
+// lives in a contiguous coolstd::vector of its own, so a loop that reads two fields of a record
+// with eight only brings those two arrays into cache, and get<I>() hands one out as a span for
+// columnar (SIMD) loops. Every column is a coolstd::vector with the same GrowthPolicy, which does
+// the allocation, growth and relocation; soa_vector only keeps the columns the same length, and
+// undoes the columns already changed when a later one throws, so each operation has the
+// guarantee vector gives for it.
+//
+// Whole records are reached through proxies: operator[] and the iterators yield a
+// std::tuple<Ts&...>, which structured bindings unpack (`for (auto [x, vx] : particles)`).
+// Proxies are not objects of value_type, so the iterators are not contiguous, and algorithms that
+// swap through references (std::sort) need the columns sorted by index instead.
+template <class GrowthPolicy, class... Ts>
+class basic_soa_vector {
+    static_assert(sizeof...(Ts) > 0, "a record needs at least one field");
+
+    template <bool Const>
+    class Iterator;
+
+public:
+    using value_type = std::tuple<Ts...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::tuple<Ts&...>;
+    using const_reference = std::tuple<const Ts&...>;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    template <std::size_t I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    static constexpr size_type field_count = sizeof...(Ts);
+
+    // construct/copy/destroy
+    basic_soa_vector() = default;
+    explicit basic_soa_vector(size_type count) {
+        resize(count);
+    }
+    basic_soa_vector(size_type count, const value_type& value) {
+        resize(count, value);
+    }
+    basic_soa_vector(std::initializer_list<value_type> initializerList) {
+        reserve(initializerList.size());
+        for (const value_type& value : initializerList) {
+            push_back(value);
+        }
+    }
+
+    // iterators
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size());
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size());
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    // capacity
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+    size_type size() const noexcept {
+        return std::get<0>(columns_).size();
+    }
+    // Records that fit before any column reallocates.
+    size_type capacity() const noexcept {
+        return std::apply(
+            [](const auto&... column) { return std::min({column.capacity()...}); }, columns_);
+    }
+    size_type max_size() const noexcept {
+        return std::apply([](const auto&... column) { return std::min({column.max_size()...}); },
+                          columns_);
+    }
+    void reserve(size_type count) {
+        eachColumn([&](auto& column, auto) { column.reserve(count); }, [](auto&) {});
+    }
+    void shrink_to_fit() {
+        eachColumn([](auto& column, auto) { column.shrink_to_fit(); }, [](auto&) {});
+    }
+    void resize(size_type count) {
+        const size_type old = size();
+        eachColumn([&](auto& column, auto) { column.resize(count); },
+                   [&](auto& column) { truncate(column, old); });
+    }
+    void resize(size_type count, const value_type& value) {
+        const size_type old = size();
+        eachColumn([&](auto& column, auto field) { column.resize(count, std::get<field>(value)); },
+                   [&](auto& column) { truncate(column, old); });
+    }
+
+    // element access
+    reference operator[](size_type n) {
+        return std::apply([n](auto&... column) { return reference(column[n]...); }, columns_);
+    }
+    const_reference operator[](size_type n) const {
+        return std::apply([n](const auto&... column) { return const_reference(column[n]...); },
+                          columns_);
+    }
+    reference at(size_type pos) {
+        if (pos < size()) {
+            return (*this)[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    const_reference at(size_type pos) const {
+        if (pos < size()) {
+            return (*this)[pos];
+        }
+
+        throw(std::out_of_range("Pos is out-of-range!"));
+    }
+    reference front() {
+        return (*this)[0];
+    }
+    const_reference front() const {
+        return (*this)[0];
+    }
+    reference back() {
+        return (*this)[size() - 1];
+    }
+    const_reference back() const {
+        return (*this)[size() - 1];
+    }
+
+    // Field I of every record, contiguous: the column itself, for loops over one field. The span
+    // is invalidated by anything that would invalidate a vector's data().
+    template <std::size_t I>
+    std::span<field_type<I>> get() noexcept {
+        return {std::get<I>(columns_).data(), size()};
+    }
+    template <std::size_t I>
+    std::span<const field_type<I>> get() const noexcept {
+        return {std::get<I>(columns_).data(), size()};
+    }
+
+    // modifiers
+    // Appends a record built from one argument per field.
+    template <class... Args>
+    reference emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one value per field");
+
+        auto fields = std::forward_as_tuple(std::forward<Args>(args)...);
+        eachColumn(
+            [&](auto& column, auto field) {
+                column.emplace_back(std::get<field>(std::move(fields)));
+            },
+            [](auto& column) { column.pop_back(); });
+        return back();
+    }
+    void push_back(const value_type& value) {
+        std::apply([this](const auto&... fields) { emplace_back(fields...); }, value);
+    }
+    void push_back(value_type&& value) {
+        std::apply([this](auto&&... fields) { emplace_back(std::move(fields)...); },
+                   std::move(value));
+    }
+    void pop_back() {
+        std::apply([](auto&... column) { (column.pop_back(), ...); }, columns_);
+    }
+
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        const size_type from = first.index_;
+        const size_type to = last.index_;
+
+        std::apply(
+            [&](auto&... column) {
+                (column.erase(column.begin() + difference_type(from),
+                              column.begin() + difference_type(to)),
+                 ...);
+            },
+            columns_);
+        return iterator(this, from);
+    }
+
+    void clear() noexcept {
+        std::apply([](auto&... column) { (column.clear(), ...); }, columns_);
+    }
+    void swap(basic_soa_vector& other) noexcept {
+        columns_.swap(other.columns_);
+    }
+
+    friend bool operator==(const basic_soa_vector& lhs, const basic_soa_vector& rhs) {
+        return lhs.columns_ == rhs.columns_;
+    }
+
+private:
+    std::tuple<vector<Ts, std::allocator<Ts>, GrowthPolicy>...> columns_;
+
+    // Runs op(column, field) on each column in field order, field being the column's index as a
+    // std::integral_constant. If op throws, undo(column) runs on the columns op already changed
+    // and the exception propagates; undo must not throw.
+    template <class Op, class Undo>
+    void eachColumn(Op op, Undo undo) {
+        eachColumnImpl(std::index_sequence_for<Ts...>(), op, undo);
+    }
+
+    template <std::size_t... Is, class Op, class Undo>
+    void eachColumnImpl(std::index_sequence<Is...>, Op& op, Undo& undo) {
+        size_type done = 0;
+
+        try {
+            ((op(std::get<Is>(columns_), std::integral_constant<std::size_t, Is>()), ++done), ...);
+        } catch (...) {
+            ((Is < done ? undo(std::get<Is>(columns_)) : void()), ...);
+            throw;
+        }
+    }
+
+    // Shrinks a column back to count elements; unlike resize() this needs nothing of the type.
+    template <class Column>
+    static void truncate(Column& column, size_type count) noexcept {
+        while (column.size() > count) {
+            column.pop_back();
+        }
+    }
+};
+
+template <class GrowthPolicy, class... Ts>
+template <bool Const>
+class basic_soa_vector<GrowthPolicy, Ts...>::Iterator {
+    using Owner = std::conditional_t<Const, const basic_soa_vector, basic_soa_vector>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::tuple<Ts...>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = std::conditional_t<Const, const_reference, basic_soa_vector::reference>;
+
+    Iterator() = default;
+    Iterator(Owner* owner, size_type index) : owner_(owner), index_(index) {
+    }
+    // iterator converts to const_iterator.
+    template <bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+    Iterator(const Iterator<OtherConst>& other) : owner_(other.owner_), index_(other.index_) {
+    }
+
+    reference operator*() const {
+        return (*owner_)[index_];
+    }
+    reference operator[](difference_type n) const {
+        return *(*this + n);
+    }
+
+    Iterator& operator++() {
+        ++index_;
+        return *this;
+    }
+    Iterator operator++(int) {
+        Iterator old = *this;
+        ++index_;
+        return old;
+    }
+    Iterator& operator--() {
+        --index_;
+        return *this;
+    }
+    Iterator operator--(int) {
+        Iterator old = *this;
+        --index_;
+        return old;
+    }
+    Iterator& operator+=(difference_type n) {
+        index_ = size_type(difference_type(index_) + n);
+        return *this;
+    }
+    Iterator& operator-=(difference_type n) {
+        index_ = size_type(difference_type(index_) - n);
+        return *this;
+    }
+    Iterator operator+(difference_type n) const {
+        return Iterator(owner_, size_type(difference_type(index_) + n));
+    }
+    friend Iterator operator+(difference_type n, const Iterator& it) {
+        return it + n;
+    }
+    Iterator operator-(difference_type n) const {
+        return Iterator(owner_, size_type(difference_type(index_) - n));
+    }
+    difference_type operator-(const Iterator& it) const {
+        return difference_type(index_) - difference_type(it.index_);
+    }
+
+    bool operator==(const Iterator& rhs) const {
+        return index_ == rhs.index_;
+    }
+    auto operator<=>(const Iterator& rhs) const {
+        return index_ <=> rhs.index_;
+    }
+
+private:
+    template <bool>
+    friend class Iterator;
+    friend class basic_soa_vector;
+
+    Owner* owner_ = nullptr;
+    size_type index_ = 0;
+};
+
+template <class... Ts>
+using soa_vector = basic_soa_vector<growth::doubling, Ts...>;
+
+template <class GrowthPolicy, class... Ts>
+void swap(basic_soa_vector<GrowthPolicy, Ts...>& lhs,
+          basic_soa_vector<GrowthPolicy, Ts...>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // namespace coolstd
@@ -4,9 +4,38 @@
 #include <catch2/matchers/catch_matchers_range_equals.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <list>
+#include <map>
+#include <ranges>
+#include <set>
+#include <sstream>
+#include <string>
 
 #include <vector>
 #include "vector.h"
+#include "allocators.h"
+#include "concurrent_vector.h"
+#include "devector.h"
+#include "incremental_vector.h"
+#include "inplace_vector.h"
+#include "instrument.h"
+#include "mapped_file.h"
+#include "parallel.h"
+#include "segmented_vector.h"
+#include "serialize.h"
+#include "simd.h"
+#include "small_vector.h"
+#include "soa_vector.h"
 
 template <typename T>
 std::vector<T> create_range(T start, T end) {
@@ -244,6 +273,29 @@ TEST_CASE("Iterators", "[vector]") {
             ++std_rit;
         }
     }
+
+    SECTION("Iterators compare by position alone") {
+        REQUIRE(custom_vec.begin() == custom_vector::iterator(custom_vec.data()));
+        REQUIRE(custom_vec.cend() == custom_vector::const_iterator(custom_vec.data() + 5));
+        REQUIRE(custom_vector::iterator(custom_vec.data()) < custom_vec.end());
+        REQUIRE(custom_vec.begin() == custom_vec.cbegin());
+    }
+
+    SECTION("Iterators follow their elements through swap and move") {
+        custom_vector other = {6, 7};
+        const auto first = custom_vec.begin();
+        const auto last = custom_vec.cend();
+
+        custom_vec.swap(other);
+        REQUIRE(*first == 1);
+        REQUIRE(first[4] == 5);
+        REQUIRE(last - first == 5);
+        REQUIRE(std::equal(first, other.end(), std_vec.begin(), std_vec.end()));
+
+        const custom_vector moved(std::move(other));
+        REQUIRE(*(last - 1) == 5);
+        REQUIRE(first == moved.begin());
+    }
 }
 
 TEST_CASE("Capacity", "[vector]") {
@@ -310,6 +362,37 @@ TEST_CASE("Capacity", "[vector]") {
         REQUIRE(custom_vec.capacity() == std_vec.capacity());
         REQUIRE(custom_vec.capacity() == std_vec.size());
     }
+
+    SECTION("Resize for overwrite") {
+        custom_vec.resize_for_overwrite(100);
+        std::iota(custom_vec.begin(), custom_vec.end(), 1);
+        custom_vec.resize_for_overwrite(3);
+
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(create_range(1, 3)));
+    }
+
+    SECTION("Resize and overwrite") {
+        custom_vec.resize_and_overwrite(64, [](int* data, std::size_t count) {
+            REQUIRE(data[4] == 5);
+            for (std::size_t i = 5; i < count; ++i) {
+                data[i] = int(i) + 1;
+            }
+            return std::size_t(10);
+        });
+
+        REQUIRE(custom_vec.capacity() >= 64);
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(create_range(1, 10)));
+
+        coolstd::vector<std::string> strings{"kept"};
+        strings.resize_and_overwrite(5, [](std::string* data, std::size_t) {
+            data[1] = "written";
+            return 2;
+        });
+
+        REQUIRE(strings.size() == 2);
+        REQUIRE(strings[0] == "kept");
+        REQUIRE(strings[1] == "written");
+    }
 }
 
 TEST_CASE("Element access", "[vector]") {
@@ -824,3 +907,2374 @@ TEST_CASE("Algorithms", "[vector]") {
         REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
     }
 }
+
+struct ThrowingMove {
+    static inline int copies = 0;
+    static inline int copiesUntilThrow = -1;
+
+    int value = 0;
+
+    ThrowingMove(int v) : value(v) {
+    }
+    ThrowingMove(const ThrowingMove& other) : value(other.value) {
+        if (copiesUntilThrow == 0) {
+            throw std::runtime_error("copy failed");
+        }
+        --copiesUntilThrow;
+        ++copies;
+    }
+    ThrowingMove(ThrowingMove&& other) noexcept(false) : value(other.value) {
+    }
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+
+    bool operator==(const ThrowingMove& other) const {
+        return value == other.value;
+    }
+};
+
+struct RelocatableHandle {
+    using trivially_relocatable = std::true_type;
+
+    static inline int moves = 0;
+
+    std::unique_ptr<int> value;
+
+    RelocatableHandle(int v) : value(std::make_unique<int>(v)) {
+    }
+    RelocatableHandle(RelocatableHandle&& other) noexcept : value(std::move(other.value)) {
+        ++moves;
+    }
+    RelocatableHandle& operator=(RelocatableHandle&& other) noexcept {
+        value = std::move(other.value);
+        ++moves;
+        return *this;
+    }
+
+    bool operator==(int other) const {
+        return *value == other;
+    }
+};
+
+TEST_CASE("Relocation", "[vector]") {
+    SECTION("Trivially relocatable trait") {
+        static_assert(coolstd::is_trivially_relocatable_v<int>);
+        static_assert(coolstd::is_trivially_relocatable_v<std::unique_ptr<int>>);
+        static_assert(coolstd::is_trivially_relocatable_v<RelocatableHandle>);
+        static_assert(!coolstd::is_trivially_relocatable_v<std::string>);
+        static_assert(!coolstd::is_trivially_relocatable_v<ThrowingMove>);
+    }
+
+    SECTION("Trivially relocatable elements are moved bitwise") {
+        coolstd::vector<RelocatableHandle> custom_vec;
+        custom_vec.reserve(1);
+        custom_vec.emplace_back(1);
+        custom_vec.emplace_back(2);
+        custom_vec.emplace_back(4);
+        RelocatableHandle::moves = 0;
+
+        custom_vec.reserve(10);
+        custom_vec.emplace(custom_vec.begin() + 2, 3);
+        custom_vec.emplace(custom_vec.begin(), 0);
+        custom_vec.erase(custom_vec.begin() + 1);
+        custom_vec.erase(custom_vec.begin(), custom_vec.begin() + 2);
+        custom_vec.shrink_to_fit();
+
+        REQUIRE(RelocatableHandle::moves == 2);  // the emplace temporaries
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std::vector<int>{3, 4}));
+    }
+
+    SECTION("Strings are moved, not copied") {
+        coolstd::vector<std::string> custom_vec = {std::string(64, 'a'), std::string(64, 'b')};
+        const char* buffer = custom_vec[1].data();
+
+        custom_vec.reserve(100);
+
+        REQUIRE(custom_vec[1].data() == buffer);
+        REQUIRE(custom_vec[0] == std::string(64, 'a'));
+    }
+
+    SECTION("Move-only elements") {
+        coolstd::vector<std::unique_ptr<int>> custom_vec;
+        custom_vec.reserve(1);
+
+        for (int i = 0; i < 10; ++i) {
+            custom_vec.push_back(std::make_unique<int>(i));
+        }
+        custom_vec.emplace(custom_vec.begin() + 3, std::make_unique<int>(42));
+        custom_vec.insert(custom_vec.begin(), std::make_unique<int>(-1));
+        custom_vec.erase(custom_vec.begin() + 1);
+        custom_vec.shrink_to_fit();
+
+        REQUIRE(custom_vec.size() == 11);
+        REQUIRE(custom_vec.capacity() == 11);
+        REQUIRE(*custom_vec[0] == -1);
+        REQUIRE(*custom_vec[3] == 42);
+        REQUIRE(*custom_vec[10] == 9);
+    }
+
+    SECTION("Throwing move falls back to copy") {
+        coolstd::vector<ThrowingMove> custom_vec = {1, 2, 3};
+        ThrowingMove::copies = 0;
+
+        custom_vec.reserve(10);
+
+        REQUIRE(ThrowingMove::copies == 3);
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std::vector<ThrowingMove>{1, 2, 3}));
+    }
+
+    SECTION("Strong exception guarantee") {
+        coolstd::vector<ThrowingMove> custom_vec = {1, 2, 3, 4};
+        const ThrowingMove* data = custom_vec.data();
+        ThrowingMove::copiesUntilThrow = 2;
+
+        REQUIRE_THROWS_AS(custom_vec.reserve(10), std::runtime_error);
+        REQUIRE_THROWS_AS(custom_vec.insert(custom_vec.begin() + 1, 3, ThrowingMove(0)),
+                          std::runtime_error);
+        ThrowingMove::copiesUntilThrow = -1;
+
+        REQUIRE(custom_vec.data() == data);
+        REQUIRE(custom_vec.capacity() == 4);
+        REQUIRE_THAT(custom_vec,
+                     Catch::Matchers::RangeEquals(std::vector<ThrowingMove>{1, 2, 3, 4}));
+    }
+}
+
+template <class GrowthPolicy>
+std::vector<std::size_t> capacity_steps(std::size_t pushes) {
+    coolstd::vector<int, std::allocator<int>, GrowthPolicy> custom_vec;
+    std::vector<std::size_t> steps;
+
+    for (std::size_t i = 0; i < pushes; ++i) {
+        custom_vec.push_back(int(i));
+        if (steps.empty() || steps.back() != custom_vec.capacity()) {
+            steps.push_back(custom_vec.capacity());
+        }
+    }
+
+    return steps;
+}
+
+TEST_CASE("Growth policy", "[vector]") {
+    SECTION("First push from empty allocates") {
+        coolstd::vector<std::string> custom_vec;
+        custom_vec.emplace_back("one");
+
+        REQUIRE(custom_vec.capacity() >= 1);
+        REQUIRE(custom_vec.front() == "one");
+    }
+
+    SECTION("Doubling") {
+        REQUIRE(capacity_steps<coolstd::growth::doubling>(9) ==
+                std::vector<std::size_t>{1, 2, 4, 8, 16});
+    }
+
+    SECTION("One and a half") {
+        REQUIRE(capacity_steps<coolstd::growth::one_and_a_half>(10) ==
+                std::vector<std::size_t>{1, 2, 3, 4, 6, 9, 13});
+    }
+
+    SECTION("Fixed increment") {
+        REQUIRE(capacity_steps<coolstd::growth::fixed_increment<4>>(9) ==
+                std::vector<std::size_t>{4, 8, 12});
+    }
+
+    SECTION("Size class rounding") {
+        using policy = coolstd::growth::size_class<>;
+
+        REQUIRE(policy::round_bytes(1) == 16);
+        REQUIRE(policy::round_bytes(129) == 160);
+        REQUIRE(policy::round_bytes(256) == 256);
+        REQUIRE(policy::round_bytes(257) == 320);
+        REQUIRE(capacity_steps<policy>(9) == std::vector<std::size_t>{4, 8, 12});
+    }
+
+    SECTION("Insert uses the policy") {
+        coolstd::vector<int> custom_vec = {1, 2, 3, 4};
+
+        custom_vec.insert(custom_vec.begin(), 0);
+        REQUIRE(custom_vec.capacity() == 8);
+
+        custom_vec.insert(custom_vec.end(), 10, 5);
+        REQUIRE(custom_vec.capacity() == 16);
+        REQUIRE(custom_vec.size() == 15);
+    }
+}
+
+template <typename T>
+struct InPlaceAllocator {
+    using value_type = T;
+
+    static constexpr std::size_t blockSize = 64;
+    static inline std::size_t expansions = 0;
+
+    InPlaceAllocator() = default;
+
+    template <typename U>
+    constexpr InPlaceAllocator(const InPlaceAllocator<U>&) noexcept {
+    }
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(std::max(n, blockSize) * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p);
+    }
+
+    bool try_expand(T*, std::size_t, std::size_t newCount) {
+        if (newCount > blockSize) {
+            return false;
+        }
+        ++expansions;
+        return true;
+    }
+
+    bool operator==(const InPlaceAllocator&) const {
+        return true;
+    }
+};
+
+TEST_CASE("In-place expansion", "[vector]") {
+    SECTION("try_expand is used before reallocating") {
+        coolstd::vector<std::string, InPlaceAllocator<std::string>> custom_vec;
+        custom_vec.push_back("first");
+        const std::string* data = custom_vec.data();
+        InPlaceAllocator<std::string>::expansions = 0;
+
+        for (int i = 1; i < 64; ++i) {
+            custom_vec.push_back(custom_vec[0]);
+        }
+        custom_vec.resize(64, "x");
+
+        REQUIRE(custom_vec.data() == data);
+        REQUIRE(InPlaceAllocator<std::string>::expansions == 6);
+
+        custom_vec.push_back("last");
+
+        REQUIRE(custom_vec.data() != data);
+        REQUIRE(custom_vec[63] == "first");
+        REQUIRE(custom_vec.back() == "last");
+    }
+
+    SECTION("realloc_allocator") {
+        coolstd::vector<int, coolstd::realloc_allocator<int>> custom_vec;
+        std::vector<int> std_vec;
+
+        custom_vec.push_back(7);
+        std_vec.push_back(7);
+        for (int i = 0; i < 100000; ++i) {
+            custom_vec.push_back(custom_vec[std::size_t(i) / 2]);
+            std_vec.push_back(std_vec[std::size_t(i) / 2] + 0);
+        }
+        custom_vec.insert(custom_vec.begin() + 10, 3);
+        std_vec.insert(std_vec.begin() + 10, 3);
+        custom_vec.reserve(1 << 20);
+        custom_vec.shrink_to_fit();
+
+        REQUIRE(custom_vec.capacity() >= custom_vec.size());
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+    }
+
+    SECTION("realloc_allocator with relocatable elements") {
+        coolstd::vector<std::unique_ptr<int>, coolstd::realloc_allocator<std::unique_ptr<int>>>
+            custom_vec;
+        std::vector<int> std_vec;
+
+        for (int i = 0; i < 100; ++i) {
+            custom_vec.emplace(custom_vec.begin() + i / 2, std::make_unique<int>(i));
+            std_vec.emplace(std_vec.begin() + i / 2, i);
+        }
+        custom_vec.erase(custom_vec.begin() + 50, custom_vec.end());
+        std_vec.erase(std_vec.begin() + 50, std_vec.end());
+        custom_vec.shrink_to_fit();
+
+        REQUIRE(custom_vec.size() == std_vec.size());
+        for (std::size_t i = 0; i < std_vec.size(); ++i) {
+            REQUIRE(*custom_vec[i] == std_vec[i]);
+        }
+    }
+}
+
+TEST_CASE("Range insertion", "[vector]") {
+    SECTION("Input iterators") {
+        std::istringstream input("1 2 3 4 5");
+        coolstd::vector<int> custom_vec(std::istream_iterator<int>(input),
+                                        std::istream_iterator<int>{});
+
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(create_range(1, 5)));
+
+        std::istringstream more("7 8");
+        custom_vec.insert(custom_vec.begin() + 1, std::istream_iterator<int>(more),
+                          std::istream_iterator<int>{});
+
+        REQUIRE_THAT(custom_vec,
+                     Catch::Matchers::RangeEquals(std::vector<int>{1, 7, 8, 2, 3, 4, 5}));
+
+        std::istringstream replacement("9 9");
+        custom_vec.assign(std::istream_iterator<int>(replacement), std::istream_iterator<int>{});
+
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std::vector<int>{9, 9}));
+    }
+
+    SECTION("append_range") {
+        const coolstd::vector<int> source = {1, 2, 3};
+        coolstd::vector<int> custom_vec;
+        custom_vec.append_range(source);
+        custom_vec.append_range(std::list<int>{4, 5});
+        custom_vec.append_range(std::views::iota(6, 9));
+
+        std::istringstream input("9 10");
+        custom_vec.append_range(std::views::istream<int>(input));
+
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(create_range(1, 10)));
+    }
+
+    SECTION("insert_range") {
+        coolstd::vector<std::string> custom_vec = {"a", "b", "c", "d"};
+        std::vector<std::string> std_vec(custom_vec.begin(), custom_vec.end());
+        custom_vec.reserve(16);
+
+        const std::vector<std::string> source = {"x", "y", "z"};
+        custom_vec.insert_range(custom_vec.begin() + 1, source);
+        std_vec.insert(std_vec.begin() + 1, source.begin(), source.end());
+        auto it = custom_vec.insert_range(custom_vec.end() - 1, std::vector<std::string>{"w"});
+        std_vec.insert(std_vec.end() - 1, "w");
+
+        REQUIRE(*it == "w");
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+    }
+
+    SECTION("Contiguous iterators") {
+        STATIC_REQUIRE(std::contiguous_iterator<coolstd::vector<int>::iterator>);
+        STATIC_REQUIRE(coolstd::detail::is_contiguous_iterator<
+                       coolstd::vector<int>::const_iterator>::value);
+        STATIC_REQUIRE_FALSE(
+            coolstd::detail::is_contiguous_iterator<std::list<int>::iterator>::value);
+    }
+}
+
+template <class T, coolstd::instrument::site_name Site>
+using counted_vector = coolstd::vector<T, std::allocator<T>, coolstd::growth::doubling,
+                                       coolstd::instrument::counted<Site>>;
+
+TEST_CASE("Instrumentation", "[vector]") {
+    auto& registry = coolstd::instrument::registry::instance();
+
+    SECTION("Growth of trivially relocatable elements") {
+        {
+            counted_vector<int, "test.ints"> custom_vec;
+            for (int i = 0; i < 100; ++i) {
+                custom_vec.push_back(i);
+            }
+            custom_vec.insert(custom_vec.begin() + 90, 7);
+        }
+
+        auto stats = registry.find("test.ints");
+
+        REQUIRE(stats.allocations == 8);
+        REQUIRE(stats.deallocations == 8);
+        REQUIRE(stats.reallocations == 7);
+        REQUIRE(stats.relocated_bitwise == 127);
+        REQUIRE(stats.relocated_bytes == 127 * sizeof(int));
+        REQUIRE(stats.shifted == 10);
+        REQUIRE(stats.live_bytes == 0);
+        REQUIRE(stats.peak_capacity_bytes == 128 * sizeof(int));
+        REQUIRE(stats.peak_live_bytes == (128 + 64) * sizeof(int));
+        REQUIRE(stats.released_slack_bytes == 27 * sizeof(int));
+    }
+
+    SECTION("Moved and copied elements") {
+        {
+            counted_vector<std::string, "test.strings"> strings(4);
+            strings.reserve(16);
+            strings.shrink_to_fit();
+
+            counted_vector<ThrowingMove, "test.throwing"> throwing(2, ThrowingMove(1));
+            throwing.reserve(3);
+        }
+
+        REQUIRE(registry.find("test.strings").relocated_moved == 8);
+        REQUIRE(registry.find("test.strings").reallocations == 2);
+        REQUIRE(registry.find("test.throwing").relocated_copied == 2);
+    }
+
+    SECTION("Allocator-resized blocks") {
+        {
+            coolstd::vector<std::string, InPlaceAllocator<std::string>, coolstd::growth::doubling,
+                            coolstd::instrument::counted<"test.in_place">>
+                custom_vec;
+            for (int i = 0; i < 16; ++i) {
+                custom_vec.emplace_back("x");
+            }
+
+            auto stats = registry.find("test.in_place");
+
+            REQUIRE(stats.allocations == 1);
+            REQUIRE(stats.resized_by_allocator == 4);
+            REQUIRE(stats.live_bytes == 16 * sizeof(std::string));
+        }
+
+        REQUIRE(registry.find("test.in_place").live_bytes == 0);
+    }
+
+    SECTION("Assignment reports the elements it releases") {
+        counted_vector<int, "test.assigned"> target(8, 1);
+        const std::size_t slack = (target.capacity() - 8) * sizeof(int);
+        counted_vector<int, "test.assigned"> source(4, 2);
+        target = std::move(source);
+
+        REQUIRE(registry.find("test.assigned").deallocations == 1);
+        REQUIRE(registry.find("test.assigned").released_slack_bytes == slack);
+    }
+
+    SECTION("Registry export") {
+        counted_vector<int, "test.export"> custom_vec{1, 2, 3};
+        std::ostringstream json;
+        registry.write_json(json);
+
+        REQUIRE(json.str().find("\"test.export\": {\"allocations\": 1") != std::string::npos);
+        REQUIRE(registry.find("test.unused").allocations == 0);
+    }
+}
+
+// Fails on any deallocation whose size differs from the allocation, or that frees a block it
+// didn't hand out. Instances compare equal only when their ids match; foreignFrees counts blocks
+// freed through an allocator with a different id than the one that allocated them.
+template <typename T>
+struct StrictAllocator {
+    using value_type = T;
+
+    static inline std::map<void*, std::size_t> live;
+    static inline std::size_t mismatches = 0;
+    static inline std::map<void*, int> owners;
+    static inline std::size_t foreignFrees = 0;
+
+    int id = 0;
+
+    StrictAllocator() = default;
+    explicit StrictAllocator(int allocatorId) : id(allocatorId) {
+    }
+
+    template <typename U>
+    constexpr StrictAllocator(const StrictAllocator<U>& other) noexcept : id(other.id) {
+    }
+
+    T* allocate(std::size_t n) {
+        T* p = static_cast<T*>(::operator new(n * sizeof(T)));
+        live[p] = n;
+        owners[p] = id;
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        auto block = live.find(p);
+        if (block == live.end() || block->second != n) {
+            ++mismatches;
+        }
+        if (block != live.end()) {
+            live.erase(block);
+        }
+        if (owners[p] != id) {
+            ++foreignFrees;
+        }
+        owners.erase(p);
+        ::operator delete(p);
+    }
+
+    bool operator==(const StrictAllocator& other) const {
+        return id == other.id;
+    }
+};
+
+// A StrictAllocator that propagates on copy and move assignment but not on swap, and counts how
+// often it is move-constructed.
+template <typename T>
+struct PropagatingAllocator : StrictAllocator<T> {
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::false_type;
+
+    static inline std::size_t moves = 0;
+
+    PropagatingAllocator() = default;
+    explicit PropagatingAllocator(int allocatorId) : StrictAllocator<T>(allocatorId) {
+    }
+    PropagatingAllocator(const PropagatingAllocator&) = default;
+    PropagatingAllocator(PropagatingAllocator&& other) noexcept : StrictAllocator<T>(other) {
+        ++moves;
+    }
+    PropagatingAllocator& operator=(const PropagatingAllocator&) = default;
+    PropagatingAllocator& operator=(PropagatingAllocator&&) = default;
+
+    template <typename U>
+    constexpr PropagatingAllocator(const PropagatingAllocator<U>& other) noexcept
+        : StrictAllocator<T>(other) {
+    }
+};
+
+template <typename T>
+void exercise_allocator(std::vector<T> values) {
+    using strict_vector = coolstd::vector<T, StrictAllocator<T>>;
+    StrictAllocator<T>::mismatches = 0;
+
+    {
+        strict_vector custom_vec;
+        for (const T& value : values) {
+            custom_vec.push_back(value);
+        }
+        custom_vec.reserve(100);
+        custom_vec.shrink_to_fit();
+        custom_vec.insert(custom_vec.begin() + 1, values.begin(), values.end());
+        custom_vec.erase(custom_vec.begin(), custom_vec.begin() + 3);
+        custom_vec.resize(40, values[0]);
+        custom_vec.resize(5);
+        custom_vec.shrink_to_fit();
+
+        strict_vector copy(custom_vec);
+        strict_vector other(StrictAllocator<T>(1));
+        other = copy;
+        other.assign(50, values[1]);
+        strict_vector moved(std::move(copy));
+        moved = std::move(other);
+        strict_vector elsewhere(std::move(moved), StrictAllocator<T>(2));
+        elsewhere.swap(custom_vec);
+        custom_vec.clear();
+        strict_vector(0).swap(elsewhere);
+
+        REQUIRE(elsewhere.capacity() == 0);
+    }
+
+    REQUIRE(StrictAllocator<T>::mismatches == 0);
+    REQUIRE(StrictAllocator<T>::live.empty());
+}
+
+TEST_CASE("Allocator awareness", "[vector]") {
+    SECTION("Blocks are deallocated with their allocated size") {
+        exercise_allocator<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+        exercise_allocator<std::string>({"one", "two", "three", "four", "five", "six", "seven"});
+    }
+
+    SECTION("Allocators that don't propagate keep their buffers") {
+        using strict_vector = coolstd::vector<std::string, StrictAllocator<std::string>>;
+        strict_vector first({"a", "b", "c"}, StrictAllocator<std::string>(1));
+        strict_vector second(StrictAllocator<std::string>(2));
+
+        second = std::move(first);
+
+        REQUIRE(second.get_allocator().id == 2);
+        REQUIRE_THAT(second, Catch::Matchers::RangeEquals(std::vector<std::string>{"a", "b", "c"}));
+
+        strict_vector third(std::move(second), StrictAllocator<std::string>(3));
+
+        REQUIRE(third.get_allocator().id == 3);
+        REQUIRE(third.size() == 3);
+        REQUIRE(third[2] == "c");
+    }
+
+    SECTION("Copies get a buffer sized to their contents") {
+        coolstd::vector<int> custom_vec{1, 2, 3};
+        custom_vec.reserve(64);
+        coolstd::vector<int> copy(custom_vec);
+
+        REQUIRE(copy.capacity() == 3);
+        REQUIRE(coolstd::vector<int>(0).data() == nullptr);
+    }
+
+    SECTION("Sized constructors free their buffer when an element throws") {
+        using strict_vector = coolstd::vector<ThrowingMove, StrictAllocator<ThrowingMove>>;
+        const ThrowingMove value(7);
+
+        ThrowingMove::copiesUntilThrow = 2;
+        REQUIRE_THROWS_AS(strict_vector(5, value), std::runtime_error);
+        ThrowingMove::copiesUntilThrow = 2;
+        REQUIRE_THROWS_AS(strict_vector({value, value, value, value}), std::runtime_error);
+        ThrowingMove::copiesUntilThrow = -1;
+
+        REQUIRE(StrictAllocator<ThrowingMove>::live.empty());
+        REQUIRE(StrictAllocator<ThrowingMove>::mismatches == 0);
+
+        strict_vector filled(5, value);
+        REQUIRE(filled.size() == 5);
+        REQUIRE(filled.capacity() == 5);
+        REQUIRE(std::all_of(filled.begin(), filled.end(),
+                            [](const ThrowingMove& element) { return element.value == 7; }));
+    }
+}
+
+TEST_CASE("Arena", "[vector]") {
+    SECTION("The newest vector grows in place") {
+        coolstd::arena arena(1 << 16);
+        coolstd::vector<int, coolstd::arena_allocator<int>> custom_vec{
+            coolstd::arena_allocator<int>(arena)};
+
+        custom_vec.push_back(0);
+        const int* data = custom_vec.data();
+        for (int i = 1; i < 1000; ++i) {
+            custom_vec.push_back(i);
+        }
+
+        REQUIRE(custom_vec.data() == data);
+        REQUIRE(custom_vec.capacity() >= 1000);
+        REQUIRE(std::accumulate(custom_vec.begin(), custom_vec.end(), 0) == 999 * 1000 / 2);
+    }
+
+    SECTION("Interleaved vectors and chunk overflow") {
+        coolstd::arena arena(256);
+        coolstd::arena_allocator<std::string> alloc(arena);
+        coolstd::vector<std::string, coolstd::arena_allocator<std::string>> first(alloc);
+        coolstd::vector<std::string, coolstd::arena_allocator<std::string>> second(alloc);
+        std::vector<std::string> std_vec;
+
+        for (int i = 0; i < 500; ++i) {
+            first.push_back(std::to_string(i));
+            second.insert(second.begin(), std::to_string(i));
+            std_vec.push_back(std::to_string(i));
+        }
+
+        REQUIRE_THAT(first, Catch::Matchers::RangeEquals(std_vec));
+        REQUIRE_THAT(second, Catch::Matchers::RangeEquals(std_vec | std::views::reverse));
+    }
+
+    SECTION("Releasing the arena first leaves nothing for the vector to free") {
+        coolstd::arena arena;
+        coolstd::vector<double, coolstd::arena_allocator<double>> custom_vec(
+            100, 1.5, coolstd::arena_allocator<double>(arena));
+
+        arena.release();
+    }
+
+    SECTION("Moving between arenas moves the elements") {
+        coolstd::arena first_arena;
+        coolstd::arena second_arena;
+        coolstd::vector<std::string, coolstd::arena_allocator<std::string>> first(
+            {"x", "y"}, coolstd::arena_allocator<std::string>(first_arena));
+        coolstd::vector<std::string, coolstd::arena_allocator<std::string>> second{
+            coolstd::arena_allocator<std::string>(second_arena)};
+
+        second = std::move(first);
+
+        REQUIRE(second.get_allocator().resource() == &second_arena);
+        REQUIRE_THAT(second, Catch::Matchers::RangeEquals(std::vector<std::string>{"x", "y"}));
+    }
+
+    SECTION("Polymorphic allocator") {
+        char buffer[1024];
+        coolstd::arena arena(buffer, sizeof(buffer));
+        coolstd::pmr::vector<int> custom_vec(&arena);
+
+        for (int i = 0; i < 100; ++i) {
+            custom_vec.push_back(i);
+        }
+
+        REQUIRE(reinterpret_cast<char*>(custom_vec.data()) >= buffer);
+        REQUIRE(reinterpret_cast<char*>(custom_vec.data()) < buffer + sizeof(buffer));
+        REQUIRE(custom_vec[99] == 99);
+
+        arena.reset();
+        coolstd::pmr::vector<int> reused(10, 7, &arena);
+
+        REQUIRE(reinterpret_cast<char*>(reused.data()) == buffer);
+    }
+}
+
+template <typename T>
+void check_simd_kernels() {
+    std::vector<T> buffer(300);
+    const T value = T(93);
+
+    for (std::size_t offset = 0; offset < 4; ++offset) {
+        for (std::size_t count : {0, 1, 7, 8, 31, 32, 33, 64, 100, 257}) {
+            std::vector<T> expected(buffer.size(), T(1));
+            std::fill_n(expected.begin() + std::ptrdiff_t(offset), count, value);
+
+            std::fill(buffer.begin(), buffer.end(), T(1));
+            coolstd::simd::fill(buffer.data() + offset, count, value);
+
+            REQUIRE(buffer == expected);
+        }
+    }
+
+    std::vector<T> lhs(200);
+    std::iota(lhs.begin(), lhs.end(), T(0));
+    for (std::size_t count : {0, 1, 5, 16, 17, 63, 64, 65, 200}) {
+        std::vector<T> rhs(lhs);
+        std::vector<std::size_t> found;
+
+        for (std::size_t position = 0; position <= count; ++position) {
+            if (position < count) {
+                rhs[position] = T(rhs[position] + 1);
+            }
+            found.push_back(coolstd::simd::mismatch(lhs.data(), rhs.data(), count));
+            rhs = lhs;
+        }
+
+        std::vector<std::size_t> expected(count + 1);
+        std::iota(expected.begin(), expected.end(), std::size_t(0));
+        REQUIRE(found == expected);
+    }
+}
+
+TEST_CASE("SIMD kernels", "[simd]") {
+    for (coolstd::simd::isa level :
+         {coolstd::simd::isa::scalar, coolstd::simd::isa::sse2, coolstd::simd::isa::avx2,
+          coolstd::simd::isa::avx512}) {
+        const coolstd::simd::isa selected = coolstd::simd::select(level);
+        INFO(coolstd::simd::name(selected));
+
+        check_simd_kernels<std::uint8_t>();
+        check_simd_kernels<std::int16_t>();
+        check_simd_kernels<int>();
+        check_simd_kernels<std::uint64_t>();
+        check_simd_kernels<float>();
+        check_simd_kernels<double>();
+
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        std::vector<float> lhs(40, 1.0f);
+        std::vector<float> rhs(lhs);
+        lhs[3] = -0.0f;
+        rhs[3] = 0.0f;
+        lhs[21] = rhs[21] = nan;
+
+        REQUIRE(coolstd::simd::mismatch(lhs.data(), rhs.data(), lhs.size()) == 21);
+    }
+
+    coolstd::simd::select(coolstd::simd::isa::avx512);
+}
+
+TEST_CASE("Comparison", "[vector]") {
+    SECTION("Arithmetic elements") {
+        coolstd::vector<int> custom_vec(100, 5);
+        coolstd::vector<int> other(custom_vec);
+
+        REQUIRE(custom_vec == other);
+        REQUIRE((custom_vec <=> other) == std::strong_ordering::equal);
+
+        other[70] = -1;
+        REQUIRE(custom_vec != other);
+        REQUIRE(other < custom_vec);
+
+        other.pop_back();
+        other[70] = 5;
+        REQUIRE(other < custom_vec);
+        REQUIRE(coolstd::vector<int>() < other);
+    }
+
+    SECTION("Unsigned bytes compare as values") {
+        coolstd::vector<std::uint8_t> low(64, 1);
+        coolstd::vector<std::uint8_t> high(low);
+        high[40] = 200;
+
+        REQUIRE(low < high);
+        REQUIRE(high > low);
+    }
+
+    SECTION("Floating point") {
+        coolstd::vector<double> custom_vec{1.0, 0.0, 3.0};
+        coolstd::vector<double> other{1.0, -0.0, 3.0};
+
+        REQUIRE(custom_vec == other);
+
+        other[2] = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE(custom_vec != other);
+        REQUIRE((custom_vec <=> other) == std::partial_ordering::unordered);
+    }
+
+    SECTION("Other element types") {
+        coolstd::vector<std::string> custom_vec{"apple", "banana"};
+        coolstd::vector<std::string> other{"apple", "cherry"};
+
+        REQUIRE(custom_vec != other);
+        REQUIRE(custom_vec < other);
+
+        coolstd::small_vector<int, 4> small{1, 2, 3};
+        REQUIRE(small == coolstd::small_vector<int, 4>{1, 2, 3});
+        REQUIRE(small < coolstd::small_vector<int, 4>{1, 2, 3, 0, 0});
+    }
+
+    SECTION("Fills and assignments") {
+        coolstd::vector<std::int16_t> custom_vec(37, 7);
+        std::vector<std::int16_t> std_vec(37, 7);
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+
+        custom_vec.assign(20, -3);
+        std_vec.assign(20, -3);
+        custom_vec.resize(90, 11);
+        std_vec.resize(90, 11);
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+
+        custom_vec.assign(custom_vec.begin() + 10, custom_vec.end());
+        std_vec.assign(std_vec.begin() + 10, std_vec.end());
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+
+        custom_vec = {1, 2, 3};
+        REQUIRE(custom_vec == coolstd::vector<std::int16_t>{1, 2, 3});
+    }
+}
+
+TEST_CASE("Parallel algorithms", "[par]") {
+    // A small grain forces every algorithm to split even on these sizes.
+    coolstd::par::thread_pool pool(4);
+    const coolstd::par::options opts{&pool, 64};
+
+    coolstd::vector<int> custom_vec(10000);
+    std::iota(custom_vec.begin(), custom_vec.end(), 0);
+    std::vector<int> std_vec(custom_vec.begin(), custom_vec.end());
+
+    SECTION("for_each and transform") {
+        coolstd::par::for_each(custom_vec, [](int& n) { n *= 2; }, opts);
+        std::for_each(std_vec.begin(), std_vec.end(), [](int& n) { n *= 2; });
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+
+        coolstd::vector<long> transformed(custom_vec.size());
+        coolstd::par::transform(custom_vec, transformed.begin(), [](int n) { return n + 1L; },
+                                opts);
+        REQUIRE(transformed.front() == 1);
+        REQUIRE(transformed.back() == 2 * 9999 + 1);
+    }
+
+    SECTION("reduce") {
+        REQUIRE(coolstd::par::reduce(custom_vec, 0L, std::plus<>(), opts) == 9999L * 10000 / 2);
+
+        // Chunks are combined in order, so a non-commutative operation works.
+        coolstd::vector<std::string> words(300, "ab");
+        REQUIRE(coolstd::par::reduce(words, std::string(), std::plus<>(), opts).size() == 600);
+    }
+
+    SECTION("sort") {
+        std::minstd_rand random(42);
+        for (int& n : custom_vec) {
+            n = int(random() % 1000);
+        }
+        std_vec.assign(custom_vec.begin(), custom_vec.end());
+
+        coolstd::par::sort(custom_vec.begin(), custom_vec.end(), std::greater<>(), opts);
+        std::sort(std_vec.begin(), std_vec.end(), std::greater<>());
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+
+        coolstd::vector<std::string> strings;
+        for (int i = 0; i < 1000; ++i) {
+            strings.push_back(std::to_string(random()));
+        }
+        std::vector<std::string> std_strings(strings.begin(), strings.end());
+
+        coolstd::par::sort(strings, std::less<>(), opts);
+        std::sort(std_strings.begin(), std_strings.end());
+        REQUIRE_THAT(strings, Catch::Matchers::RangeEquals(std_strings));
+    }
+
+    SECTION("stable_partition and erase_if") {
+        auto divisible = [](int n) { return n % 3 == 0; };
+
+        auto middle = coolstd::par::stable_partition(custom_vec.begin(), custom_vec.end(),
+                                                     divisible, opts);
+        std::stable_partition(std_vec.begin(), std_vec.end(), divisible);
+        REQUIRE(middle - custom_vec.begin() == 3334);
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+
+        REQUIRE(coolstd::par::erase_if(custom_vec, divisible, opts) == 3334);
+        std::erase_if(std_vec, divisible);
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+    }
+
+    SECTION("Exceptions reach the caller") {
+        auto throwing = [](int n) {
+            if (n == 5000) {
+                throw std::runtime_error("element 5000");
+            }
+        };
+
+        REQUIRE_THROWS_AS(coolstd::par::for_each(custom_vec, throwing, opts), std::runtime_error);
+        REQUIRE(coolstd::par::reduce(custom_vec, 0L, std::plus<>(), opts) == 9999L * 10000 / 2);
+    }
+
+    SECTION("A single-thread pool runs inline") {
+        coolstd::par::thread_pool inline_pool(1);
+        const std::thread::id caller = std::this_thread::get_id();
+        bool same_thread = true;
+
+        auto check = [&](int) {
+            same_thread = same_thread && std::this_thread::get_id() == caller;
+        };
+
+        coolstd::par::for_each(custom_vec, check, {&inline_pool, 16});
+        REQUIRE(same_thread);
+    }
+
+    SECTION("Fixed schedules give every thread the same block each time") {
+        const coolstd::par::options fixed{&pool, 0, coolstd::par::schedule::fixed};
+        std::vector<std::thread::id> first(custom_vec.size());
+        std::vector<std::thread::id> second(custom_vec.size());
+
+        auto record = [&](std::vector<std::thread::id>& ids) {
+            coolstd::par::for_each(
+                custom_vec, [&](int& n) { ids[std::size_t(n)] = std::this_thread::get_id(); },
+                fixed);
+        };
+        record(first);
+        record(second);
+
+        REQUIRE(first == second);
+        REQUIRE(std::set<std::thread::id>(first.begin(), first.end()).size() == 4);
+        REQUIRE(coolstd::par::reduce(custom_vec, 0L, std::plus<>(), fixed) == 9999L * 10000 / 2);
+    }
+
+    SECTION("Parallel construction") {
+        const coolstd::par::options fixed{&pool, 0, coolstd::par::schedule::fixed};
+
+        for (const coolstd::par::options& exec : {opts, fixed}) {
+            coolstd::vector<int> zeros(exec, 100000);
+            REQUIRE(zeros.size() == 100000);
+            REQUIRE(std::count(zeros.begin(), zeros.end(), 0) == 100000);
+
+            coolstd::vector<double> filled(exec, 100000, 1.5);
+            REQUIRE(std::count(filled.begin(), filled.end(), 1.5) == 100000);
+
+            coolstd::vector<int> copied(exec, custom_vec.begin(), custom_vec.end());
+            REQUIRE(copied == custom_vec);
+
+            copied.resize(exec, 30000, 7);
+            REQUIRE(copied.size() == 30000);
+            REQUIRE(copied[9999] == 9999);
+            REQUIRE(std::count(copied.begin() + 10000, copied.end(), 7) == 20000);
+
+            copied.resize(exec, 5);
+            copied.resize(exec, 20000);
+            REQUIRE(copied[4] == 4);
+            REQUIRE(std::count(copied.begin() + 5, copied.end(), 0) == 19995);
+
+            copied.assign(exec, 50000, copied[4]);
+            REQUIRE(std::count(copied.begin(), copied.end(), 4) == 50000);
+            copied.assign(exec, custom_vec.begin(), custom_vec.begin() + 100);
+            REQUIRE(std::equal(copied.begin(), copied.end(), custom_vec.begin()));
+
+            // Strings can throw while being copied, so they are constructed sequentially.
+            coolstd::vector<std::string> strings(exec, 1000, "text");
+            REQUIRE(std::count(strings.begin(), strings.end(), "text") == 1000);
+        }
+    }
+}
+
+TEST_CASE("Small vector", "[small_vector]") {
+    SECTION("Stays inline up to N elements") {
+        coolstd::small_vector<int, 4> custom_vec{1, 2, 3};
+        custom_vec.push_back(4);
+
+        REQUIRE(custom_vec.is_inline());
+        REQUIRE(custom_vec.capacity() == 4);
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(create_range(1, 4)));
+
+        custom_vec.push_back(custom_vec[0]);
+
+        REQUIRE_FALSE(custom_vec.is_inline());
+        REQUIRE(custom_vec.capacity() == 8);
+        REQUIRE(custom_vec.back() == 1);
+    }
+
+    SECTION("Allocators that don't propagate keep their buffers") {
+        using strict_vector = coolstd::small_vector<std::string, 2, StrictAllocator<std::string>>;
+        StrictAllocator<std::string>::mismatches = 0;
+        StrictAllocator<std::string>::foreignFrees = 0;
+
+        {
+            strict_vector first({"a", "b", "c"}, StrictAllocator<std::string>(1));
+            strict_vector second({"d", "e", "f", "g"}, StrictAllocator<std::string>(2));
+            strict_vector third({"h"}, StrictAllocator<std::string>(3));
+
+            first.swap(second);
+            REQUIRE(first.get_allocator().id == 1);
+            REQUIRE_THAT(first, Catch::Matchers::RangeEquals(
+                                    std::vector<std::string>{"d", "e", "f", "g"}));
+            REQUIRE_THAT(second,
+                         Catch::Matchers::RangeEquals(std::vector<std::string>{"a", "b", "c"}));
+
+            swap(second, third);
+            REQUIRE(third.size() == 3);
+            REQUIRE(second.front() == "h");
+
+            third = std::move(first);
+            REQUIRE(third.get_allocator().id == 3);
+            REQUIRE(third.size() == 4);
+            REQUIRE(third.back() == "g");
+
+            strict_vector same({"x", "y", "z"}, StrictAllocator<std::string>(3));
+            const std::string* buffer = same.data();
+            third = std::move(same);
+            REQUIRE(third.data() == buffer);
+        }
+
+        REQUIRE(StrictAllocator<std::string>::mismatches == 0);
+        REQUIRE(StrictAllocator<std::string>::foreignFrees == 0);
+        REQUIRE(StrictAllocator<std::string>::live.empty());
+    }
+
+    SECTION("Allocators propagate as their traits say") {
+        using allocator = PropagatingAllocator<std::string>;
+        using propagating_vector = coolstd::small_vector<std::string, 2, allocator>;
+        StrictAllocator<std::string>::mismatches = 0;
+        StrictAllocator<std::string>::foreignFrees = 0;
+
+        {
+            propagating_vector first({"a", "b", "c"}, allocator(1));
+            propagating_vector second({"d"}, allocator(2));
+
+            first.swap(second);
+            REQUIRE(first.get_allocator().id == 1);
+            REQUIRE(second.get_allocator().id == 2);
+            REQUIRE_THAT(first, Catch::Matchers::RangeEquals(std::vector<std::string>{"d"}));
+            REQUIRE_THAT(second,
+                         Catch::Matchers::RangeEquals(std::vector<std::string>{"a", "b", "c"}));
+
+            const std::size_t moves = allocator::moves;
+            propagating_vector moved(std::move(second));
+            REQUIRE(allocator::moves == moves + 1);
+            REQUIRE(moved.get_allocator().id == 2);
+
+            propagating_vector copy({"x", "y", "z"}, allocator(3));
+            copy = moved;
+            REQUIRE(copy.get_allocator().id == 2);
+            REQUIRE_THAT(copy, Catch::Matchers::RangeEquals(moved));
+        }
+
+        REQUIRE(StrictAllocator<std::string>::mismatches == 0);
+        REQUIRE(StrictAllocator<std::string>::foreignFrees == 0);
+        REQUIRE(StrictAllocator<std::string>::live.empty());
+    }
+
+    SECTION("Resize and overwrite") {
+        coolstd::small_vector<char, 16> buffer;
+        buffer.resize_and_overwrite(32, [](char* data, std::size_t) {
+            std::memcpy(data, "payload", 7);
+            return 7;
+        });
+
+        REQUIRE_FALSE(buffer.is_inline());
+        REQUIRE(std::string(buffer.begin(), buffer.end()) == "payload");
+    }
+
+    SECTION("append_range and insert_range") {
+        coolstd::small_vector<int, 4> custom_vec;
+        custom_vec.append_range(std::views::iota(3, 6));
+        custom_vec.insert_range(custom_vec.begin(), std::list<int>{1, 2});
+
+        std::istringstream input("6 7");
+        custom_vec.append_range(std::views::istream<int>(input));
+
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(create_range(1, 7)));
+    }
+
+    SECTION("Shares vector's iterators") {
+        STATIC_REQUIRE(std::is_same_v<coolstd::small_vector<int, 4>::iterator,
+                                      coolstd::vector<int>::iterator>);
+        STATIC_REQUIRE(std::is_same_v<coolstd::small_vector<int, 4>::const_iterator,
+                                      coolstd::vector<int>::const_iterator>);
+    }
+
+    SECTION("Modifiers match std::vector across the spill") {
+        coolstd::small_vector<std::string, 3> custom_vec;
+        std::vector<std::string> std_vec;
+
+        for (int i = 0; i < 20; ++i) {
+            custom_vec.insert(custom_vec.begin() + i / 2, std::to_string(i));
+            std_vec.insert(std_vec.begin() + i / 2, std::to_string(i));
+        }
+        custom_vec.insert(custom_vec.begin() + 1, 2, custom_vec[5]);
+        std_vec.insert(std_vec.begin() + 1, 2, std_vec[5]);
+        custom_vec.insert(custom_vec.end() - 3, {"a", "b"});
+        std_vec.insert(std_vec.end() - 3, {"a", "b"});
+        custom_vec.erase(custom_vec.begin() + 2, custom_vec.begin() + 7);
+        std_vec.erase(std_vec.begin() + 2, std_vec.begin() + 7);
+        custom_vec.erase(custom_vec.begin());
+        std_vec.erase(std_vec.begin());
+
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+
+        custom_vec.resize(2);
+        custom_vec.shrink_to_fit();
+
+        REQUIRE(custom_vec.is_inline());
+        REQUIRE(custom_vec.size() == 2);
+        REQUIRE(custom_vec[1] == std_vec[1]);
+    }
+
+    SECTION("Inline insert of an aliased element") {
+        coolstd::small_vector<int, 8> custom_vec{1, 2, 3};
+        custom_vec.insert(custom_vec.begin(), custom_vec[2]);
+        custom_vec.insert(custom_vec.begin(), 2, custom_vec.back());
+
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std::vector<int>{3, 3, 3, 1, 2, 3}));
+    }
+
+    SECTION("Copy, move and swap") {
+        coolstd::small_vector<std::unique_ptr<int>, 2> inline_vec;
+        inline_vec.push_back(std::make_unique<int>(1));
+        coolstd::small_vector<std::unique_ptr<int>, 2> heap_vec;
+        for (int i = 0; i < 5; ++i) {
+            heap_vec.push_back(std::make_unique<int>(10 + i));
+        }
+        const int* heap_data = heap_vec[0].get();
+
+        inline_vec.swap(heap_vec);
+
+        REQUIRE(inline_vec.size() == 5);
+        REQUIRE(inline_vec[0].get() == heap_data);
+        REQUIRE(heap_vec.is_inline());
+        REQUIRE(*heap_vec[0] == 1);
+
+        auto moved = std::move(heap_vec);
+
+        REQUIRE(moved.is_inline());
+        REQUIRE(*moved[0] == 1);
+        REQUIRE(heap_vec.empty());
+
+        coolstd::small_vector<std::string, 2> strings{"x", "y", "z"};
+        coolstd::small_vector<std::string, 2> copy = strings;
+        copy = {"only"};
+
+        REQUIRE(strings.size() == 3);
+        REQUIRE(strings[2] == "z");
+        REQUIRE_FALSE(copy.is_inline());
+        REQUIRE(copy.front() == "only");
+    }
+}
+
+TEST_CASE("Concurrent vector", "[concurrent_vector]") {
+    SECTION("Elements never move") {
+        coolstd::concurrent_vector<int> custom_vec;
+        const int* first = &*custom_vec.push_back(0);
+
+        bool returned_new_element = true;
+        for (int i = 1; i < 10000; ++i) {
+            returned_new_element = returned_new_element && *custom_vec.push_back(i) == i;
+        }
+
+        REQUIRE(returned_new_element);
+        REQUIRE(&custom_vec[0] == first);
+        REQUIRE(custom_vec.size() == 10000);
+        REQUIRE(custom_vec.capacity() >= 10000);
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(create_range(0, 9999)));
+        REQUIRE(std::is_sorted(custom_vec.begin(), custom_vec.end()));
+        REQUIRE(custom_vec.end() - custom_vec.begin() == 10000);
+        REQUIRE_THROWS_AS(custom_vec.at(10000), std::out_of_range);
+    }
+
+    SECTION("grow_by spans segments") {
+        coolstd::concurrent_vector<std::string> strings;
+        strings.push_back("first");
+
+        auto grown = strings.grow_by(500, "filler");
+        REQUIRE(grown - strings.begin() == 1);
+        REQUIRE(strings.size() == 501);
+        REQUIRE(std::count(strings.begin(), strings.end(), "filler") == 500);
+
+        strings.grow_by(3);
+        REQUIRE(strings.back().empty());
+
+        coolstd::concurrent_vector<std::string> copy = strings;
+        strings.clear();
+        REQUIRE(strings.empty());
+        REQUIRE(copy.size() == 504);
+        REQUIRE(copy.front() == "first");
+
+        strings = std::move(copy);
+        REQUIRE(strings.size() == 504);
+        REQUIRE(copy.empty());
+    }
+
+    SECTION("Concurrent producers") {
+        coolstd::concurrent_vector<int> custom_vec;
+        std::vector<std::thread> producers;
+
+        for (int t = 0; t < 4; ++t) {
+            producers.emplace_back([&custom_vec, t] {
+                for (int i = 0; i < 5000; ++i) {
+                    custom_vec.push_back(t * 5000 + i);
+                }
+                custom_vec.grow_by(100, -1);
+            });
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+
+        std::vector<int> values(custom_vec.begin(), custom_vec.end());
+        std::sort(values.begin(), values.end());
+
+        REQUIRE(values.size() == 20400);
+        REQUIRE(std::count(values.begin(), values.end(), -1) == 400);
+        REQUIRE(std::equal(values.begin() + 400, values.end(),
+                           create_range(0, 19999).begin()));
+    }
+
+    SECTION("A failed construction still fills its slot") {
+        struct Picky {
+            int value = 0;
+
+            Picky() noexcept = default;
+            explicit Picky(int n) : value(n) {
+                if (n < 0) {
+                    throw std::invalid_argument("negative");
+                }
+            }
+        };
+
+        coolstd::concurrent_vector<Picky> custom_vec;
+        custom_vec.emplace_back(1);
+
+        REQUIRE_THROWS_AS(custom_vec.emplace_back(-1), std::invalid_argument);
+        REQUIRE(custom_vec.size() == 2);
+        REQUIRE(custom_vec[1].value == 0);
+    }
+}
+
+TEST_CASE("Segmented vector", "[segmented_vector]") {
+    using Small = coolstd::segmented_vector<int, std::allocator<int>, 8>;
+
+    SECTION("Growth never moves elements") {
+        Small custom_vec;
+        custom_vec.push_back(0);
+        const int* first = &custom_vec[0];
+
+        for (int i = 1; i < 1000; ++i) {
+            custom_vec.push_back(i);
+        }
+
+        REQUIRE(&custom_vec[0] == first);
+        REQUIRE(custom_vec.capacity() == 1000);
+        REQUIRE(custom_vec.segment_count() == 125);
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(create_range(0, 999)));
+        REQUIRE(custom_vec.segment(1)[0] == 8);
+    }
+
+    SECTION("Iterators work with the standard algorithms") {
+        static_assert(std::random_access_iterator<Small::iterator>);
+        static_assert(std::random_access_iterator<Small::const_iterator>);
+
+        auto range = create_range(1, 100);
+        Small custom_vec(range.begin(), range.end());
+        std::reverse(custom_vec.begin(), custom_vec.end());
+        REQUIRE(custom_vec.front() == 100);
+
+        std::sort(custom_vec.begin(), custom_vec.end());
+        REQUIRE(std::is_sorted(custom_vec.cbegin(), custom_vec.cend()));
+        REQUIRE(custom_vec.end() - custom_vec.begin() == 100);
+        REQUIRE(*(custom_vec.rbegin() + 1) == 99);
+        REQUIRE(std::lower_bound(custom_vec.begin(), custom_vec.end(), 42) - custom_vec.begin() ==
+                41);
+    }
+
+    SECTION("resize, copy and compare") {
+        coolstd::segmented_vector<std::string, std::allocator<std::string>, 4> strings(10, "ab");
+        strings.resize(3);
+        strings.resize(21, "c");
+
+        REQUIRE(strings.size() == 21);
+        REQUIRE(strings[2] == "ab");
+        REQUIRE(strings[20] == "c");
+
+        auto copy = strings;
+        REQUIRE(copy == strings);
+        copy.push_back("z");
+        REQUIRE(strings < copy);
+
+        strings.shrink_to_fit();
+        REQUIRE(strings.capacity() == 24);
+
+        strings = std::move(copy);
+        REQUIRE(strings.size() == 22);
+        REQUIRE(strings.back() == "z");
+
+        strings.pop_back();
+        strings.clear();
+        REQUIRE(strings.empty());
+        REQUIRE(strings.capacity() == 24);
+    }
+}
+
+TEST_CASE("Mapped file", "[mapped_file]") {
+    const std::string path =
+        (std::filesystem::temp_directory_path() / "coolstd_mapped_file_test.bin").string();
+    std::filesystem::remove(path);
+
+    {
+        coolstd::mapped_file file(path.c_str(), coolstd::map_mode::read_write);
+        auto custom_vec = coolstd::open_mapped<float>(file);
+        REQUIRE(custom_vec.empty());
+
+        for (int i = 0; i < 1000; ++i) {
+            custom_vec.push_back(float(i));
+        }
+        const float* data = custom_vec.data();
+        custom_vec.resize(100000, 0.5f);
+
+        // Growth within the reservation is an ftruncate: the buffer stays where it is.
+        REQUIRE(custom_vec.data() == data);
+        REQUIRE(static_cast<const void*>(data) == file.data());
+        custom_vec.shrink_to_fit();
+        REQUIRE(file.size() == 100000 * sizeof(float));
+        file.advise(coolstd::advice::sequential);
+    }
+
+    SECTION("Read-only and copy-on-write views") {
+        {
+            coolstd::mapped_file file(path.c_str());
+            const auto custom_vec = coolstd::open_mapped<float>(file);
+
+            REQUIRE(custom_vec.size() == 100000);
+            REQUIRE(static_cast<const void*>(custom_vec.data()) == file.data());
+            REQUIRE(custom_vec[999] == 999.0f);
+            REQUIRE(custom_vec.back() == 0.5f);
+        }
+        {
+            coolstd::mapped_file file(path.c_str(), coolstd::map_mode::copy_on_write);
+            auto custom_vec = coolstd::open_mapped<float>(file);
+            custom_vec[0] = 42.0f;
+
+            REQUIRE_THROWS_AS(custom_vec.push_back(1.0f), std::length_error);
+            REQUIRE(custom_vec.size() == 100000);
+        }
+
+        coolstd::mapped_file file(path.c_str());
+        REQUIRE(coolstd::open_mapped<float>(file).front() == 0.0f);
+
+        // The file is adopted as it is, whatever capacities the policy would round up to.
+        const auto rounded = coolstd::open_mapped<float, coolstd::growth::size_class<>>(file);
+        REQUIRE(rounded.size() == 100000);
+        REQUIRE(rounded.capacity() == 100000);
+    }
+
+    SECTION("Growth past the reservation remaps") {
+        coolstd::mapped_file file(path.c_str(), coolstd::map_mode::read_write, 4096);
+        auto custom_vec = coolstd::open_mapped<std::int32_t>(file);
+
+        // The file's 100000 floats are adopted as they are; the new elements follow them.
+        custom_vec.resize(1 << 22, 7);
+        REQUIRE(custom_vec[100000] == 7);
+        REQUIRE(custom_vec.back() == 7);
+        REQUIRE(file.size() >= custom_vec.size() * sizeof(std::int32_t));
+    }
+
+    SECTION("Insertions before the end grow the one block") {
+        coolstd::mapped_file file(path.c_str(), coolstd::map_mode::read_write);
+        auto custom_vec = coolstd::open_mapped<float>(file);
+        custom_vec.shrink_to_fit();
+        REQUIRE(custom_vec.size() == custom_vec.capacity());
+
+        custom_vec.insert(custom_vec.begin(), 5, 42.0f);
+        REQUIRE(custom_vec.size() == 100005);
+        REQUIRE(custom_vec[4] == 42.0f);
+        REQUIRE(custom_vec[5 + 999] == 999.0f);
+
+        custom_vec.shrink_to_fit();
+        const std::vector<float> values{-1.0f, -2.0f, -3.0f};
+        custom_vec.insert(custom_vec.begin() + 1, values.begin(), values.end());
+        REQUIRE(custom_vec[0] == 42.0f);
+        REQUIRE(custom_vec[3] == -3.0f);
+        REQUIRE(custom_vec[4] == 42.0f);
+        REQUIRE(custom_vec.back() == 0.5f);
+
+        // The value is an element, read before the block grows.
+        custom_vec.shrink_to_fit();
+        custom_vec.resize(custom_vec.size() + 10, custom_vec[2]);
+        REQUIRE(custom_vec.back() == -2.0f);
+        REQUIRE(static_cast<const void*>(custom_vec.data()) == file.data());
+    }
+
+    SECTION("Assignment past capacity grows the one block") {
+        coolstd::mapped_file file(path.c_str(), coolstd::map_mode::read_write);
+        auto custom_vec = coolstd::open_mapped<float>(file);
+        custom_vec.shrink_to_fit();
+
+        const std::vector<float> big(150000, 2.0f);
+        custom_vec.assign(big.begin(), big.end());
+        REQUIRE(custom_vec.size() == 150000);
+        REQUIRE(custom_vec.back() == 2.0f);
+
+        custom_vec.shrink_to_fit();
+        custom_vec.assign(200000, 3.0f);
+        REQUIRE(custom_vec.size() == 200000);
+        REQUIRE(custom_vec.front() == 3.0f);
+
+        const std::string other_path = path + ".copy";
+        {
+            coolstd::mapped_file other_file(other_path.c_str(), coolstd::map_mode::read_write);
+            auto copy = coolstd::open_mapped<float>(other_file);
+            copy.push_back(1.0f);
+            copy = custom_vec;
+            REQUIRE(copy.size() == 200000);
+            REQUIRE(copy[199999] == 3.0f);
+        }
+        std::filesystem::remove(other_path);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Serialization", "[serialize]") {
+    coolstd::vector<double> custom_vec(1000);
+    std::iota(custom_vec.begin(), custom_vec.end(), 0.5);
+
+    SECTION("Round trip through a stream") {
+        std::stringstream buffer;
+        coolstd::write_to(buffer, custom_vec);
+        REQUIRE(buffer.str().size() == 64 + 1000 * sizeof(double));
+
+        coolstd::vector<double> loaded{1.0, 2.0};
+        coolstd::read_from(buffer, loaded);
+        REQUIRE(loaded == custom_vec);
+
+        std::stringstream empty;
+        coolstd::write_to(empty, coolstd::vector<double>());
+        coolstd::read_from(empty, loaded);
+        REQUIRE(loaded.empty());
+    }
+
+    SECTION("Round trip through a file descriptor") {
+        std::FILE* file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        const int fd = fileno(file);
+
+        coolstd::write_to(fd, custom_vec);
+        REQUIRE(lseek(fd, 0, SEEK_SET) == 0);
+
+        coolstd::vector<double> loaded;
+        coolstd::read_from(fd, loaded);
+        REQUIRE(loaded == custom_vec);
+        std::fclose(file);
+    }
+
+    SECTION("Headers are checked") {
+        std::stringstream buffer;
+        coolstd::write_to(buffer, custom_vec);
+        const std::string bytes = buffer.str();
+
+        coolstd::vector<float> floats{1.0f};
+        std::stringstream wrong_type(bytes);
+        REQUIRE_THROWS_AS(coolstd::read_from(wrong_type, floats), coolstd::serialization_error);
+        REQUIRE(floats.size() == 1);
+
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 8));
+        coolstd::vector<double> loaded;
+        REQUIRE_THROWS_AS(coolstd::read_from(truncated, loaded), coolstd::serialization_error);
+
+        std::stringstream garbage("definitely not a vector header....");
+        REQUIRE_THROWS_AS(coolstd::read_from(garbage, loaded), coolstd::serialization_error);
+
+        // Fields that would have the reader skip or allocate absurd amounts are rejected before
+        // the vector is touched.
+        auto patched = [&](std::size_t offset, std::uint64_t value) {
+            std::string corrupt = bytes;
+            std::memcpy(corrupt.data() + offset, &value, sizeof(value));
+            return std::stringstream(corrupt);
+        };
+        coolstd::vector<double> kept{1.0, 2.0};
+        std::stringstream far_payload = patched(24, std::uint64_t(1) << 40);
+        REQUIRE_THROWS_AS(coolstd::read_from(far_payload, kept), coolstd::serialization_error);
+        std::stringstream huge_count =
+            patched(16, std::numeric_limits<std::uint64_t>::max() / sizeof(double));
+        REQUIRE_THROWS_AS(coolstd::read_from(huge_count, kept), coolstd::serialization_error);
+
+        std::FILE* file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        const std::string corrupt = patched(24, std::uint64_t(1) << 40).str();
+        REQUIRE(::write(fileno(file), corrupt.data(), corrupt.size()) == ssize_t(corrupt.size()));
+        REQUIRE(lseek(fileno(file), 0, SEEK_SET) == 0);
+        REQUIRE_THROWS_AS(coolstd::read_from(fileno(file), kept), coolstd::serialization_error);
+        std::fclose(file);
+        REQUIRE(kept == coolstd::vector<double>{1.0, 2.0});
+    }
+
+    SECTION("Foreign byte order is swapped for arithmetic types") {
+        coolstd::vector<std::uint32_t> values{0x01020304u, 0xA0B0C0D0u};
+        std::stringstream buffer;
+        coolstd::write_to(buffer, values);
+
+        // Rewrite the header and payload as the other byte order would have.
+        std::string bytes = buffer.str();
+        auto flip = [&](std::size_t offset, std::size_t size) {
+            std::reverse(bytes.begin() + std::ptrdiff_t(offset),
+                         bytes.begin() + std::ptrdiff_t(offset + size));
+        };
+        bytes[6] = char(3 - bytes[6]);
+        for (auto [offset, size] : {std::pair{4, 2}, {8, 4}, {12, 4}, {16, 8}, {24, 8}, {64, 4},
+                                    {68, 4}}) {
+            flip(std::size_t(offset), std::size_t(size));
+        }
+
+        std::stringstream foreign(bytes);
+        coolstd::vector<std::uint32_t> loaded;
+        coolstd::read_from(foreign, loaded);
+        REQUIRE(loaded == values);
+    }
+
+    SECTION("Views of a mapped file") {
+        const std::string path =
+            (std::filesystem::temp_directory_path() / "coolstd_serialize_test.bin").string();
+        {
+            std::ofstream out(path, std::ios::binary);
+            coolstd::write_to(out, custom_vec);
+        }
+
+        coolstd::mapped_file file(path.c_str());
+        const coolstd::vector_view<double> view(file.data(), file.size());
+
+        REQUIRE(view.size() == 1000);
+        REQUIRE(static_cast<const void*>(view.data()) == file.data() + 64);
+        REQUIRE(std::equal(view.begin(), view.end(), custom_vec.begin(), custom_vec.end()));
+        REQUIRE(view.span().back() == 999.5);
+
+        REQUIRE_THROWS_AS(coolstd::vector_view<double>(file.data(), 100),
+                          coolstd::serialization_error);
+        REQUIRE_THROWS_AS(coolstd::vector_view<float>(file.data(), file.size()),
+                          coolstd::serialization_error);
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("Aligned allocation", "[allocators]") {
+    auto alignedTo = [](const void* ptr, std::size_t alignment) {
+        return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+    };
+
+    SECTION("aligned_allocator") {
+        coolstd::vector<char, coolstd::aligned_allocator<char>> custom_vec;
+        for (int i = 0; i < 1000; ++i) {
+            custom_vec.push_back(char(i));
+            REQUIRE(alignedTo(custom_vec.data(), 64));
+        }
+        custom_vec.shrink_to_fit();
+        REQUIRE(alignedTo(custom_vec.data(), 64));
+        REQUIRE(custom_vec[999] == char(999));
+
+        coolstd::vector<double, coolstd::aligned_allocator<double, 4096>> page_aligned(3, 1.5);
+        REQUIRE(alignedTo(page_aligned.data(), 4096));
+        REQUIRE(page_aligned == coolstd::vector<double, coolstd::aligned_allocator<double, 4096>>(
+                                    {1.5, 1.5, 1.5}));
+
+        using Rebound = std::allocator_traits<
+            coolstd::aligned_allocator<char, 128>>::rebind_alloc<std::string>;
+        STATIC_REQUIRE(std::is_same_v<Rebound, coolstd::aligned_allocator<std::string, 128>>);
+    }
+
+    SECTION("huge_page_allocator") {
+        coolstd::vector<int, coolstd::huge_page_allocator<int>> small{1, 2, 3};
+        REQUIRE(alignedTo(small.data(), 64));
+
+        coolstd::vector<int, coolstd::huge_page_allocator<int>> large(1 << 20, 7);
+        REQUIRE(alignedTo(large.data(), std::size_t(2) << 20));
+        REQUIRE(large.capacity() == large.size());
+        large.push_back(8);
+        REQUIRE(large.capacity() % ((std::size_t(2) << 20) / sizeof(int)) == 0);
+        REQUIRE(large[1 << 19] == 7);
+        REQUIRE(large.back() == 8);
+
+        large.resize(10);
+        large.shrink_to_fit();
+        REQUIRE(large.capacity() == 10);
+        REQUIRE(alignedTo(large.data(), 64));
+    }
+
+    SECTION("huge_page_allocator with sizes that don't divide a page") {
+        struct Triple {
+            char bytes[3];
+        };
+
+        // Just past the mapping threshold: the reported capacity ends short of the mapping's end
+        // and must still be deallocated as a mapping.
+        coolstd::vector<Triple, coolstd::huge_page_allocator<Triple>> custom_vec;
+        custom_vec.reserve((std::size_t(1) << 20) / 3 + 1);
+        REQUIRE(custom_vec.capacity() == (std::size_t(2) << 20) / 3);
+        custom_vec.resize(custom_vec.capacity(), Triple{{1, 2, 3}});
+        REQUIRE(custom_vec.back().bytes[2] == 3);
+    }
+}
+
+TEST_CASE("SoA vector", "[soa_vector]") {
+    coolstd::soa_vector<float, int, std::string> custom_vec{{1.5f, 1, "one"}, {2.5f, 2, "two"}};
+
+    SECTION("Records and columns") {
+        custom_vec.emplace_back(3.5f, 3, "three");
+        custom_vec.push_back({4.5f, 4, "four"});
+
+        REQUIRE(custom_vec.size() == 4);
+        REQUIRE(custom_vec[2] == std::tuple(3.5f, 3, std::string("three")));
+        REQUIRE(std::get<2>(custom_vec.back()) == "four");
+
+        for (float& x : custom_vec.get<0>()) {
+            x *= 2;
+        }
+        for (auto [x, n, name] : custom_vec) {
+            n += int(x);
+        }
+
+        const auto& const_vec = custom_vec;
+        REQUIRE_THAT(std::vector<int>(const_vec.get<1>().begin(), const_vec.get<1>().end()),
+                     Catch::Matchers::Equals(std::vector<int>{4, 7, 10, 13}));
+        REQUIRE(const_vec.get<2>().size() == 4);
+        REQUIRE(std::get<0>(*(const_vec.end() - 1)) == 9.0f);
+        REQUIRE_THROWS_AS(const_vec.at(4), std::out_of_range);
+    }
+
+    SECTION("Resizing and erasing keep the columns in step") {
+        custom_vec.resize(5, {0.5f, 9, "nine"});
+        REQUIRE(custom_vec.size() == 5);
+        REQUIRE(custom_vec.capacity() >= 5);
+        REQUIRE(std::get<2>(custom_vec[4]) == "nine");
+
+        custom_vec.erase(custom_vec.begin() + 1, custom_vec.begin() + 3);
+        REQUIRE(custom_vec.size() == 3);
+        REQUIRE(custom_vec[1] == std::tuple(0.5f, 9, std::string("nine")));
+        REQUIRE(custom_vec.get<2>().size() == 3);
+
+        custom_vec.pop_back();
+        custom_vec.shrink_to_fit();
+        coolstd::soa_vector<float, int, std::string> copy = custom_vec;
+        REQUIRE(copy == custom_vec);
+
+        custom_vec.clear();
+        REQUIRE(custom_vec.empty());
+        REQUIRE(copy.size() == 2);
+    }
+
+    SECTION("A throwing field leaves the other columns unchanged") {
+        coolstd::soa_vector<int, ThrowingMove> throwing_vec;
+        throwing_vec.emplace_back(1, ThrowingMove(1));
+        throwing_vec.reserve(8);
+
+        ThrowingMove::copiesUntilThrow = 0;
+        const ThrowingMove value(2);
+        REQUIRE_THROWS_AS(throwing_vec.emplace_back(2, value), std::runtime_error);
+        REQUIRE(throwing_vec.size() == 1);
+        REQUIRE(throwing_vec.get<0>().size() == 1);
+
+        REQUIRE_THROWS_AS(throwing_vec.resize(4, {3, ThrowingMove(3)}), std::runtime_error);
+        REQUIRE(throwing_vec.size() == 1);
+        REQUIRE(std::get<1>(throwing_vec[0]).value == 1);
+        ThrowingMove::copiesUntilThrow = -1;
+    }
+}
+
+TEST_CASE("Bulk erasure", "[vector]") {
+    SECTION("Insert copies of a value within capacity") {
+        // The tail of strings shifts over live elements, and past the old end when the gap is
+        // longer than the tail.
+        for (std::size_t count : {1, 2, 3, 5}) {
+            std::vector<std::string> std_vec{"a", "b", "c", "d"};
+            coolstd::vector<std::string> custom_vec(std_vec.begin(), std_vec.end());
+            custom_vec.reserve(16);
+
+            std_vec.insert(std_vec.begin() + 1, count, "x");
+            custom_vec.insert(custom_vec.begin() + 1, count, "x");
+            REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+        }
+    }
+
+    SECTION("Unordered erase") {
+        coolstd::vector<std::string> custom_vec{"a", "b", "c", "d"};
+
+        auto it = custom_vec.erase_unordered(custom_vec.begin() + 1);
+        REQUIRE(*it == "d");
+        REQUIRE(custom_vec == coolstd::vector<std::string>{"a", "d", "c"});
+        it = custom_vec.erase_unordered(custom_vec.end() - 1);
+        REQUIRE(it == custom_vec.end());
+        REQUIRE(custom_vec == coolstd::vector<std::string>{"a", "d"});
+
+        coolstd::vector<int> int_vec{1, 2, 3};
+        REQUIRE(*int_vec.erase_unordered(int_vec.begin()) == 3);
+        REQUIRE(int_vec == coolstd::vector<int>{3, 2});
+    }
+
+    SECTION("Erase if") {
+        std::vector<int> std_vec = create_range(0, 99);
+        coolstd::vector<int> custom_vec(std_vec.begin(), std_vec.end());
+        coolstd::vector<std::string> string_vec;
+        for (int value : std_vec) {
+            string_vec.push_back(std::to_string(value));
+        }
+        auto drop = [](int value) { return value % 2 != 0 || value % 7 == 0; };
+
+        std_vec.erase(std::remove_if(std_vec.begin(), std_vec.end(), drop), std_vec.end());
+        REQUIRE(erase_if(custom_vec, drop) == 100 - std_vec.size());
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+        REQUIRE(erase_if(string_vec, [&](const std::string& s) { return drop(std::stoi(s)); }) ==
+                100 - std_vec.size());
+        REQUIRE(string_vec.size() == std_vec.size());
+        REQUIRE(string_vec.back() == std::to_string(std_vec.back()));
+
+        REQUIRE(erase(custom_vec, 4) == 1);
+        REQUIRE(erase(custom_vec, 5) == 0);
+        REQUIRE(custom_vec[0] == 2);
+        REQUIRE(custom_vec[1] == 6);
+        REQUIRE(custom_vec[2] == 8);
+    }
+
+    SECTION("Erase if with a throwing predicate") {
+        coolstd::vector<std::string> custom_vec{"a", "x", "b", "x", "c", "x"};
+        int calls = 0;
+        auto pred = [&](const std::string& s) {
+            if (++calls == 4) {
+                throw std::runtime_error("predicate");
+            }
+            return s == "x";
+        };
+
+        // The first x is erased; everything from the element that threw on is kept.
+        REQUIRE_THROWS_AS(erase_if(custom_vec, pred), std::runtime_error);
+        REQUIRE(custom_vec == coolstd::vector<std::string>{"a", "b", "x", "c", "x"});
+    }
+
+    SECTION("Erase indices") {
+        coolstd::vector<std::string> custom_vec{"a", "b", "c", "d", "e", "f"};
+
+        REQUIRE(custom_vec.erase_indices(std::vector<int>{0, 2, 2, 3, 5}) == 4);
+        REQUIRE(custom_vec == coolstd::vector<std::string>{"b", "e"});
+        REQUIRE(custom_vec.erase_indices(std::vector<std::size_t>{}) == 0);
+        REQUIRE(custom_vec.size() == 2);
+
+        std::vector<int> std_vec = create_range(0, 999);
+        coolstd::vector<int> int_vec(std_vec.begin(), std_vec.end());
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i < 1000; i += 1 + i % 5) {
+            indices.push_back(i);
+        }
+        for (auto i = indices.rbegin(); i != indices.rend(); ++i) {
+            std_vec.erase(std_vec.begin() + std::ptrdiff_t(*i));
+        }
+        REQUIRE(int_vec.erase_indices(indices) == indices.size());
+        REQUIRE_THAT(int_vec, Catch::Matchers::RangeEquals(std_vec));
+    }
+}
+
+TEST_CASE("Incremental vector", "[incremental_vector]") {
+    SECTION("Migration") {
+        coolstd::incremental_vector<int> custom_vec;
+        std::vector<int> std_vec;
+
+        for (int i = 0; i < 1000; ++i) {
+            const bool full = custom_vec.size() == custom_vec.capacity();
+            custom_vec.push_back(i);
+            std_vec.push_back(i);
+
+            // Growth starts a migration, which is over before the new buffer is full.
+            if (full && i > 1) {
+                REQUIRE(custom_vec.migrating());
+            }
+            if (custom_vec.size() == custom_vec.capacity()) {
+                REQUIRE_FALSE(custom_vec.migrating());
+            }
+            REQUIRE(custom_vec.back() == i);
+            REQUIRE(custom_vec[std::size_t(i) / 2] == i / 2);
+        }
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+        REQUIRE(std::equal(custom_vec.rbegin(), custom_vec.rend(), std_vec.rbegin()));
+
+        custom_vec.push_back(1000);
+        REQUIRE(custom_vec.migrating());
+        REQUIRE(std::equal(std_vec.begin(), std_vec.end(), custom_vec.data()));
+        REQUIRE_FALSE(custom_vec.migrating());
+    }
+
+    SECTION("Popping into the old buffer") {
+        coolstd::incremental_vector<std::string> custom_vec;
+        std::vector<std::string> std_vec;
+        std::mt19937 rng(7);
+
+        for (int i = 0; i < 5000; ++i) {
+            if (rng() % 3 == 0 && !std_vec.empty()) {
+                custom_vec.pop_back();
+                std_vec.pop_back();
+            } else {
+                custom_vec.push_back(std::to_string(i) + " with a heap buffer");
+                std_vec.push_back(std::to_string(i) + " with a heap buffer");
+            }
+            REQUIRE(custom_vec.size() == std_vec.size());
+        }
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+
+        // An element of the vector itself, still in the old buffer, can be pushed.
+        while (!custom_vec.migrating()) {
+            custom_vec.push_back("x");
+        }
+        custom_vec.push_back(custom_vec.front());
+        REQUIRE(custom_vec.back() == std_vec.front());
+
+        custom_vec.clear();
+        REQUIRE(custom_vec.empty());
+        REQUIRE_FALSE(custom_vec.migrating());
+    }
+
+    SECTION("Copy, move and compare") {
+        coolstd::incremental_vector<std::string> custom_vec(33, "a");
+        custom_vec.push_back("b");
+        REQUIRE(custom_vec.migrating());
+
+        coolstd::incremental_vector<std::string> copy = custom_vec;
+        REQUIRE(copy == custom_vec);
+        REQUIRE_FALSE(copy.migrating());
+        copy.back() = "c";
+        REQUIRE(custom_vec < copy);
+
+        coolstd::incremental_vector<std::string> moved = std::move(custom_vec);
+        REQUIRE(custom_vec.empty());
+        REQUIRE(moved.migrating());
+        REQUIRE(moved.back() == "b");
+        custom_vec = std::move(moved);
+        swap(custom_vec, copy);
+        REQUIRE(custom_vec.back() == "c");
+        REQUIRE(copy.back() == "b");
+        REQUIRE(copy.at(0) == "a");
+        REQUIRE_THROWS_AS(copy.at(34), std::out_of_range);
+    }
+
+    SECTION("Exception safety") {
+        // ThrowingMove relocates by copying, and the copies can be made to fail.
+        coolstd::incremental_vector<ThrowingMove> custom_vec;
+        for (int i = 0; i < 9; ++i) {
+            custom_vec.emplace_back(i);
+        }
+        REQUIRE(custom_vec.migrating());
+
+        ThrowingMove::copiesUntilThrow = 0;
+        REQUIRE_THROWS_AS(custom_vec.emplace_back(9), std::runtime_error);
+        ThrowingMove::copiesUntilThrow = -1;
+        REQUIRE(custom_vec.size() == 9);
+        for (int i = 0; i < 9; ++i) {
+            REQUIRE(custom_vec[std::size_t(i)].value == i);
+        }
+
+        custom_vec.emplace_back(9);
+        REQUIRE(custom_vec.back().value == 9);
+    }
+}
+
+TEST_CASE("Devector", "[devector]") {
+    SECTION("Both ends") {
+        coolstd::devector<std::string> custom_vec;
+        std::deque<std::string> std_deque;
+        std::mt19937 rng(11);
+
+        for (int i = 0; i < 5000; ++i) {
+            const std::string value = std::to_string(i) + " with a heap buffer";
+
+            switch (rng() % 5) {
+                case 0:
+                    custom_vec.push_front(value);
+                    std_deque.push_front(value);
+                    break;
+                case 1:
+                case 2:
+                    custom_vec.push_back(value);
+                    std_deque.push_back(value);
+                    break;
+                case 3:
+                    if (!std_deque.empty()) {
+                        custom_vec.pop_front();
+                        std_deque.pop_front();
+                    }
+                    break;
+                default:
+                    if (!std_deque.empty()) {
+                        custom_vec.pop_back();
+                        std_deque.pop_back();
+                    }
+            }
+            REQUIRE(custom_vec.size() == std_deque.size());
+        }
+        REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_deque));
+        REQUIRE(custom_vec.front_free_capacity() + custom_vec.size() +
+                    custom_vec.back_free_capacity() ==
+                custom_vec.capacity());
+
+        // An element of the devector itself can be pushed even when the push moves it.
+        while (custom_vec.front_free_capacity() > 0) {
+            custom_vec.push_front("x");
+        }
+        custom_vec.push_front(custom_vec.back());
+        REQUIRE(custom_vec.front() == std_deque.back());
+    }
+
+    SECTION("Queue") {
+        // A sliding window never needs more than a few times its size.
+        coolstd::devector<int> window;
+        for (int i = 0; i < 100000; ++i) {
+            window.push_back(i);
+            if (window.size() > 100) {
+                window.pop_front();
+            }
+        }
+        REQUIRE(window.size() == 100);
+        REQUIRE(window.front() == 99900);
+        REQUIRE(window.capacity() <= 512);
+        REQUIRE(std::equal(window.begin(), window.end(), window.data()));
+
+        coolstd::devector<int> stack;
+        for (int i = 0; i < 1000; ++i) {
+            stack.push_front(i);
+        }
+        REQUIRE(stack.front() == 999);
+        REQUIRE(stack.back() == 0);
+        REQUIRE(stack.back_free_capacity() == 0);
+    }
+
+    SECTION("Middle insert and erase") {
+        coolstd::devector<std::string> string_vec;
+        coolstd::devector<int> int_vec;
+        std::vector<std::string> std_vec;
+        std::mt19937 rng(5);
+
+        for (int i = 0; i < 2000; ++i) {
+            const std::size_t position = std_vec.empty() ? 0 : rng() % (std_vec.size() + 1);
+            const std::string value = std::to_string(i);
+
+            if (rng() % 3 != 0 || position == std_vec.size()) {
+                const std::size_t count = rng() % 3;
+                string_vec.insert(string_vec.begin() + position, count, value);
+                int_vec.insert(int_vec.begin() + position, count, i);
+                std_vec.insert(std_vec.begin() + std::ptrdiff_t(position), count, value);
+            } else {
+                const std::size_t count =
+                    std::min<std::size_t>(rng() % 3, std_vec.size() - position);
+                string_vec.erase(string_vec.begin() + position,
+                                 string_vec.begin() + position + count);
+                int_vec.erase(int_vec.begin() + position, int_vec.begin() + position + count);
+                std_vec.erase(std_vec.begin() + std::ptrdiff_t(position),
+                                std_vec.begin() + std::ptrdiff_t(position + count));
+            }
+        }
+        REQUIRE_THAT(string_vec, Catch::Matchers::RangeEquals(std_vec));
+        REQUIRE(int_vec.size() == std_vec.size());
+        for (std::size_t i = 0; i < int_vec.size(); ++i) {
+            REQUIRE(std::to_string(int_vec[i]) == std_vec[i]);
+        }
+
+        // Near the front, only the front moves.
+        coolstd::devector<int> custom_vec(100, 1);
+        custom_vec.reserve_front(200);
+        const int* last = &custom_vec.back();
+        custom_vec.insert(custom_vec.begin() + 2, {7, 8});
+        custom_vec.erase(custom_vec.begin() + 1);
+        REQUIRE(&custom_vec.back() == last);
+        REQUIRE(custom_vec[1] == 7);
+        REQUIRE(custom_vec.size() == 101);
+    }
+
+    SECTION("Copy, move and compare") {
+        coolstd::devector<std::string> custom_vec{"b", "c"};
+        custom_vec.push_front("a");
+
+        coolstd::devector<std::string> copy = custom_vec;
+        REQUIRE(copy == custom_vec);
+        copy.back() = "d";
+        REQUIRE(custom_vec < copy);
+
+        coolstd::devector<std::string> moved = std::move(custom_vec);
+        REQUIRE(custom_vec.empty());
+        REQUIRE(moved.front() == "a");
+        custom_vec = std::move(moved);
+        swap(custom_vec, copy);
+        REQUIRE(custom_vec.back() == "d");
+        REQUIRE(copy.at(2) == "c");
+        REQUIRE_THROWS_AS(copy.at(3), std::out_of_range);
+
+        copy.shrink_to_fit();
+        REQUIRE(copy.capacity() == 3);
+        copy.resize(5);
+        REQUIRE(copy.back().empty());
+        copy.assign(2, "z");
+        REQUIRE(copy == coolstd::devector<std::string>{"z", "z"});
+    }
+
+    SECTION("Exception safety") {
+        // ThrowingMove is relocated by copying, and the copies can be made to fail.
+        coolstd::devector<ThrowingMove> custom_vec;
+        for (int i = 0; i < 4; ++i) {
+            custom_vec.emplace_back(i);
+        }
+
+        ThrowingMove::copiesUntilThrow = 2;
+        REQUIRE_THROWS_AS(custom_vec.emplace_front(-1), std::runtime_error);
+        ThrowingMove::copiesUntilThrow = -1;
+        REQUIRE(custom_vec.size() == 4);
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(custom_vec[std::size_t(i)].value == i);
+        }
+    }
+}
+
+namespace {
+
+constexpr int inplaceSum() {
+    coolstd::inplace_vector<int, 8> vec{3, 1, 2};
+    vec.insert(vec.begin(), 2, 5);
+    vec.erase(vec.begin() + 1);
+    vec.push_back(4);
+    std::sort(vec.begin(), vec.end());
+    coolstd::inplace_vector<int, 8> copy = vec;
+    copy.try_push_back(10);
+    int sum = 0;
+    for (int value : copy) {
+        sum += value;
+    }
+    return sum;
+}
+
+}  // namespace
+
+TEST_CASE("Inplace vector", "[inplace_vector]") {
+    static_assert(std::is_trivially_copyable_v<coolstd::inplace_vector<int, 8>>);
+    static_assert(!std::is_trivially_copyable_v<coolstd::inplace_vector<std::string, 8>>);
+    static_assert(sizeof(coolstd::inplace_vector<std::uint8_t, 8>) == 8 + sizeof(std::size_t));
+    static_assert(inplaceSum() == 25);
+
+    constexpr coolstd::inplace_vector<int, 4> partial{1, 2};
+    constexpr coolstd::inplace_vector<int, 4> empty;
+    static_assert(partial.size() == 2 && partial[1] == 2 && empty.empty());
+
+    SECTION("Modifiers match std::vector") {
+        std::mt19937 gen(24);
+        coolstd::inplace_vector<std::string, 64> custom_vec;
+        std::vector<std::string> std_vec;
+
+        for (int i = 0; i < 2000; ++i) {
+            const std::string value = std::to_string(i);
+            const std::size_t position = std_vec.empty() ? 0 : gen() % (std_vec.size() + 1);
+            const std::size_t count = gen() % 4;
+            const bool fits = std_vec.size() + count <= 64;
+            switch (gen() % 6) {
+                case 0:
+                    if (std_vec.size() < 64) {
+                        custom_vec.push_back(value);
+                        std_vec.push_back(value);
+                    }
+                    break;
+                case 1:
+                    if (std_vec.size() < 64) {
+                        custom_vec.emplace(custom_vec.begin() + std::ptrdiff_t(position), value);
+                        std_vec.emplace(std_vec.begin() + std::ptrdiff_t(position), value);
+                    }
+                    break;
+                case 2:
+                    if (fits) {
+                        custom_vec.insert(custom_vec.begin() + std::ptrdiff_t(position), count,
+                                          value);
+                        std_vec.insert(std_vec.begin() + std::ptrdiff_t(position), count, value);
+                    }
+                    break;
+                case 3:
+                    if (fits) {
+                        const std::vector<std::string> range(count, value + "r");
+                        custom_vec.insert_range(custom_vec.begin() + std::ptrdiff_t(position),
+                                                range);
+                        std_vec.insert(std_vec.begin() + std::ptrdiff_t(position), range.begin(),
+                                       range.end());
+                    }
+                    break;
+                case 4:
+                    if (position + count <= std_vec.size()) {
+                        custom_vec.erase(custom_vec.begin() + std::ptrdiff_t(position),
+                                         custom_vec.begin() + std::ptrdiff_t(position + count));
+                        std_vec.erase(std_vec.begin() + std::ptrdiff_t(position),
+                                      std_vec.begin() + std::ptrdiff_t(position + count));
+                    }
+                    break;
+                default:
+                    if (!std_vec.empty()) {
+                        custom_vec.pop_back();
+                        std_vec.pop_back();
+                    }
+                    break;
+            }
+            REQUIRE_THAT(custom_vec, Catch::Matchers::RangeEquals(std_vec));
+        }
+    }
+
+    SECTION("Full inplace_vector") {
+        coolstd::inplace_vector<std::string, 4> custom_vec(3, "a");
+        const std::string* pushed = custom_vec.try_push_back("b");
+        REQUIRE(pushed == &custom_vec.back());
+        REQUIRE(custom_vec.try_push_back("c") == nullptr);
+        REQUIRE(custom_vec.try_emplace_back(2, 'c') == nullptr);
+        REQUIRE_THROWS_AS(custom_vec.push_back("c"), std::bad_alloc);
+        REQUIRE_THROWS_AS(custom_vec.insert(custom_vec.begin(), "c"), std::bad_alloc);
+        REQUIRE_THROWS_AS(custom_vec.resize(5), std::bad_alloc);
+        REQUIRE_THROWS_AS(custom_vec.reserve(5), std::bad_alloc);
+        REQUIRE_THROWS_AS((coolstd::inplace_vector<int, 2>{1, 2, 3}), std::bad_alloc);
+        REQUIRE(custom_vec == coolstd::inplace_vector<std::string, 4>{"a", "a", "a", "b"});
+
+        // An input range that doesn't fit leaves the inplace_vector as it was.
+        std::istringstream words("x y z");
+        custom_vec.pop_back();
+        REQUIRE_THROWS_AS(custom_vec.insert(custom_vec.begin(),
+                                            std::istream_iterator<std::string>(words),
+                                            std::istream_iterator<std::string>()),
+                          std::bad_alloc);
+        REQUIRE(custom_vec == coolstd::inplace_vector<std::string, 4>(3, "a"));
+
+        custom_vec.clear();
+        REQUIRE(custom_vec.unchecked_push_back("d") == "d");
+        REQUIRE(custom_vec.capacity() == 4);
+    }
+
+    SECTION("Copy, move and compare") {
+        coolstd::inplace_vector<std::string, 8> custom_vec{"a", "b", "c"};
+        coolstd::inplace_vector<std::string, 8> copy = custom_vec;
+        REQUIRE(copy == custom_vec);
+        copy.back() = "d";
+        REQUIRE(custom_vec < copy);
+
+        coolstd::inplace_vector<std::string, 8> moved = std::move(custom_vec);
+        REQUIRE(moved.front() == "a");
+        copy = moved;
+        REQUIRE(copy == moved);
+        copy = {"x"};
+        moved = std::move(copy);
+        REQUIRE(moved.size() == 1);
+
+        coolstd::inplace_vector<std::string, 8> other{"p", "q", "r", "s"};
+        swap(moved, other);
+        REQUIRE(moved.size() == 4);
+        REQUIRE(other == coolstd::inplace_vector<std::string, 8>{"x"});
+        REQUIRE(moved.at(3) == "s");
+        REQUIRE_THROWS_AS(moved.at(4), std::out_of_range);
+
+        moved.assign(2, "z");
+        moved.append_range(std::vector<std::string>{"y"});
+        REQUIRE(moved == coolstd::inplace_vector<std::string, 8>{"z", "z", "y"});
+        moved.resize(5, "w");
+        REQUIRE(moved.back() == "w");
+
+        coolstd::inplace_vector<int, 8> ints{1, 2, 3};
+        coolstd::inplace_vector<int, 8> intCopy = ints;
+        intCopy[0] = 4;
+        REQUIRE(ints[0] == 1);
+        REQUIRE(std::vector<int>(ints.rbegin(), ints.rend()) == std::vector<int>{3, 2, 1});
+    }
+}
+
+namespace {
+
+// The CRC-32 lookup table, built in a coolstd::vector and copied out into an array.
+constexpr std::array<std::uint32_t, 256> crc32Table() {
+    coolstd::vector<std::uint32_t> table;
+    for (std::uint32_t byte = 0; byte < 256; ++byte) {
+        std::uint32_t crc = byte;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = crc & 1 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+        }
+        table.push_back(crc);
+    }
+
+    std::array<std::uint32_t, 256> result{};
+    std::copy(table.begin(), table.end(), result.begin());
+    return result;
+}
+
+template <class T>
+constexpr T constantValue(int i) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return std::string(std::size_t(1 + i / 26), char('a' + i % 26));
+    } else {
+        return T(i);
+    }
+}
+
+template <class Vector>
+constexpr Vector constantModifiers(Vector vec) {
+    using T = typename Vector::value_type;
+    constexpr auto value = constantValue<T>;
+
+    for (int i = 0; i < 40; ++i) {
+        vec.push_back(value(i));
+    }
+    vec.insert(vec.begin() + 3, 5, value(100));
+    vec.insert(vec.begin() + 1, {value(101), value(102)});
+    vec.emplace(vec.begin(), value(103));
+    vec.erase(vec.begin() + 2, vec.begin() + 6);
+    vec.erase_unordered(vec.begin() + 1);
+    erase_if(vec, [&](const T& element) { return element == value(7) || element == value(8); });
+    const int indices[] = {0, 4, 5};
+    vec.erase_indices(indices);
+    vec.resize(vec.size() + 3, value(104));
+    vec.shrink_to_fit();
+    vec.reserve(vec.size() * 2);
+
+    Vector other(vec.begin(), vec.begin() + 10);
+    other.insert_range(other.begin() + 2, vec);
+    other.append_range(std::array<T, 2>{value(105), value(106)});
+    other.assign(other.begin() + 1, other.begin() + 30);
+    vec = other;
+    vec.pop_back();
+    swap(vec, other);
+
+    return vec;
+}
+
+template <class Vector>
+constexpr bool constantModifiersMatch() {
+    using T = typename Vector::value_type;
+    constexpr auto value = constantValue<T>;
+
+    const Vector vec = constantModifiers(Vector());
+    std::vector<T> model;
+    for (int i = 0; i < 40; ++i) {
+        model.push_back(value(i));
+    }
+    model.insert(model.begin() + 3, 5, value(100));
+    model.insert(model.begin() + 1, {value(101), value(102)});
+    model.emplace(model.begin(), value(103));
+    model.erase(model.begin() + 2, model.begin() + 6);
+    model[1] = model.back();
+    model.pop_back();
+    std::erase_if(model,
+                  [&](const T& element) { return element == value(7) || element == value(8); });
+    model.erase(model.begin() + 5);
+    model.erase(model.begin() + 4);
+    model.erase(model.begin());
+    model.resize(model.size() + 3, value(104));
+    const std::vector<T> other(model.begin(), model.begin() + 10);
+    std::vector<T> expected = other;
+    expected.insert(expected.begin() + 2, model.begin(), model.end());
+    expected.insert(expected.end(), {value(105), value(106)});
+    expected = std::vector<T>(expected.begin() + 1, expected.begin() + 30);
+
+    return std::equal(vec.begin(), vec.end(), expected.begin(), expected.end()) &&
+           vec == Vector(expected.begin(), expected.end()) && !(vec < vec);
+}
+
+}  // namespace
+
+TEST_CASE("Constant evaluation", "[constexpr]") {
+    SECTION("Lookup table") {
+        constexpr std::array<std::uint32_t, 256> table = crc32Table();
+        static_assert(table[0] == 0);
+        static_assert(table[1] == 0x77073096u);
+        static_assert(table[255] == 0x2D02EF8Du);
+        REQUIRE(table == crc32Table());
+    }
+
+    SECTION("Modifiers") {
+        static_assert(constantModifiersMatch<coolstd::vector<int>>());
+        static_assert(constantModifiersMatch<coolstd::vector<std::string>>());
+        using SizeClassVector =
+            coolstd::vector<double, std::allocator<double>, coolstd::growth::size_class<>>;
+        static_assert(constantModifiersMatch<SizeClassVector>());
+        REQUIRE(constantModifiersMatch<coolstd::vector<int>>());
+        REQUIRE(constantModifiersMatch<coolstd::vector<std::string>>());
+    }
+
+    SECTION("Overwrite and compare") {
+        static_assert([] {
+            coolstd::vector<int> vec(4, 1);
+            vec.resize_for_overwrite(8);
+            vec.resize_and_overwrite(12, [](int* data, std::size_t count) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    data[i] = int(i);
+                }
+                return count - 2;
+            });
+            const coolstd::vector<int> prefix(vec.begin(), vec.begin() + 5);
+            return vec.size() == 10 && vec.back() == 9 && prefix < vec && prefix != vec &&
+                   (vec <=> prefix) > 0;
+        }());
+    }
+}
+
+#if COOLSTD_CHECKS == COOLSTD_CHECKS_ASSERT
+struct CheckFailure : std::logic_error {
+    using std::logic_error::logic_error;
+};
+
+// Turns failed checks into exceptions for the duration of a test.
+struct ThrowingCheckHandler {
+    coolstd::checks::handler_type previous = coolstd::checks::set_handler(
+        [](const char* message, const char*, int) { throw CheckFailure(message); });
+
+    ~ThrowingCheckHandler() {
+        coolstd::checks::set_handler(previous);
+    }
+};
+
+TEST_CASE("Checked mode", "[checks]") {
+    ThrowingCheckHandler handler;
+    coolstd::vector<int> custom_vec{1, 2, 3};
+    coolstd::vector<int> empty_vec;
+
+    SECTION("Element access") {
+        REQUIRE(custom_vec[2] == 3);
+        REQUIRE_THROWS_AS(custom_vec[3], CheckFailure);
+        REQUIRE_THROWS_AS(std::as_const(custom_vec)[3], CheckFailure);
+        REQUIRE_THROWS_AS(empty_vec.front(), CheckFailure);
+        REQUIRE_THROWS_AS(empty_vec.back(), CheckFailure);
+        REQUIRE_THROWS_AS(empty_vec.pop_back(), CheckFailure);
+        REQUIRE_THROWS_AS(empty_vec.at(0), std::out_of_range);
+    }
+
+    SECTION("Iterators") {
+        auto it = custom_vec.end();
+        REQUIRE(*(it - 1) == 3);
+        REQUIRE_THROWS_AS(*it, CheckFailure);
+        REQUIRE_THROWS_AS(++it, CheckFailure);
+        REQUIRE_THROWS_AS(custom_vec.begin() - 1, CheckFailure);
+        REQUIRE_THROWS_AS(custom_vec.cbegin() + 4, CheckFailure);
+        REQUIRE_THROWS_AS(custom_vec.begin()[3], CheckFailure);
+        REQUIRE_THROWS_AS(custom_vec.end() - empty_vec.end(), CheckFailure);
+
+        // An iterator that outlived a reallocation points into a released buffer.
+        const auto stale = custom_vec.cbegin();
+        custom_vec.reserve(100);
+        REQUIRE_THROWS_AS(*stale, CheckFailure);
+    }
+
+    SECTION("Iterators follow their buffer") {
+        // After a swap the iterators are checked against the vector that holds their buffer
+        // now, even once the one they came from is gone.
+        coolstd::vector<int> holder;
+        auto first = custom_vec.begin();
+        {
+            coolstd::vector<int> source{4, 5};
+            first = source.begin();
+            holder.swap(source);
+        }
+        REQUIRE(*first == 4);
+        REQUIRE(first[1] == 5);
+        REQUIRE(holder.end() - first == 2);
+        REQUIRE_THROWS_AS(first[2], CheckFailure);
+        REQUIRE_THROWS_AS(first + 3, CheckFailure);
+
+        const coolstd::vector<int> moved(std::move(holder));
+        REQUIRE(*(first + 1) == 5);
+
+        // The vector that held the buffer is gone, and the buffer with it.
+        auto dead = custom_vec.cbegin();
+        {
+            coolstd::vector<int> gone{6};
+            dead = gone.cbegin();
+        }
+        REQUIRE_THROWS_AS(*dead, CheckFailure);
+    }
+
+    SECTION("Positions") {
+        REQUIRE_THROWS_AS(custom_vec.insert(empty_vec.begin() + 0, 4), CheckFailure);
+        REQUIRE_THROWS_AS(custom_vec.erase(custom_vec.end()), CheckFailure);
+        REQUIRE_THROWS_AS(custom_vec.erase(custom_vec.end() - 1, custom_vec.begin()),
+                          CheckFailure);
+        REQUIRE_THROWS_AS(custom_vec.erase_unordered(custom_vec.end()), CheckFailure);
+        REQUIRE_THROWS_AS(custom_vec.erase_indices(std::vector<int>{2, 0}), CheckFailure);
+        REQUIRE_THROWS_AS(custom_vec.erase_indices(std::vector<int>{3}), CheckFailure);
+        REQUIRE(custom_vec == coolstd::vector<int>{1, 2, 3});
+
+        custom_vec.insert(custom_vec.end(), 4);
+        custom_vec.erase(custom_vec.begin(), custom_vec.end());
+        REQUIRE(custom_vec.empty());
+    }
+
+    SECTION("Small vector") {
+        coolstd::small_vector<int, 4> small_vec{1, 2};
+
+        REQUIRE_THROWS_AS(small_vec[2], CheckFailure);
+        REQUIRE_THROWS_AS(small_vec.erase(small_vec.end()), CheckFailure);
+        small_vec.clear();
+        REQUIRE_THROWS_AS(small_vec.back(), CheckFailure);
+        REQUIRE_THROWS_AS(small_vec.pop_back(), CheckFailure);
+    }
+}
+#endif
@@ -1,14 +1,742 @@
+#pragma once
+
 #include <initializer_list>
 #include <type_traits>
+#include <algorithm>
 #include <stdexcept>
 #include <iterator>
 #include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <utility>
 #include <ostream>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <ranges>
+
+#include "simd.h"
+
+// Precondition checks in vector and its iterators, chosen per build by defining COOLSTD_CHECKS,
+// the same way in every translation unit:
+//   COOLSTD_CHECKS_OFF (0, the default)  no checks: the code is the same as without them;
+//   COOLSTD_CHECKS_ASSERT (1)            a failed check calls checks::handler(), which by default
+//                                        prints the check and where it failed, then aborts;
+//   COOLSTD_CHECKS_TRAP (2)              a failed check executes a trap instruction, with no
+//                                        message and next to no code, for hardened releases.
+// The checks cover operator[], front(), back() and pop_back() on an empty vector, dereferencing
+// an iterator that isn't at an element, moving one outside [begin(), end()] or subtracting
+// iterators of different vectors, using an iterator whose buffer has since been released, and
+// insert/erase positions. Iterators follow their buffer through swaps and moves and are checked
+// against whichever vector holds it. Failing branches are marked [[unlikely]] and the handler is
+// cold, so a passing check is a compare and a not-taken branch.
+// at() throws std::out_of_range in every mode.
+#define COOLSTD_CHECKS_OFF 0
+#define COOLSTD_CHECKS_ASSERT 1
+#define COOLSTD_CHECKS_TRAP 2
+
+#ifndef COOLSTD_CHECKS
+#define COOLSTD_CHECKS COOLSTD_CHECKS_OFF
+#endif
+
+#if COOLSTD_CHECKS == COOLSTD_CHECKS_ASSERT
+#define COOLSTD_CHECK(condition, message)                                         \
+    do {                                                                          \
+        if (!(condition)) [[unlikely]] {                                          \
+            ::coolstd::checks::detail::checkFailed(message, __FILE__, __LINE__); \
+        }                                                                         \
+    } while (false)
+#elif COOLSTD_CHECKS == COOLSTD_CHECKS_TRAP
+#define COOLSTD_CHECK(condition, message) \
+    do {                                  \
+        if (!(condition)) [[unlikely]] {  \
+            __builtin_trap();             \
+        }                                 \
+    } while (false)
+#else
+#define COOLSTD_CHECK(condition, message) static_cast<void>(0)
+#endif
 
 namespace coolstd {
-template <class T, class Allocator = std::allocator<T>>
+
+namespace checks {
+
+// Called with the failed check's description and location in COOLSTD_CHECKS_ASSERT builds. A
+// handler may throw (tests do) or not return; if it returns, the program aborts.
+using handler_type = void (*)(const char* message, const char* file, int line);
+
+namespace detail {
+
+inline void printAndAbort(const char* message, const char* file, int line) {
+    std::fprintf(stderr, "%s:%d: coolstd check failed: %s\n", file, line, message);
+    std::abort();
+}
+
+inline handler_type& handlerSlot() noexcept {
+    static handler_type handler = printAndAbort;
+    return handler;
+}
+
+[[noreturn, gnu::cold, gnu::noinline]] inline void checkFailed(const char* message,
+                                                                const char* file, int line) {
+    handlerSlot()(message, file, line);
+    std::abort();
+}
+
+// Checked builds give each vector buffer a record, through which its iterators find the vector
+// holding it now (the buffer moves between vectors on swap and move) without keeping a pointer
+// to a vector that may be gone. Records are pooled and never freed: releasing one with its
+// buffer bumps the generation, which every iterator made before then no longer matches.
+struct buffer_record {
+    const void* owner = nullptr;
+    std::uint64_t generation = 0;
+    buffer_record* nextFree = nullptr;
+};
+
+struct recordPool {
+    std::mutex mutex;
+    buffer_record* freeList = nullptr;
+};
+
+inline recordPool& records() noexcept {
+    static recordPool pool;
+    return pool;
+}
+
+// Null if no record can be allocated; the buffer then goes unchecked.
+inline buffer_record* acquireRecord(const void* owner) noexcept {
+    recordPool& pool = records();
+    buffer_record* record = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        record = pool.freeList;
+        if (record != nullptr) {
+            pool.freeList = record->nextFree;
+        }
+    }
+    if (record == nullptr) {
+        record = new (std::nothrow) buffer_record;
+    }
+    if (record != nullptr) {
+        record->owner = owner;
+    }
+
+    return record;
+}
+
+inline void releaseRecord(buffer_record* record) noexcept {
+    recordPool& pool = records();
+    record->owner = nullptr;
+    ++record->generation;
+
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    record->nextFree = pool.freeList;
+    pool.freeList = record;
+}
+
+}  // namespace detail
+
+inline handler_type handler() noexcept {
+    return detail::handlerSlot();
+}
+
+// Installs a handler and returns the previous one. Not thread-safe: call it at startup.
+inline handler_type set_handler(handler_type newHandler) noexcept {
+    return std::exchange(detail::handlerSlot(), newHandler);
+}
+
+}  // namespace checks
+
+// Customization point: a type is trivially relocatable when moving it to a new address and
+// destroying the original is equivalent to copying its bytes. Trivially copyable types are by
+// definition; other types opt in by specializing this trait or by declaring
+// `using trivially_relocatable = std::true_type;` as a member.
+template <class T, class = void>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <class T>
+struct is_trivially_relocatable<T, std::void_t<typename T::trivially_relocatable>>
+    : T::trivially_relocatable {};
+
+template <class T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Returned by an allocator's optional allocate_at_least(n): a block with room for count >= n
+// elements, mirroring C++23 std::allocation_result.
+template <class Pointer>
+struct allocation_result {
+    Pointer ptr;
+    std::size_t count;
+};
+
+namespace detail {
+
+// Detects allocators that customize construct()/destroy(); raw memory operations would bypass
+// them, so the bitwise fast paths below are only taken when neither is present.
+template <class Allocator, class T, class = void>
+struct detects_construct : std::false_type {};
+
+template <class Allocator, class T>
+struct detects_construct<Allocator, T,
+                         std::void_t<decltype(std::declval<Allocator&>().construct(
+                             std::declval<T*>(), std::declval<T&&>()))>> : std::true_type {};
+
+template <class Allocator, class T, class = void>
+struct detects_destroy : std::false_type {};
+
+template <class Allocator, class T>
+struct detects_destroy<
+    Allocator, T, std::void_t<decltype(std::declval<Allocator&>().destroy(std::declval<T*>()))>>
+    : std::true_type {};
+
+template <class Allocator, class T>
+struct has_custom_construct : detects_construct<Allocator, T> {};
+
+template <class Allocator, class T>
+struct has_custom_destroy : detects_destroy<Allocator, T> {};
+
+// polymorphic_allocator's construct() only differs from placement new for types that take an
+// allocator, and its destroy() is a plain destructor call.
+template <class U, class T>
+struct has_custom_construct<std::pmr::polymorphic_allocator<U>, T>
+    : std::uses_allocator<T, std::pmr::polymorphic_allocator<U>> {};
+
+template <class U, class T>
+struct has_custom_destroy<std::pmr::polymorphic_allocator<U>, T> : std::false_type {};
+
+template <class Allocator, class T>
+inline constexpr bool is_bitwise_relocatable_v = is_trivially_relocatable_v<T> &&
+                                                 !has_custom_construct<Allocator, T>::value &&
+                                                 !has_custom_destroy<Allocator, T>::value;
+
+// Optional allocator extensions, all detected by signature:
+//   allocate_at_least(n) -> allocation_result<pointer>   (report usable slack as capacity)
+//   try_expand(p, oldCount, newCount) -> bool          (grow the block in place, never moves)
+//   reallocate(p, oldCount, newCount) -> pointer        (may move the block bitwise, realloc-style)
+template <class Allocator, class = void>
+struct has_allocate_at_least : std::false_type {};
+
+template <class Allocator>
+struct has_allocate_at_least<
+    Allocator, std::void_t<decltype(std::declval<Allocator&>().allocate_at_least(std::size_t()))>>
+    : std::true_type {};
+
+template <class Allocator, class = void>
+struct has_try_expand : std::false_type {};
+
+template <class Allocator>
+struct has_try_expand<Allocator, std::void_t<decltype(std::declval<Allocator&>().try_expand(
+                                     std::declval<typename Allocator::value_type*>(),
+                                     std::size_t(), std::size_t()))>> : std::true_type {};
+
+template <class Allocator, class = void>
+struct has_reallocate : std::false_type {};
+
+template <class Allocator>
+struct has_reallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+                                     std::declval<typename Allocator::value_type*>(),
+                                     std::size_t(), std::size_t()))>> : std::true_type {};
+
+// Allocators that declare `using is_monotonic = std::true_type;` only reclaim memory in bulk
+// (an arena reset), so vector skips their deallocate() entirely. With a trivially destructible
+// T, destroying such a vector touches neither the elements nor the allocator.
+template <class Allocator, class = void>
+struct is_monotonic : std::false_type {};
+
+template <class Allocator>
+struct is_monotonic<Allocator, std::void_t<typename Allocator::is_monotonic>>
+    : Allocator::is_monotonic {};
+
+// Allocators that declare `using is_single_block = std::true_type;` can't hand out a second
+// block while the first is live, so vector grows them through reallocate() for every insertion,
+// not just appends of one element.
+template <class Allocator, class = void>
+struct is_single_block : std::false_type {};
+
+template <class Allocator>
+struct is_single_block<Allocator, std::void_t<typename Allocator::is_single_block>>
+    : Allocator::is_single_block {};
+
+// Allocators that declare `static constexpr std::size_t alignment` promise that every block
+// they return starts at a multiple of it; vector::data() hands that on to the optimizer with
+// std::assume_aligned so that loops over the elements vectorize without a peeled prologue.
+template <class Allocator, class = void>
+struct allocator_alignment
+    : std::integral_constant<std::size_t, alignof(typename Allocator::value_type)> {};
+
+template <class Allocator>
+struct allocator_alignment<Allocator, std::void_t<decltype(Allocator::alignment)>>
+    : std::integral_constant<std::size_t,
+                             std::max(std::size_t(Allocator::alignment),
+                                      alignof(typename Allocator::value_type))> {};
+
+template <class Allocator>
+constexpr auto allocateAtLeast(Allocator& allocator, std::size_t count)
+    -> allocation_result<typename std::allocator_traits<Allocator>::pointer> {
+    if constexpr (has_allocate_at_least<Allocator>::value) {
+        auto result = allocator.allocate_at_least(count);
+        return {result.ptr, result.count};
+    } else {
+        return {std::allocator_traits<Allocator>::allocate(allocator, count), count};
+    }
+}
+
+template <class Allocator>
+constexpr bool tryExpand(Allocator& allocator,
+                         typename std::allocator_traits<Allocator>::pointer ptr,
+                         std::size_t oldCount, std::size_t newCount) {
+    if constexpr (has_try_expand<Allocator>::value) {
+        return ptr != nullptr && allocator.try_expand(ptr, oldCount, newCount);
+    } else {
+        return false;
+    }
+}
+
+template <class Allocator, class T>
+constexpr void destroyRange(Allocator& allocator, T* from, T* to) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T> || has_custom_destroy<Allocator, T>::value) {
+        for (; from != to; ++from) {
+            std::allocator_traits<Allocator>::destroy(allocator, from);
+        }
+    }
+}
+
+// Constructs copies of [from, to) at destination. On exception everything constructed so far
+// is destroyed and the exception is rethrown.
+template <class Allocator, class T, class InputIterator>
+constexpr T* uninitializedCopy(Allocator& allocator, InputIterator from, InputIterator to,
+                               T* destination) {
+    T* current = destination;
+
+    try {
+        for (; from != to; ++from, ++current) {
+            std::allocator_traits<Allocator>::construct(allocator, current, *from);
+        }
+    } catch (...) {
+        destroyRange(allocator, destination, current);
+        throw;
+    }
+
+    return current;
+}
+
+// Iterators over elements laid out contiguously in memory: std::contiguous_iterator, plus
+// iterators that declare a contiguous iterator_concept but a const-qualified value_type (as
+// vector::ConstIterator does), which the standard concept rejects.
+template <class Iterator, class = void>
+struct is_contiguous_iterator : std::bool_constant<std::contiguous_iterator<Iterator>> {};
+
+template <class Iterator>
+struct is_contiguous_iterator<
+    Iterator, std::enable_if_t<std::is_same_v<typename Iterator::iterator_concept,
+                                              std::contiguous_iterator_tag>>> : std::true_type {};
+
+// Contiguous ranges of a trivially copyable T that the allocator constructs normally: these are
+// copied, into raw or live storage alike, with memcpy/memmove.
+template <class Allocator, class Iterator, class T>
+inline constexpr bool is_memcpy_range_v =
+    is_contiguous_iterator<Iterator>::value &&
+    std::is_same_v<std::remove_cv_t<std::iter_value_t<Iterator>>, T> &&
+    std::is_trivially_copyable_v<T> && !has_custom_construct<Allocator, T>::value;
+
+// Constructs copies of the count elements starting at from at destination, with one memcpy when
+// they are contiguous values of a trivially copyable T. Rolls back like uninitializedCopy.
+template <class Allocator, class T, class InputIterator>
+constexpr T* uninitializedCopyN(Allocator& allocator, InputIterator from, std::size_t count,
+                                T* destination) {
+    if constexpr (is_memcpy_range_v<Allocator, InputIterator, T>) {
+        if (!std::is_constant_evaluated()) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(destination),
+                            static_cast<const void*>(std::to_address(from)), count * sizeof(T));
+            }
+
+            return destination + count;
+        }
+    }
+
+    T* current = destination;
+
+    try {
+        for (; count > 0; --count, ++from, ++current) {
+            std::allocator_traits<Allocator>::construct(allocator, current, *from);
+        }
+    } catch (...) {
+        destroyRange(allocator, destination, current);
+        throw;
+    }
+
+    return current;
+}
+
+// Constructs count elements at destination from args (value-initialized when args is empty),
+// with the same rollback as uninitializedCopy. Arithmetic elements are zeroed with memset or
+// filled with the SIMD kernels.
+template <class Allocator, class T, class... Args>
+constexpr T* uninitializedFill(Allocator& allocator, T* destination, std::size_t count,
+                               const Args&... args) {
+    if constexpr (simd::is_element_v<T> && !has_custom_construct<Allocator, T>::value &&
+                  sizeof...(Args) <= 1) {
+        if (!std::is_constant_evaluated()) {
+            if constexpr (sizeof...(Args) == 0) {
+                if (count > 0) {
+                    std::memset(static_cast<void*>(destination), 0, count * sizeof(T));
+                }
+            } else {
+                simd::fill(destination, count, T(args...));
+            }
+
+            return destination + count;
+        }
+    }
+
+    T* current = destination;
+
+    try {
+        for (; count > 0; --count, ++current) {
+            std::allocator_traits<Allocator>::construct(allocator, current, args...);
+        }
+    } catch (...) {
+        destroyRange(allocator, destination, current);
+        throw;
+    }
+
+    return current;
+}
+
+// Default-initializes count elements at destination: trivially default-constructible types are
+// left untouched, so the storage keeps whatever bytes it held. Allocators that customize
+// construct() still see a value-initializing construct() call per element, and so does constant
+// evaluation, where the elements have to be alive before they can be written.
+template <class Allocator, class T>
+constexpr T* uninitializedDefaultFill(Allocator& allocator, T* destination, std::size_t count) {
+    if (std::is_constant_evaluated()) {
+        return uninitializedFill(allocator, destination, count);
+    }
+
+    if constexpr (has_custom_construct<Allocator, T>::value) {
+        return uninitializedFill(allocator, destination, count);
+    } else if constexpr (std::is_trivially_default_constructible_v<T>) {
+        return destination + count;
+    } else {
+        T* current = destination;
+
+        try {
+            for (; count > 0; --count, ++current) {
+                ::new (static_cast<void*>(current)) T;
+            }
+        } catch (...) {
+            destroyRange(allocator, destination, current);
+            throw;
+        }
+
+        return current;
+    }
+}
+
+// Moves [from, to) to destination if T's move constructor can't throw and copies otherwise, so
+// a failure leaves the source untouched.
+template <class Allocator, class T>
+constexpr T* uninitializedMoveIfNoexcept(Allocator& allocator, T* from, T* to, T* destination) {
+    T* current = destination;
+
+    try {
+        for (; from != to; ++from, ++current) {
+            std::allocator_traits<Allocator>::construct(allocator, current,
+                                                        std::move_if_noexcept(*from));
+        }
+    } catch (...) {
+        destroyRange(allocator, destination, current);
+        throw;
+    }
+
+    return current;
+}
+
+// Elements per chunk of parallel construction: a page's worth, so that in a page-aligned buffer
+// no page is first touched by two threads.
+template <class T>
+inline constexpr std::size_t parallelChunkElements = std::max<std::size_t>(1, 4096 / sizeof(T));
+
+// uninitializedFill with the chunks of [destination, destination + count) constructed as exec
+// schedules them. Only types whose construction can't throw are split, so no chunk ever has to
+// roll back another's elements; the rest are filled on the calling thread.
+template <class Executor, class Allocator, class T, class... Args>
+T* parallelFill(const Executor& exec, Allocator& allocator, T* destination, std::size_t count,
+                const Args&... args) {
+    if constexpr (std::is_nothrow_constructible_v<T, const Args&...> &&
+                  !has_custom_construct<Allocator, T>::value) {
+        exec.for_each_chunk(count, parallelChunkElements<T>, [&](std::size_t begin,
+                                                                 std::size_t end) {
+            uninitializedFill(allocator, destination + begin, end - begin, args...);
+        });
+        return destination + count;
+    } else {
+        return uninitializedFill(allocator, destination, count, args...);
+    }
+}
+
+// uninitializedCopyN split the same way.
+template <class Executor, class Allocator, class RandomIt, class T>
+T* parallelCopyN(const Executor& exec, Allocator& allocator, RandomIt from, std::size_t count,
+                 T* destination) {
+    if constexpr (std::is_nothrow_constructible_v<T, std::iter_reference_t<RandomIt>> &&
+                  !has_custom_construct<Allocator, T>::value) {
+        exec.for_each_chunk(count, parallelChunkElements<T>, [&](std::size_t begin,
+                                                                 std::size_t end) {
+            uninitializedCopyN(allocator, from + begin, end - begin, destination + begin);
+        });
+        return destination + count;
+    } else {
+        return uninitializedCopyN(allocator, from, count, destination);
+    }
+}
+
+// The fill of a growth that opens no gap. Its own type lets reallocation paths drop the code for
+// a new element at compile time.
+struct no_fill {
+    template <class Pointer>
+    constexpr void operator()(Pointer) const noexcept {
+    }
+};
+
+// Slides [from, to) to destination, which may overlap it, with a single memmove. Only valid when
+// is_bitwise_relocatable_v holds; the vacated slots are left as raw storage. Constant evaluation
+// can't copy bytes, so there each element is move-constructed in its new slot and the old one
+// destroyed, in the order that never overwrites an element before it has moved.
+template <class T>
+constexpr void shiftRange(T* from, T* to, T* destination) noexcept {
+    if (std::is_constant_evaluated()) {
+        if (destination < from) {
+            for (; from != to; ++from, ++destination) {
+                std::construct_at(destination, std::move(*from));
+                std::destroy_at(from);
+            }
+        } else if (destination > from) {
+            for (destination += to - from; to != from; --to) {
+                std::construct_at(--destination, std::move(*(to - 1)));
+                std::destroy_at(to - 1);
+            }
+        }
+
+        return;
+    }
+
+    const std::ptrdiff_t count = to - from;
+    if (count > 0) {
+        std::memmove(static_cast<void*>(destination), static_cast<const void*>(from),
+                     std::size_t(count) * sizeof(T));
+    }
+}
+
+// Relocates [from, to) into uninitialized storage at destination, leaving gapSize uninitialized
+// slots in front of the element at gapIndex. Trivially relocatable types are moved with memcpy
+// (except in constant evaluation), everything else goes through move_if_noexcept. The source
+// range is destroyed only once every element has been constructed, which gives the strong
+// exception guarantee whenever T is nothrow-movable or copyable.
+template <class Allocator, class T>
+constexpr void relocate(Allocator& allocator, T* from, T* to, T* destination,
+                        std::size_t gapIndex = 0, std::size_t gapSize = 0) {
+    const std::size_t count = std::size_t(to - from);
+
+    if constexpr (is_bitwise_relocatable_v<Allocator, T>) {
+        if (!std::is_constant_evaluated()) {
+            // With no gap, or nothing after it, one copy does; the second would start past the
+            // end of the new block when the gap is at the end.
+            const std::size_t prefix = gapSize == 0 ? count : std::min(gapIndex, count);
+            if (prefix > 0) {
+                std::memcpy(static_cast<void*>(destination), static_cast<const void*>(from),
+                            prefix * sizeof(T));
+            }
+            if (prefix < count) {
+                std::memcpy(static_cast<void*>(destination + gapIndex + gapSize),
+                            static_cast<const void*>(from + gapIndex),
+                            (count - gapIndex) * sizeof(T));
+            }
+
+            return;
+        }
+    }
+
+    T* prefixEnd = uninitializedMoveIfNoexcept(allocator, from, from + gapIndex, destination);
+
+    try {
+        uninitializedMoveIfNoexcept(allocator, from + gapIndex, to,
+                                    destination + gapIndex + gapSize);
+    } catch (...) {
+        destroyRange(allocator, destination, prefixEnd);
+        throw;
+    }
+
+    destroyRange(allocator, from, to);
+}
+
+// Three-way comparison the way the standard containers define it: operator<=> when T has one,
+// otherwise derived from operator<.
+struct synthThreeWay {
+    template <class T>
+    constexpr auto operator()(const T& lhs, const T& rhs) const {
+        if constexpr (std::three_way_comparable<T>) {
+            return lhs <=> rhs;
+        } else {
+            return lhs < rhs   ? std::weak_ordering::less
+                   : rhs < lhs ? std::weak_ordering::greater
+                               : std::weak_ordering::equivalent;
+        }
+    }
+};
+
+template <class T>
+constexpr bool equalRanges(const T* lhs, const T* rhs, std::size_t count) {
+    if constexpr (simd::is_element_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            return simd::mismatch(lhs, rhs, count) == count;
+        }
+    }
+
+    return std::equal(lhs, lhs + count, rhs);
+}
+
+template <class T>
+constexpr auto compareRanges(const T* lhs, std::size_t lhsCount, const T* rhs,
+                             std::size_t rhsCount) {
+    if constexpr (simd::is_element_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            using ordering = decltype(lhs[0] <=> rhs[0]);
+            const std::size_t common = std::min(lhsCount, rhsCount);
+            const std::size_t index = simd::mismatch(lhs, rhs, common);
+
+            return index < common ? ordering(lhs[index] <=> rhs[index])
+                                  : ordering(lhsCount <=> rhsCount);
+        }
+    }
+
+    return std::lexicographical_compare_three_way(lhs, lhs + lhsCount, rhs, rhs + rhsCount,
+                                                  synthThreeWay{});
+}
+}  // namespace detail
+
+// Growth policies decide how much capacity push_back/emplace_back/insert request once the
+// current buffer is full. next_capacity(capacity, required, elementSize) must return at least
+// `required`; the vector clamps the result to max_size().
+namespace growth {
+
+// Multiplies the capacity by Numerator / Denominator.
+template <std::size_t Numerator, std::size_t Denominator>
+struct geometric {
+    static_assert(Numerator > Denominator, "growth factor must be greater than one");
+
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                                               std::size_t /*elementSize*/) noexcept {
+        return std::max(capacity / Denominator * Numerator +
+                            capacity % Denominator * Numerator / Denominator,
+                        required);
+    }
+};
+
+// Doubling minimizes the number of reallocations. A factor of 1.5 keeps the sum of previously
+// freed blocks large enough to satisfy a later request, so the allocator can reuse them.
+using doubling = geometric<2, 1>;
+using one_and_a_half = geometric<3, 2>;
+
+// Grows by a constant number of elements: minimal slack, but quadratic total copying.
+template <std::size_t Increment>
+struct fixed_increment {
+    static_assert(Increment > 0, "increment must be positive");
+
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                                               std::size_t /*elementSize*/) noexcept {
+        return std::max(capacity + Increment, required);
+    }
+};
+
+// Rounds the capacity chosen by Base up so the buffer fills a whole malloc size class
+// (16-byte steps up to 128 bytes, then four classes per power of two, as in jemalloc and
+// tcmalloc). The bytes the allocator would waste as internal fragmentation become capacity.
+template <class Base = one_and_a_half>
+struct size_class {
+    static constexpr std::size_t round_bytes(std::size_t bytes) noexcept {
+        if (bytes <= 128) {
+            return (bytes + 15) / 16 * 16;
+        }
+
+        std::size_t power = 128;
+        while (power < bytes / 2 + bytes % 2) {
+            power *= 2;
+        }
+        const std::size_t step = power / 4;
+
+        return (bytes + step - 1) / step * step;
+    }
+
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required,
+                                               std::size_t elementSize) noexcept {
+        const std::size_t wanted = Base::next_capacity(capacity, required, elementSize);
+
+        if (wanted > std::size_t(-1) / elementSize) {
+            return wanted;
+        }
+
+        return std::max(round_bytes(wanted * elementSize) / elementSize, wanted);
+    }
+};
+
+}  // namespace growth
+
+namespace instrument {
+
+// How a reallocation carried the existing elements over to the new block.
+enum class relocation { bitwise, moved, copied };
+
+// Instrumentation policies receive static callbacks from vector at every allocation,
+// reallocation and element relocation. This default does nothing and takes no storage, so an
+// uninstrumented vector compiles to the same code as one without hooks; instrument.h provides a
+// counting policy with a process-wide registry.
+//   on_allocate(capacity, elementSize)                 a new block was obtained
+//   on_deallocate(capacity, size, elementSize)         a block was released holding size elements
+//   on_reallocate(oldCapacity, newCapacity, resized, elementSize)
+//                                                      a non-empty vector changed capacity;
+//                                                      resized when the allocator grew the block
+//                                                      itself (try_expand, reallocate) instead
+//                                                      of a new block being allocated
+//   on_relocate(count, relocation, elementSize)        elements were carried to a new block
+//   on_shift(count, elementSize)                       insert/emplace/erase slid elements in place
+struct none {
+    static constexpr void on_allocate(std::size_t, std::size_t) noexcept {
+    }
+    static constexpr void on_deallocate(std::size_t, std::size_t, std::size_t) noexcept {
+    }
+    static constexpr void on_reallocate(std::size_t, std::size_t, bool, std::size_t) noexcept {
+    }
+    static constexpr void on_relocate(std::size_t, relocation, std::size_t) noexcept {
+    }
+    static constexpr void on_shift(std::size_t, std::size_t) noexcept {
+    }
+};
+
+}  // namespace instrument
+
+// Something that runs a loop body over [0, count) in chunks, possibly on several threads:
+// body(begin, end) is called for disjoint chunks covering the range, each a multiple of
+// `multiple` elements long except the last, and for_each_chunk returns once all have finished.
+// vector's parallel construction overloads take one; par::options from parallel.h is the
+// implementation this library ships.
+template <class Executor>
+concept chunk_executor =
+    requires(const Executor& exec, std::size_t count, void (*body)(std::size_t, std::size_t)) {
+        exec.for_each_chunk(count, count, body);
+    };
+
+template <class T, class Allocator = std::allocator<T>, class GrowthPolicy = growth::doubling,
+          class Instrumentation = instrument::none>
 class vector {
 public:
     class ConstIterator;
@@ -16,177 +744,329 @@ public:
     class Iterator {
     public:
         using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
         using value_type = T;
         using difference_type = ptrdiff_t;
         using pointer = T*;
         using reference = T&;
 
-        Iterator() : ptr_(nullptr){};
-        explicit Iterator(pointer ptr) : ptr_(ptr){};
-        Iterator(const Iterator& a) = default;
-        Iterator(Iterator&& a) noexcept = default;
-        ~Iterator() = default;
+        constexpr Iterator() : ptr_(nullptr){};
+        constexpr explicit Iterator(pointer ptr) : ptr_(ptr){};
+        constexpr Iterator(const Iterator& a) = default;
+        constexpr Iterator(Iterator&& a) noexcept = default;
+        constexpr ~Iterator() = default;
 
-        Iterator& operator=(Iterator&& a) noexcept = default;
-        Iterator& operator=(const Iterator& a) = default;
+        constexpr Iterator& operator=(Iterator&& a) noexcept = default;
+        constexpr Iterator& operator=(const Iterator& a) = default;
         friend class vector;
 
-        reference operator*() const {
+        constexpr reference operator*() const {
+            COOLSTD_CHECK(atElement(ptr_),
+                          "dereferencing an iterator that is not at an element");
             return *ptr_;
         }
 
-        pointer operator->() const {
+        constexpr pointer operator->() const {
             return ptr_;
         }
 
-        reference operator[](difference_type n) const {
+        constexpr reference operator[](difference_type n) const {
+            COOLSTD_CHECK(atElement(std::next(ptr_, n)),
+                          "iterator subscript is not at an element");
             return *(std::next(ptr_, n));
         }
 
-        Iterator& operator++() {
+        constexpr Iterator& operator++() {
             ptr_ = std::next(ptr_, 1);
+            checkReachable();
             return *this;
         }
 
-        Iterator operator++(int) {
+        constexpr Iterator operator++(int) {
             Iterator it(*this);
             ptr_ = std::next(ptr_, 1);
+            checkReachable();
             return it;
         }
 
-        Iterator& operator--() {
+        constexpr Iterator& operator--() {
             ptr_ = std::next(ptr_, -1);
+            checkReachable();
             return *this;
         }
 
-        Iterator operator--(int) {
+        constexpr Iterator operator--(int) {
             Iterator it(*this);
             ptr_ = std::next(ptr_, -1);
+            checkReachable();
             return it;
         }
 
-        Iterator& operator+=(difference_type n) {
+        constexpr Iterator& operator+=(difference_type n) {
             ptr_ = std::next(ptr_, n);
+            checkReachable();
             return *this;
         }
 
-        Iterator& operator-=(difference_type n) {
+        constexpr Iterator& operator-=(difference_type n) {
             ptr_ = std::next(ptr_, -n);
+            checkReachable();
             return *this;
         }
 
-        Iterator operator+(difference_type n) const {
-            return Iterator(std::next(ptr_, n));
+        constexpr Iterator operator+(difference_type n) const {
+            Iterator it(*this);
+            return it += n;
         }
 
-        friend Iterator operator+(difference_type n, const Iterator& it) {
+        friend constexpr Iterator operator+(difference_type n, const Iterator& it) {
             return it + n;
         }
 
-        Iterator operator-(difference_type n) const {
-            return Iterator(std::next(ptr_, -n));
+        constexpr Iterator operator-(difference_type n) const {
+            Iterator it(*this);
+            return it -= n;
         }
 
-        difference_type operator-(const Iterator& it) const {
+        constexpr difference_type operator-(const Iterator& it) const {
+            COOLSTD_CHECK(!checked_ || !it.checked_ || buffer_ == it.buffer_,
+                          "subtracting iterators of different vectors");
             return std::distance(it.ptr_, ptr_);
         }
 
-        auto operator<=>(const Iterator& rhs) const = default;
+        // Only the positions are compared, so that checked builds agree with unchecked ones.
+        constexpr bool operator==(const Iterator& rhs) const {
+            return ptr_ == rhs.ptr_;
+        }
+        constexpr std::strong_ordering operator<=>(const Iterator& rhs) const {
+            return ptr_ <=> rhs.ptr_;
+        }
 
-        operator ConstIterator() const {
-            return ConstIterator(ptr_);
+        constexpr operator ConstIterator() const {
+            ConstIterator it(ptr_);
+#if COOLSTD_CHECKS
+            it.record_ = record_;
+            it.generation_ = generation_;
+            it.buffer_ = buffer_;
+            it.checked_ = checked_;
+#endif
+            return it;
         }
 
     private:
+        constexpr Iterator(pointer ptr, [[maybe_unused]] const vector* owner) : ptr_(ptr) {
+#if COOLSTD_CHECKS
+            record_ = owner->record_;
+            generation_ = record_ != nullptr ? record_->generation : 0;
+            buffer_ = owner->data_;
+            checked_ = true;
+#endif
+        }
+
+#if COOLSTD_CHECKS
+        // The vector that holds the iterator's buffer now, found through the buffer's record so
+        // that a vector which is gone is never touched; null when there is nothing to check
+        // against (a bare pointer, an empty vector, or constant evaluation). Fails if the buffer
+        // has been released since the iterator was made.
+        constexpr const vector* holder() const {
+            if (record_ == nullptr) {
+                return nullptr;
+            }
+            COOLSTD_CHECK(record_->generation == generation_,
+                          "using an iterator into a buffer its vector has released");
+            return static_cast<const vector*>(record_->owner);
+        }
+#endif
+
+        constexpr bool atElement([[maybe_unused]] const T* ptr) const {
+#if COOLSTD_CHECKS
+            const vector* vec = holder();
+            return vec == nullptr || vec->holds(ptr);
+#else
+            return true;
+#endif
+        }
+
+        constexpr void checkReachable() const {
+#if COOLSTD_CHECKS
+            const vector* vec = holder();
+            COOLSTD_CHECK(vec == nullptr || vec->reaches(ptr_),
+                          "iterator moved outside [begin(), end()]");
+#endif
+        }
+
         pointer ptr_;
+#if COOLSTD_CHECKS
+        // The record of the buffer the iterator was made in and its generation then, the buffer
+        // itself, and whether it came from a vector at all: iterators made from a bare pointer
+        // are not checked.
+        const checks::detail::buffer_record* record_ = nullptr;
+        std::uint64_t generation_ = 0;
+        const T* buffer_ = nullptr;
+        bool checked_ = false;
+#endif
     };
 
     class ConstIterator {
     public:
         using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
         using value_type = const T;
         using difference_type = ptrdiff_t;
         using pointer = const T*;
         using reference = const T&;
 
-        ConstIterator() : ptr_(nullptr){};
-        explicit ConstIterator(pointer ptr) : ptr_(ptr){};
-        ConstIterator(const ConstIterator& a) = default;
-        ConstIterator(ConstIterator&& a) noexcept = default;
-        ~ConstIterator() = default;
+        constexpr ConstIterator() : ptr_(nullptr){};
+        constexpr explicit ConstIterator(pointer ptr) : ptr_(ptr){};
+        constexpr ConstIterator(const ConstIterator& a) = default;
+        constexpr ConstIterator(ConstIterator&& a) noexcept = default;
+        constexpr ~ConstIterator() = default;
 
-        ConstIterator& operator=(ConstIterator&& a) noexcept = default;
-        ConstIterator& operator=(const ConstIterator& a) = default;
+        constexpr ConstIterator& operator=(ConstIterator&& a) noexcept = default;
+        constexpr ConstIterator& operator=(const ConstIterator& a) = default;
         friend class vector;
+        friend class Iterator;
 
-        reference operator*() const {
+        constexpr reference operator*() const {
+            COOLSTD_CHECK(atElement(ptr_),
+                          "dereferencing an iterator that is not at an element");
             return *ptr_;
         }
 
-        pointer operator->() const {
+        constexpr pointer operator->() const {
             return ptr_;
         }
 
-        reference operator[](difference_type n) const {
+        constexpr reference operator[](difference_type n) const {
+            COOLSTD_CHECK(atElement(std::next(ptr_, n)),
+                          "iterator subscript is not at an element");
             return *(std::next(ptr_, n));
         }
 
-        ConstIterator& operator++() {
+        constexpr ConstIterator& operator++() {
             ptr_ = std::next(ptr_, 1);
+            checkReachable();
             return *this;
         }
 
-        ConstIterator operator++(int) {
+        constexpr ConstIterator operator++(int) {
             ConstIterator it(*this);
             ptr_ = std::next(ptr_, 1);
+            checkReachable();
             return it;
         }
 
-        ConstIterator& operator--() {
+        constexpr ConstIterator& operator--() {
             ptr_ = std::next(ptr_, -1);
+            checkReachable();
             return *this;
         }
 
-        ConstIterator operator--(int) {
+        constexpr ConstIterator operator--(int) {
             ConstIterator it(*this);
             ptr_ = std::next(ptr_, -1);
+            checkReachable();
             return it;
         }
 
-        ConstIterator& operator+=(difference_type n) {
+        constexpr ConstIterator& operator+=(difference_type n) {
             ptr_ = std::next(ptr_, n);
+            checkReachable();
             return *this;
         }
 
-        ConstIterator& operator-=(difference_type n) {
+        constexpr ConstIterator& operator-=(difference_type n) {
             ptr_ = std::next(ptr_, -n);
+            checkReachable();
             return *this;
         }
 
-        ConstIterator operator+(difference_type n) const {
-            return ConstIterator(std::next(ptr_, n));
+        constexpr ConstIterator operator+(difference_type n) const {
+            ConstIterator it(*this);
+            return it += n;
         }
 
-        friend ConstIterator operator+(difference_type n, const ConstIterator& it) {
+        friend constexpr ConstIterator operator+(difference_type n, const ConstIterator& it) {
             return it + n;
         }
 
-        ConstIterator operator-(difference_type n) const {
-            return ConstIterator(std::next(ptr_, -n));
+        constexpr ConstIterator operator-(difference_type n) const {
+            ConstIterator it(*this);
+            return it -= n;
         }
 
-        difference_type operator-(const ConstIterator& it) const {
+        constexpr difference_type operator-(const ConstIterator& it) const {
+            COOLSTD_CHECK(!checked_ || !it.checked_ || buffer_ == it.buffer_,
+                          "subtracting iterators of different vectors");
             return std::distance(it.ptr_, ptr_);
         }
 
-        auto operator<=>(const ConstIterator& rhs) const = default;
+        // Only the positions are compared, so that checked builds agree with unchecked ones.
+        constexpr bool operator==(const ConstIterator& rhs) const {
+            return ptr_ == rhs.ptr_;
+        }
+        constexpr std::strong_ordering operator<=>(const ConstIterator& rhs) const {
+            return ptr_ <=> rhs.ptr_;
+        }
 
     private:
+        constexpr ConstIterator(pointer ptr, [[maybe_unused]] const vector* owner) : ptr_(ptr) {
+#if COOLSTD_CHECKS
+            record_ = owner->record_;
+            generation_ = record_ != nullptr ? record_->generation : 0;
+            buffer_ = owner->data_;
+            checked_ = true;
+#endif
+        }
+
+#if COOLSTD_CHECKS
+        // The vector that holds the iterator's buffer now, found through the buffer's record so
+        // that a vector which is gone is never touched; null when there is nothing to check
+        // against (a bare pointer, an empty vector, or constant evaluation). Fails if the buffer
+        // has been released since the iterator was made.
+        constexpr const vector* holder() const {
+            if (record_ == nullptr) {
+                return nullptr;
+            }
+            COOLSTD_CHECK(record_->generation == generation_,
+                          "using an iterator into a buffer its vector has released");
+            return static_cast<const vector*>(record_->owner);
+        }
+#endif
+
+        constexpr bool atElement([[maybe_unused]] const T* ptr) const {
+#if COOLSTD_CHECKS
+            const vector* vec = holder();
+            return vec == nullptr || vec->holds(ptr);
+#else
+            return true;
+#endif
+        }
+
+        constexpr void checkReachable() const {
+#if COOLSTD_CHECKS
+            const vector* vec = holder();
+            COOLSTD_CHECK(vec == nullptr || vec->reaches(ptr_),
+                          "iterator moved outside [begin(), end()]");
+#endif
+        }
+
         pointer ptr_;
+#if COOLSTD_CHECKS
+        // The record of the buffer the iterator was made in and its generation then, the buffer
+        // itself, and whether it came from a vector at all: iterators made from a bare pointer
+        // are not checked.
+        const checks::detail::buffer_record* record_ = nullptr;
+        std::uint64_t generation_ = 0;
+        const T* buffer_ = nullptr;
+        bool checked_ = false;
+#endif
     };
 
     using value_type = T;
     using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using instrumentation = Instrumentation;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
     using reference = value_type&;
@@ -221,6 +1101,20 @@ public:
 
     constexpr vector(std::initializer_list<T>, const Allocator& = Allocator());
 
+    // Parallel construction: the elements are constructed in page-sized chunks on the threads
+    // exec schedules them on, which also decides which thread first touches, and so on NUMA
+    // systems places, each page. Constructing with par::schedule::fixed and processing with it
+    // later keeps every thread on memory local to it. Types whose construction can throw are
+    // constructed on the calling thread.
+    template <chunk_executor Executor>
+    vector(const Executor& exec, size_type count, const Allocator& alloc = Allocator());
+    template <chunk_executor Executor>
+    vector(const Executor& exec, size_type count, const T& value,
+           const Allocator& alloc = Allocator());
+    template <chunk_executor Executor, std::random_access_iterator RandomIt>
+    vector(const Executor& exec, RandomIt first, RandomIt last,
+           const Allocator& alloc = Allocator());
+
     constexpr ~vector();
 
     constexpr vector& operator=(const vector& x);
@@ -238,28 +1132,34 @@ public:
             nullptr);
     constexpr void assign(size_type count, const T& value);
     constexpr void assign(std::initializer_list<T>);
+    // Parallel versions of assign(); see the parallel constructors. Elements already present
+    // are destroyed and reconstructed rather than assigned to.
+    template <chunk_executor Executor>
+    void assign(const Executor& exec, size_type count, const T& value);
+    template <chunk_executor Executor, std::random_access_iterator RandomIt>
+    void assign(const Executor& exec, RandomIt first, RandomIt last);
     constexpr allocator_type get_allocator() const noexcept {
         return allocator;
     }
 
     // iterators
     constexpr iterator begin() noexcept {
-        return iterator(data_);
+        return iterator(data_, this);
     }
     constexpr iterator end() noexcept {
-        return iterator(data_ + sz_);
+        return iterator(data_ + sz_, this);
     }
     constexpr const_iterator begin() const noexcept {
-        return const_iterator(data_);
+        return const_iterator(data_, this);
     }
     constexpr const_iterator end() const noexcept {
-        return const_iterator(data_ + sz_);
+        return const_iterator(data_ + sz_, this);
     }
     constexpr const_iterator cbegin() const noexcept {
-        return const_iterator(data_);
+        return const_iterator(data_, this);
     }
     constexpr const_iterator cend() const noexcept {
-        return const_iterator(data_ + sz_);
+        return const_iterator(data_ + sz_, this);
     }
 
     constexpr reverse_iterator rbegin() noexcept {
@@ -297,38 +1197,56 @@ public:
     }
     constexpr void resize(size_type count);
     constexpr void resize(size_type count, const T& value);
+    // Parallel versions of resize(); only the new elements are constructed in parallel.
+    template <chunk_executor Executor>
+    void resize(const Executor& exec, size_type count);
+    template <chunk_executor Executor>
+    void resize(const Executor& exec, size_type count, const T& value);
+    // Like resize(count), but new elements are default-initialized: for trivial types their
+    // contents are indeterminate until written.
+    constexpr void resize_for_overwrite(size_type count);
+    // Resizes to count as resize_for_overwrite does, then calls op(data(), count), which must
+    // write the elements it keeps and return their number r <= count; size() becomes r.
+    template <class Operation>
+    constexpr void resize_and_overwrite(size_type count, Operation op);
     constexpr void reserve(size_type count);
     constexpr void shrink_to_fit();
 
     // element access
     constexpr reference operator[](size_type n) {
+        COOLSTD_CHECK(n < sz_, "vector index out of range");
         return data_[n];
     }
     constexpr const_reference operator[](size_type n) const {
+        COOLSTD_CHECK(n < sz_, "vector index out of range");
         return data_[n];
     }
     constexpr reference at(size_type pos);
     constexpr const_reference at(size_type pos) const;
 
     constexpr reference front() {
+        COOLSTD_CHECK(sz_ > 0, "front() on an empty vector");
         return data_[0];
     }
     constexpr const_reference front() const {
+        COOLSTD_CHECK(sz_ > 0, "front() on an empty vector");
         return data_[0];
     }
     constexpr reference back() {
+        COOLSTD_CHECK(sz_ > 0, "back() on an empty vector");
         return data_[sz_ - 1];
     }
     constexpr const_reference back() const {
+        COOLSTD_CHECK(sz_ > 0, "back() on an empty vector");
         return data_[sz_ - 1];
     }
 
     // data access
     constexpr T* data() noexcept {
-        return data_;
+        return std::assume_aligned<detail::allocator_alignment<Allocator>::value>(data_);
     }
     constexpr const T* data() const noexcept {
-        return data_;
+        return std::assume_aligned<detail::allocator_alignment<Allocator>::value>(data_);
     }
 
     // modifiers
@@ -351,9 +1269,55 @@ public:
             typename std::iterator_traits<InputIterator>::iterator_category>::value>::type* =
             nullptr);
     constexpr iterator insert(const_iterator position, std::initializer_list<T> il);
+    // C++23-style range insertion. Sized and forward ranges are inserted with a single growth
+    // (one memcpy for contiguous trivially copyable elements); input ranges are appended one by
+    // one with geometric growth and then rotated into place.
+    template <std::ranges::input_range Range>
+    constexpr iterator insert_range(const_iterator position, Range&& range);
+    template <std::ranges::input_range Range>
+    constexpr void append_range(Range&& range);
 
     constexpr iterator erase(const_iterator position);
     constexpr iterator erase(const_iterator first, const_iterator last);
+    // Erases the element at position in O(1) by moving the last element into its place, so the
+    // order of the remaining elements is not kept. Returns an iterator to the moved element, or
+    // end() if position was the last one.
+    constexpr iterator erase_unordered(const_iterator position);
+    // Erases the elements at the given indices, which must be ascending (repeats are ignored)
+    // and below size(), in one sweep that moves each kept element at most once. Returns the
+    // number erased.
+    template <std::ranges::input_range Indices>
+    constexpr size_type erase_indices(const Indices& indices);
+
+    // Erases every element for which pred returns true, in one sweep; pred is called once per
+    // element, in order. Returns the number erased. If pred throws, the elements it rejected so
+    // far are erased and the rest are kept.
+    template <class Predicate>
+    friend constexpr size_type erase_if(vector& vec, Predicate pred) {
+        size_type write = 0;
+        size_type read = 0;
+
+        // Kept elements move down one at a time: pred has to see each one anyway, and batching
+        // them into runs only pays when runs are long, which erase_indices() can tell up front.
+        try {
+            for (; read < vec.sz_; ++read) {
+                if (pred(vec.data_[read])) {
+                    vec.compactDrop(read);
+                } else {
+                    vec.compactRun(read, read + 1, write);
+                }
+            }
+        } catch (...) {
+            vec.compactFinish(read, write);
+            throw;
+        }
+
+        return vec.compactFinish(read, write);
+    }
+    template <class U>
+    friend constexpr size_type erase(vector& vec, const U& value) {
+        return erase_if(vec, [&](const T& element) { return element == value; });
+    }
 
     constexpr void swap(vector&) noexcept(
         std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
@@ -368,178 +1332,358 @@ private:
     size_type cap_ = 0;
     T* data_ = nullptr;
     Allocator allocator;
+#if COOLSTD_CHECKS
+    // The record of data_, which the iterators into it go through; see buffer_record.
+    checks::detail::buffer_record* record_ = nullptr;
+#endif
 
     // helpers
-    template <class InputIterator>
-    void assignRangeForward(InputIterator from, InputIterator to, pointer destination);
+    // Checked builds keep record_ in step with data_: trackBuffer() once data_ is a new block
+    // (releasing the old block's record if that is still held), swapRecords() wherever blocks
+    // change hands between vectors, and destroyPointer() releases the record with its block.
+    constexpr void trackBuffer() noexcept {
+#if COOLSTD_CHECKS
+        if (record_ != nullptr) {
+            checks::detail::releaseRecord(record_);
+            record_ = nullptr;
+        }
+        if (!std::is_constant_evaluated() && data_ != nullptr) {
+            record_ = checks::detail::acquireRecord(this);
+        }
+#endif
+    }
+    constexpr void swapRecords([[maybe_unused]] vector& other) noexcept {
+#if COOLSTD_CHECKS
+        std::swap(record_, other.record_);
+        if (record_ != nullptr) {
+            record_->owner = this;
+        }
+        if (other.record_ != nullptr) {
+            other.record_->owner = &other;
+        }
+#endif
+    }
+    // Whether ptr is within [data_, data_ + sz_], or at an element; for COOLSTD_CHECK.
+    constexpr bool reaches(const T* ptr) const noexcept {
+        return !std::less<const T*>()(ptr, data_) && !std::less<const T*>()(data_ + sz_, ptr);
+    }
+    constexpr bool holds(const T* ptr) const noexcept {
+        return reaches(ptr) && ptr != data_ + sz_;
+    }
+    // Index of an insert position, which must be within [begin(), end()].
+    constexpr size_type indexOf(const_iterator position) const {
+        COOLSTD_CHECK(reaches(position.ptr_), "position is outside [begin(), end()]");
+        return size_type(position.ptr_ - data_);
+    }
+    // Compaction, for erase_if and erase_indices. [0, write) holds the kept elements so far,
+    // [run, end) kept elements not yet moved down, and the slots in between dropped elements:
+    // destroyed right away for bitwise relocatable T, which is then moved a run at a time with
+    // memmove, or left for compactFinish() to destroy otherwise.
+    static constexpr size_type compactCopyBytes = 128;
+    constexpr void compactRun(size_type run, size_type end, size_type& write);
+    constexpr void compactDrop(size_type index) noexcept;
+    // Moves down the kept elements from run on and sets the size; returns the number dropped.
+    constexpr size_type compactFinish(size_type run, size_type write) noexcept;
 
     template <class InputIterator>
-    void assignRangeBackward(InputIterator from, InputIterator to, pointer destination);
+    constexpr void assignRangeForward(InputIterator from, InputIterator to, pointer destination);
 
     template <class InputIterator>
-    void moveRangeForward(InputIterator from, InputIterator to, pointer destination);
+    constexpr void assignRangeBackward(InputIterator from, InputIterator to, pointer destination);
 
     template <class InputIterator>
-    void copyRangeForward(InputIterator from, InputIterator to, pointer destination);
-
-    void copyRangeForward(pointer from, pointer to, const_reference value);
+    constexpr void moveRangeForward(InputIterator from, InputIterator to, pointer destination);
 
+    // Inserts copies of the count elements starting at first, growing at most once.
     template <class InputIterator>
-    void copyRangeBackward(InputIterator from, InputIterator to, pointer destination);
-
-    T* grow(size_type newCap, bool copy = false, size_type gapIndex = 0, size_type gapSize = 0);
-
-    void destroyRange(pointer from, pointer to);
-    void destroyPointer(pointer ptr);
+    constexpr iterator insertCounted(size_type positionAsIndex, InputIterator first,
+                                     size_type count);
+
+    // Single-pass insertion for ranges of unknown length.
+    template <class InputIterator, class Sentinel>
+    constexpr iterator insertUnsized(size_type positionAsIndex, InputIterator first, Sentinel last);
+
+    // Capacity to grow to so that at least `required` elements fit, as chosen by GrowthPolicy.
+    constexpr size_type nextCapacity(size_type required) const;
+
+    // Moves the elements into a fresh buffer of at least newCap elements. The Fill overload first
+    // lets fill(newData + gapIndex) construct gapSize new elements, so arguments that alias the
+    // old buffer are read before it is relocated; the vector is untouched if anything throws.
+    // Allocators that can extend a block in place or realloc it are given the chance first.
+    constexpr void grow(size_type newCap);
+    template <class Fill>
+    constexpr void grow(size_type newCap, size_type gapIndex, size_type gapSize, Fill fill);
+
+    // grow() for allocators with reallocate() and trivially relocatable T, with at most one new
+    // element (or any number for single-block allocators): the block is resized realloc-style,
+    // which can avoid copying entirely.
+    template <class Fill>
+    void reallocate(size_type newCap, size_type gapIndex, size_type gapSize, Fill fill);
+    // The block resize behind reallocate(): leaves an unconstructed gap of gapSize elements at
+    // gapIndex. Throws only before anything has changed.
+    void reallocateBlock(size_type newCap, size_type gapIndex, size_type gapSize);
+
+    // assign() past capacity for single-block allocators, which can't hold a second block while
+    // the first is live: the old elements go first and the block grows through grow(), where
+    // fill constructs the count new elements. If fill throws, the vector is left empty.
+    template <class Fill>
+    constexpr void reassign(size_type count, Fill fill);
+
+    // Trivially relocatable T only: slides the elements from gapIndex on up by gapSize slots with
+    // one memmove and lets fill construct the new elements in the hole, sliding the tail back if
+    // it throws.
+    template <class Fill>
+    constexpr void shiftAndFill(size_type gapIndex, size_type gapSize, Fill fill);
+
+    // How relocate() carries elements to a new block, as reported to Instrumentation.
+    static constexpr instrument::relocation relocationKind =
+        detail::is_bitwise_relocatable_v<Allocator, T> ? instrument::relocation::bitwise
+        : std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>
+            ? instrument::relocation::moved
+            : instrument::relocation::copied;
+
+    constexpr pointer allocate(size_type count);
+    constexpr void destroyRange(pointer from, pointer to);
+    constexpr void destroyPointer(pointer ptr);
 };
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::vector(const Allocator& alloc) noexcept
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(
+    const Allocator& alloc) noexcept
     : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::vector(size_type count, const Allocator& alloc)
-    : sz_(0), cap_(count), data_(nullptr), allocator(alloc) {
-
-    data_ = std::allocator_traits<Allocator>::allocate(allocator, cap_);
-
-    for (; sz_ < count; ++sz_) {
-        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_);
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(size_type count,
+                                                                      const Allocator& alloc)
+    : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
+    if (count > 0) {
+        grow(count, 0, count,
+             [&](pointer gap) { detail::uninitializedFill(allocator, gap, count); });
+        sz_ = count;
     }
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::vector(size_type count, const T& value, const Allocator& alloc)
-    : sz_(0), cap_(count), data_(nullptr), allocator(alloc) {
-
-    data_ = std::allocator_traits<Allocator>::allocate(allocator, cap_);
-
-    for (; sz_ < count; ++sz_) {
-        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_, value);
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(size_type count,
+                                                                      const T& value,
+                                                                      const Allocator& alloc)
+    : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
+    if (count > 0) {
+        grow(count, 0, count,
+             [&](pointer gap) { detail::uninitializedFill(allocator, gap, count, value); });
+        sz_ = count;
     }
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
 template <class InputIterator>
-constexpr vector<T, Allocator>::vector(
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(
     InputIterator first, InputIterator last, const Allocator& alloc,
     typename std::enable_if<std::is_base_of<
         std::input_iterator_tag,
         typename std::iterator_traits<InputIterator>::iterator_category>::value>::type*)
-    : sz_(0), data_(nullptr), allocator(alloc) {
-    const size_type count = size_type(last - first);
-
-    cap_ = count;
-    data_ = std::allocator_traits<Allocator>::allocate(allocator, cap_);
-
-    for (; sz_ < count; ++sz_) {
-        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_, *(first + sz_));
+    : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
+    if constexpr (std::is_base_of_v<
+                      std::forward_iterator_tag,
+                      typename std::iterator_traits<InputIterator>::iterator_category>) {
+        const size_type count = size_type(std::distance(first, last));
+
+        if (count > 0) {
+            grow(count, 0, count, [&](pointer gap) {
+                detail::uninitializedCopyN(allocator, first, count, gap);
+            });
+            sz_ = count;
+        }
+    } else {
+        insertUnsized(0, first, last);
     }
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::vector(const vector& copyVector)
-    : sz_(0), cap_(copyVector.capacity()), data_(nullptr), allocator(copyVector.allocator) {
-
-    if (cap_ > 0) {
-        data_ = std::allocator_traits<Allocator>::allocate(allocator, cap_);
-    }
-
-    for (; sz_ < copyVector.size(); ++sz_) {
-        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_, copyVector[sz_]);
-    }
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(const vector& copyVector)
+    : vector(copyVector, std::allocator_traits<Allocator>::select_on_container_copy_construction(
+                             copyVector.allocator)) {
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::vector(const vector& copyVector, const Allocator& alloc)
-    : sz_(0), cap_(copyVector.capacity()), data_(nullptr), allocator(alloc) {
-
-    if (cap_ > 0) {
-        data_ = std::allocator_traits<Allocator>::allocate(allocator, cap_);
-    }
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(const vector& copyVector,
+                                                                      const Allocator& alloc)
+    : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
+    const size_type count = copyVector.size();
 
-    for (; sz_ < copyVector.size(); ++sz_) {
-        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_, copyVector[sz_]);
+    if (count > 0) {
+        grow(count, 0, count, [&](pointer gap) {
+            detail::uninitializedCopyN(allocator, copyVector.data_, count, gap);
+        });
+        sz_ = count;
     }
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::vector(vector&& moveVector) noexcept
-    : sz_(moveVector.size()), cap_(moveVector.capacity()), data_(moveVector.data_) {
-    moveVector.sz_ = 0;
-    moveVector.cap_ = 0;
-    moveVector.data_ = nullptr;
-}
-
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::vector(vector&& moveVector, const Allocator& alloc)
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(vector&& moveVector) noexcept
     : sz_(moveVector.size()),
       cap_(moveVector.capacity()),
       data_(moveVector.data_),
-      allocator(alloc) {
+      allocator(std::move(moveVector.allocator)) {
     moveVector.sz_ = 0;
     moveVector.cap_ = 0;
     moveVector.data_ = nullptr;
+    swapRecords(moveVector);
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::vector(std::initializer_list<value_type> initializerList,
-                                       const Allocator& alloc)
-    : sz_(0), cap_(initializerList.size()), data_(nullptr), allocator(alloc) {
-    if (cap_ > 0) {
-        data_ = std::allocator_traits<Allocator>::allocate(allocator, cap_);
-    }
-
-    for (; sz_ < initializerList.size(); ++sz_) {
-        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_,
-                                                    *(initializerList.begin() + sz_));
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(vector&& moveVector,
+                                                                      const Allocator& alloc)
+    : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
+    if (std::allocator_traits<Allocator>::is_always_equal::value ||
+        allocator == moveVector.allocator) {
+        std::swap(sz_, moveVector.sz_);
+        std::swap(cap_, moveVector.cap_);
+        std::swap(data_, moveVector.data_);
+        swapRecords(moveVector);
+    } else if (!moveVector.empty()) {
+        // A buffer can't change allocators, so the elements are moved one by one.
+        const size_type count = moveVector.size();
+
+        grow(count, 0, count, [&](pointer gap) {
+            detail::uninitializedCopyN(allocator, std::make_move_iterator(moveVector.data_), count,
+                                       gap);
+        });
+        sz_ = count;
     }
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::~vector() {
-    destroyRange(data_, data_ + sz_);
-    destroyPointer(data_);
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(
+    std::initializer_list<value_type> initializerList, const Allocator& alloc)
+    : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
+    const size_type count = initializerList.size();
 
-    sz_ = 0;
-    cap_ = 0;
-    data_ = nullptr;
+    if (count > 0) {
+        grow(count, 0, count, [&](pointer gap) {
+            detail::uninitializedCopyN(allocator, initializerList.begin(), count, gap);
+        });
+        sz_ = count;
+    }
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>& vector<T, Allocator>::operator=(const vector& copyVector) {
-    if (this != &copyVector) {
-        assign(copyVector.begin(), copyVector.end());
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <chunk_executor Executor>
+vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(const Executor& exec, size_type count,
+                                                            const Allocator& alloc)
+    : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
+    if (count > 0) {
+        grow(count, 0, count,
+             [&](pointer gap) { detail::parallelFill(exec, allocator, gap, count); });
+        sz_ = count;
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <chunk_executor Executor>
+vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(const Executor& exec, size_type count,
+                                                            const T& value,
+                                                            const Allocator& alloc)
+    : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
+    if (count > 0) {
+        grow(count, 0, count,
+             [&](pointer gap) { detail::parallelFill(exec, allocator, gap, count, value); });
+        sz_ = count;
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <chunk_executor Executor, std::random_access_iterator RandomIt>
+vector<T, Allocator, GrowthPolicy, Instrumentation>::vector(const Executor& exec, RandomIt first,
+                                                            RandomIt last, const Allocator& alloc)
+    : sz_(0), cap_(0), data_(nullptr), allocator(alloc) {
+    const size_type count = size_type(last - first);
+
+    if (count > 0) {
+        grow(count, 0, count,
+             [&](pointer gap) { detail::parallelCopyN(exec, allocator, first, count, gap); });
+        sz_ = count;
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::~vector() {
+    destroyRange(data_, data_ + sz_);
+    destroyPointer(data_);
+
+    sz_ = 0;
+    cap_ = 0;
+    data_ = nullptr;
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>&
+vector<T, Allocator, GrowthPolicy, Instrumentation>::operator=(const vector& copyVector) {
+    if (this != &copyVector) {
+        if constexpr (std::allocator_traits<
+                          Allocator>::propagate_on_container_copy_assignment::value) {
+            // The current buffer belongs to the allocator being replaced.
+            if (allocator != copyVector.allocator) {
+                destroyRange(data_, data_ + sz_);
+                destroyPointer(data_);
+                data_ = nullptr;
+                cap_ = 0;
+                sz_ = 0;
+            }
+            allocator = copyVector.allocator;
+        }
+
+        assign(copyVector.begin(), copyVector.end());
     }
 
     return *this;
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>& vector<T, Allocator>::operator=(vector&& moveVector) noexcept(
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>&
+vector<T, Allocator, GrowthPolicy, Instrumentation>::operator=(vector&& moveVector) noexcept(
     std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
     std::allocator_traits<Allocator>::is_always_equal::value) {
     if (this == &moveVector) {
         return *this;
     }
 
-    clear();
-    swap(moveVector);
+    constexpr bool propagate =
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value;
+
+    if (propagate || std::allocator_traits<Allocator>::is_always_equal::value ||
+        allocator == moveVector.allocator) {
+        destroyRange(data_, data_ + sz_);
+        destroyPointer(data_);
+
+        if constexpr (propagate) {
+            allocator = std::move(moveVector.allocator);
+        }
+        data_ = std::exchange(moveVector.data_, nullptr);
+        cap_ = std::exchange(moveVector.cap_, 0);
+        sz_ = std::exchange(moveVector.sz_, 0);
+        swapRecords(moveVector);
+    } else {
+        assign(std::make_move_iterator(moveVector.begin()),
+               std::make_move_iterator(moveVector.end()));
+    }
 
     return *this;
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>& vector<T, Allocator>::operator=(
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>&
+vector<T, Allocator, GrowthPolicy, Instrumentation>::operator=(
     std::initializer_list<value_type> initializerList) {
     assign(initializerList);
 
     return *this;
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::reference vector<T, Allocator>::at(size_type pos) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::reference
+vector<T, Allocator, GrowthPolicy, Instrumentation>::at(size_type pos) {
     if (pos < sz_) {
         return data_[pos];
     }
@@ -547,8 +1691,9 @@ constexpr vector<T, Allocator>::reference vector<T, Allocator>::at(size_type pos
     throw(std::out_of_range("Pos is out-of-range!"));
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::const_reference vector<T, Allocator>::at(size_type pos) const {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::const_reference
+vector<T, Allocator, GrowthPolicy, Instrumentation>::at(size_type pos) const {
     if (pos < sz_) {
         return data_[pos];
     }
@@ -556,23 +1701,43 @@ constexpr vector<T, Allocator>::const_reference vector<T, Allocator>::at(size_ty
     throw(std::out_of_range("Pos is out-of-range!"));
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
 template <class InputIterator>
-constexpr void vector<T, Allocator>::assign(
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::assign(
     InputIterator first, InputIterator last,
     typename std::enable_if<std::is_base_of<
         std::input_iterator_tag,
         typename std::iterator_traits<InputIterator>::iterator_category>::value>::type*) {
-    const size_type count = size_type(last - first);
+    if constexpr (!std::is_base_of_v<
+                      std::forward_iterator_tag,
+                      typename std::iterator_traits<InputIterator>::iterator_category>) {
+        clear();
+        insertUnsized(0, first, last);
+        return;
+    }
+
+    const size_type count = size_type(std::distance(first, last));
 
     size_type copied = 0;
 
-    if (count > capacity()) {
-        value_type* newData = std::allocator_traits<Allocator>::allocate(allocator, count);
-        ;
+    if constexpr (detail::is_single_block<Allocator>::value) {
+        if (count > capacity()) {
+            // More elements than fit can't all come from this vector.
+            return reassign(count, [&](pointer gap) {
+                detail::uninitializedCopyN(allocator, first, count, gap);
+            });
+        }
+    }
 
-        for (; (copied < count) && (first != last); ++copied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + copied, *(first++));
+    if (count > capacity()) {
+        value_type* newData = allocate(count);
+
+        try {
+            detail::uninitializedCopyN(allocator, first, count, newData);
+        } catch (...) {
+            Instrumentation::on_deallocate(count, 0, sizeof(T));
+            std::allocator_traits<Allocator>::deallocate(allocator, newData, count);
+            throw;
         }
 
         destroyRange(data_, data_ + sz_);
@@ -580,6 +1745,16 @@ constexpr void vector<T, Allocator>::assign(
 
         data_ = newData;
         cap_ = count;
+        trackBuffer();
+    } else if (detail::is_memcpy_range_v<Allocator, InputIterator, T> &&
+               !std::is_constant_evaluated()) {
+        // memmove: the source may be a subrange of this vector.
+        if constexpr (detail::is_memcpy_range_v<Allocator, InputIterator, T>) {
+            if (count > 0) {
+                std::memmove(static_cast<void*>(data_),
+                             static_cast<const void*>(std::to_address(first)), count * sizeof(T));
+            }
+        }
     } else {
 
         for (; (copied < size()) && (copied < count); ++copied) {
@@ -598,15 +1773,29 @@ constexpr void vector<T, Allocator>::assign(
     sz_ = count;
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::assign(size_type count, const T& value) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::assign(size_type count,
+                                                                           const T& value) {
     size_type copied = 0;
 
-    if (count > capacity()) {
-        value_type* newData = std::allocator_traits<Allocator>::allocate(allocator, count);
+    if constexpr (detail::is_single_block<Allocator>::value) {
+        if (count > capacity()) {
+            const T copy(value);
+            return reassign(count, [&](pointer gap) {
+                detail::uninitializedFill(allocator, gap, count, copy);
+            });
+        }
+    }
 
-        for (; copied < count; ++copied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + copied, value);
+    if (count > capacity()) {
+        value_type* newData = allocate(count);
+
+        try {
+            detail::uninitializedFill(allocator, newData, count, value);
+        } catch (...) {
+            Instrumentation::on_deallocate(count, 0, sizeof(T));
+            std::allocator_traits<Allocator>::deallocate(allocator, newData, count);
+            throw;
         }
 
         destroyRange(data_, data_ + sz_);
@@ -614,6 +1803,12 @@ constexpr void vector<T, Allocator>::assign(size_type count, const T& value) {
 
         data_ = newData;
         cap_ = count;
+        trackBuffer();
+    } else if (simd::is_element_v<T> && !detail::has_custom_construct<Allocator, T>::value &&
+               !std::is_constant_evaluated()) {
+        if constexpr (simd::is_element_v<T>) {
+            simd::fill(data_, count, value);
+        }
     } else {
         for (; (copied < size()) && (copied < count); ++copied) {
             *(data_ + copied) = value;
@@ -631,392 +1826,482 @@ constexpr void vector<T, Allocator>::assign(size_type count, const T& value) {
     sz_ = count;
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::assign(std::initializer_list<T> initializerList) {
-    size_type copied = 0;
-
-    if (initializerList.size() > capacity()) {
-        value_type* newData =
-            std::allocator_traits<Allocator>::allocate(allocator, initializerList.size());
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::assign(
+    std::initializer_list<T> initializerList) {
+    assign(initializerList.begin(), initializerList.end());
+}
 
-        for (; copied < initializerList.size(); ++copied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + copied,
-                                                        *(initializerList.begin() + copied));
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <chunk_executor Executor>
+void vector<T, Allocator, GrowthPolicy, Instrumentation>::assign(const Executor& exec,
+                                                                 size_type count, const T& value) {
+    if constexpr (detail::is_single_block<Allocator>::value) {
+        if (count > capacity()) {
+            const T copy(value);
+            return reassign(count, [&](pointer gap) {
+                detail::parallelFill(exec, allocator, gap, count, copy);
+            });
         }
+    }
 
-        destroyRange(data_, data_ + sz_);
-        destroyPointer(data_);
+    if (count > capacity()) {
+        // Built in full before the old buffer goes, which also keeps an aliased value valid.
+        vector replacement(exec, count, value, allocator);
+        std::swap(sz_, replacement.sz_);
+        std::swap(cap_, replacement.cap_);
+        std::swap(data_, replacement.data_);
+        swapRecords(replacement);
+        return;
+    }
 
-        data_ = newData;
-        cap_ = initializerList.size();
-    } else {
+    const T copy(value);
+    clear();
+    detail::parallelFill(exec, allocator, data_, count, copy);
+    sz_ = count;
+}
 
-        for (; (copied < size()) && (copied < initializerList.size()); ++copied) {
-            *(data_ + copied) = *(initializerList.begin() + copied);
-        }
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <chunk_executor Executor, std::random_access_iterator RandomIt>
+void vector<T, Allocator, GrowthPolicy, Instrumentation>::assign(const Executor& exec,
+                                                                 RandomIt first, RandomIt last) {
+    const size_type count = size_type(last - first);
 
-        for (; copied < initializerList.size(); ++copied) {
-            std::allocator_traits<Allocator>::construct(allocator, data_ + copied,
-                                                        *(initializerList.begin() + copied));
+    if constexpr (detail::is_single_block<Allocator>::value) {
+        if (count > capacity()) {
+            return reassign(count, [&](pointer gap) {
+                detail::parallelCopyN(exec, allocator, first, count, gap);
+            });
         }
+    }
 
-        for (size_type index = size(); index > initializerList.size(); --index) {
-            std::allocator_traits<Allocator>::destroy(allocator, data_ + index - 1);
-        }
+    if (count > capacity()) {
+        vector replacement(exec, first, last, allocator);
+        std::swap(sz_, replacement.sz_);
+        std::swap(cap_, replacement.cap_);
+        std::swap(data_, replacement.data_);
+        swapRecords(replacement);
+        return;
     }
 
-    sz_ = initializerList.size();
+    // As with assign(first, last), [first, last) must not point into this vector.
+    clear();
+    detail::parallelCopyN(exec, allocator, first, count, data_);
+    sz_ = count;
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::push_back(const T& value) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::push_back(const T& value) {
     if (size() == capacity()) {
-        value_type* newData = grow(2 * cap_, true);
-
-        destroyRange(data_, data_ + sz_);
-        destroyPointer(data_);
-
-        data_ = newData;
-        cap_ = 2 * cap_;
+        grow(nextCapacity(sz_ + 1), sz_, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap, value);
+        });
+    } else {
+        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_, value);
     }
 
-    std::allocator_traits<Allocator>::construct(allocator, data_ + sz_, value);
-
     sz_++;
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::push_back(T&& value) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::push_back(T&& value) {
     emplace_back(std::move(value));
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::pop_back() {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::pop_back() {
+    COOLSTD_CHECK(sz_ > 0, "pop_back() on an empty vector");
     --sz_;
     std::allocator_traits<Allocator>::destroy(allocator, data_ + sz_);
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
 template <class InputIterator>
-constexpr vector<T, Allocator>::iterator vector<T, Allocator>::insert(
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::insert(
     const_iterator position, InputIterator first, InputIterator last,
     typename std::enable_if<std::is_base_of<
         std::input_iterator_tag,
         typename std::iterator_traits<InputIterator>::iterator_category>::value>::type*) {
-    const size_type numberOfElements = size_type(std::distance(first, last));
-    const size_type positionAsIndex = size_type(position - begin());
-
-    if (size() + numberOfElements > capacity()) {
-        value_type* newData = nullptr;
-        size_type copied = 0, constructed = 0;
-
-        newData = std::allocator_traits<Allocator>::allocate(allocator, size() + numberOfElements);
+    const size_type positionAsIndex = indexOf(position);
 
-        for (; (constructed < numberOfElements) && (first != last); ++constructed) {
-            std::allocator_traits<Allocator>::construct(
-                allocator, newData + positionAsIndex + constructed, *(first++));
-        }
-
-        for (; copied < positionAsIndex; ++copied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + copied,
-                                                        *(data_ + copied));
-        }
+    if constexpr (std::is_base_of_v<
+                      std::forward_iterator_tag,
+                      typename std::iterator_traits<InputIterator>::iterator_category>) {
+        return insertCounted(positionAsIndex, first, size_type(std::distance(first, last)));
+    } else {
+        return insertUnsized(positionAsIndex, first, last);
+    }
+}
 
-        for (; copied < sz_; ++copied) {
-            std::allocator_traits<Allocator>::construct(
-                allocator, newData + copied + numberOfElements, *(data_ + copied));
-        }
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <std::ranges::input_range Range>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::insert_range(const_iterator position,
+                                                                  Range&& range) {
+    const size_type positionAsIndex = indexOf(position);
 
-        destroyRange(data_, data_ + sz_);
-        destroyPointer(data_);
+    if constexpr (std::ranges::forward_range<Range> || std::ranges::sized_range<Range>) {
+        const size_type count = size_type(std::ranges::distance(range));
 
-        data_ = newData;
-        cap_ = size() + numberOfElements;
-        sz_ += numberOfElements;
+        return insertCounted(positionAsIndex, std::ranges::begin(range), count);
     } else {
-        if (numberOfElements <= (size() - positionAsIndex)) {
-            moveRangeForward(end() - numberOfElements, end(), data_ + sz_);
-
-            assignRangeForward(begin() + positionAsIndex, end() - numberOfElements,
-                               data_ + positionAsIndex + numberOfElements);
-        } else {
-            moveRangeForward(begin() + positionAsIndex, end(),
-                             data_ + (numberOfElements + positionAsIndex));
-        }
-        sz_ += numberOfElements;
-
-        size_type constructed = 0;
-        for (; (constructed < numberOfElements) && (first != last); ++constructed) {
-            *(data_ + positionAsIndex + constructed) = *(first++);
-        }
+        return insertUnsized(positionAsIndex, std::ranges::begin(range), std::ranges::end(range));
     }
+}
 
-    return iterator(data_ + positionAsIndex);
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <std::ranges::input_range Range>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::append_range(Range&& range) {
+    insert_range(end(), std::forward<Range>(range));
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::iterator vector<T, Allocator>::insert(const_iterator position,
-                                                                      size_type count,
-                                                                      const T& value) {
-    const size_type positionAsIndex = size_type(position - begin());
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::insert(const_iterator position,
+                                                            size_type count, const T& value) {
+    const size_type positionAsIndex = indexOf(position);
 
     if (size() + count > capacity()) {
-        value_type* newData = nullptr;
-        size_type copied = 0, constructed = 0;
-
-        newData = std::allocator_traits<Allocator>::allocate(allocator, size() + count);
-
-        for (; constructed < count; ++constructed) {
-            std::allocator_traits<Allocator>::construct(
-                allocator, newData + positionAsIndex + constructed, value);
-        }
-
-        for (; copied < positionAsIndex; ++copied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + copied,
-                                                        *(data_ + copied));
-        }
+        // value may be an element, and a single-block allocator fills after the block moves.
+        T temp(value);
 
-        for (; copied < sz_; ++copied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + copied + count,
-                                                        *(data_ + copied));
-        }
+        grow(nextCapacity(size() + count), positionAsIndex, count,
+             [&](pointer gap) { detail::uninitializedFill(allocator, gap, count, temp); });
 
-        destroyRange(data_, data_ + sz_);
-        destroyPointer(data_);
-
-        data_ = newData;
-        cap_ = size() + count;
         sz_ += count;
+    } else if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        T temp(value);
+
+        shiftAndFill(positionAsIndex, count,
+                     [&](pointer gap) { detail::uninitializedFill(allocator, gap, count, temp); });
     } else {
         T temp(value);
+        const size_type tail = sz_ - positionAsIndex;
 
-        if (count <= (size() - positionAsIndex)) {
+        Instrumentation::on_shift(tail, sizeof(T));
+        if (count <= tail) {
+            // The last count elements move into raw storage, the rest of the tail slides up over
+            // live ones (back to front, since the ranges overlap), and the gap is assigned.
             moveRangeForward(end() - count, end(), data_ + sz_);
-            assignRangeForward(begin() + positionAsIndex, begin() + sz_ - count,
-                               data_ + positionAsIndex + count);
-
+            assignRangeBackward(begin() + positionAsIndex, end() - count,
+                                data_ + positionAsIndex + count);
+            sz_ += count;
+            std::fill_n(data_ + positionAsIndex, count, temp);
         } else {
-            moveRangeForward(begin() + positionAsIndex, end(), data_ + (count + positionAsIndex));
-        }
-        sz_ += count;
-
-        size_type constructed = 0;
-        for (; constructed < count; ++constructed) {
-            *(data_ + positionAsIndex + constructed) = temp;
+            // The gap reaches past the old end: that part of it is raw storage and is
+            // constructed, the tail moves beyond it, and the gap's live part is assigned.
+            detail::uninitializedFill(allocator, data_ + sz_, count - tail, temp);
+            moveRangeForward(begin() + positionAsIndex, end(), data_ + positionAsIndex + count);
+            std::fill_n(data_ + positionAsIndex, tail, temp);
+            sz_ += count;
         }
     }
 
-    return iterator(data_ + positionAsIndex);
+    return iterator(data_ + positionAsIndex, this);
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::iterator vector<T, Allocator>::insert(const_iterator position,
-                                                                      const T& value) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::insert(const_iterator position,
+                                                            const T& value) {
     if (position == end()) {
         push_back(value);
 
         return (end() - 1);
     }
 
-    const size_type positionAsIndex = size_type(position - begin());
+    const size_type positionAsIndex = indexOf(position);
 
     if (size() == capacity()) {
-        value_type* newData = nullptr;
-        size_type numOfCopied = 0;
-
-        newData = std::allocator_traits<Allocator>::allocate(allocator, 2 * cap_);
+        grow(nextCapacity(sz_ + 1), positionAsIndex, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap, value);
+        });
 
-        std::allocator_traits<Allocator>::construct(allocator, newData + positionAsIndex, value);
-
-        for (; numOfCopied < positionAsIndex; ++numOfCopied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + numOfCopied,
-                                                        *(data_ + numOfCopied));
-        }
-
-        for (; numOfCopied < sz_; ++numOfCopied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + numOfCopied + 1,
-                                                        *(data_ + numOfCopied));
-        }
-
-        destroyRange(data_, data_ + sz_);
-        destroyPointer(data_);
-
-        data_ = newData;
-        cap_ = 2 * cap_;
         ++sz_;
+    } else if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        T temp(value);
 
+        shiftAndFill(positionAsIndex, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap, std::move(temp));
+        });
     } else {
         T temp(value);
 
-        assignRangeBackward(begin() + positionAsIndex, end(), data_ + positionAsIndex + 1);
+        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_,
+                                                    std::move(*(data_ + sz_ - 1)));
+        assignRangeBackward(begin() + positionAsIndex, end() - 1, data_ + positionAsIndex + 1);
+        Instrumentation::on_shift(sz_ - positionAsIndex, sizeof(T));
         ++sz_;
 
         *(data_ + positionAsIndex) = std::move(temp);
     }
 
-    return iterator(data_ + positionAsIndex);
+    return iterator(data_ + positionAsIndex, this);
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::iterator vector<T, Allocator>::insert(const_iterator position,
-                                                                      T&& value) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::insert(const_iterator position, T&& value) {
     if (position == end()) {
         push_back(std::move(value));
 
         return (end() - 1);
     }
 
-    const size_type positionAsIndex = size_type(position - begin());
+    const size_type positionAsIndex = indexOf(position);
 
     if (size() == capacity()) {
-        value_type* newData = nullptr;
-        size_type numOfCopied = 0;
-
-        newData = std::allocator_traits<Allocator>::allocate(allocator, 2 * cap_);
-
-        std::allocator_traits<Allocator>::construct(allocator, newData + positionAsIndex,
-                                                    std::move(value));
-
-        for (; numOfCopied < positionAsIndex; ++numOfCopied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + numOfCopied,
-                                                        *(data_ + numOfCopied));
-        }
-
-        for (; numOfCopied < sz_; ++numOfCopied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + numOfCopied + 1,
-                                                        *(data_ + numOfCopied));
-        }
-
-        destroyRange(data_, data_ + sz_);
-        destroyPointer(data_);
+        grow(nextCapacity(sz_ + 1), positionAsIndex, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap, std::move(value));
+        });
 
-        data_ = newData;
-        cap_ = 2 * cap_;
         ++sz_;
+    } else if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        T temp(std::move(value));
 
+        shiftAndFill(positionAsIndex, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap, std::move(temp));
+        });
     } else {
         T temp(std::move(value));
 
-        assignRangeBackward(begin() + positionAsIndex, end(), data_ + positionAsIndex + 1);
+        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_,
+                                                    std::move(*(data_ + sz_ - 1)));
+        assignRangeBackward(begin() + positionAsIndex, end() - 1, data_ + positionAsIndex + 1);
+        Instrumentation::on_shift(sz_ - positionAsIndex, sizeof(T));
         ++sz_;
 
         *(data_ + positionAsIndex) = std::move(temp);
     }
 
-    return iterator(data_ + positionAsIndex);
+    return iterator(data_ + positionAsIndex, this);
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::iterator vector<T, Allocator>::insert(
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::insert(
     const_iterator position, std::initializer_list<value_type> initializerList) {
     return insert(position, initializerList.begin(), initializerList.end());
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::iterator vector<T, Allocator>::erase(const_iterator position) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::erase(const_iterator position) {
+    COOLSTD_CHECK(holds(position.ptr_), "erase() position is not at an element");
     if (position == (end() - 1)) {
         pop_back();
 
         return end();
     }
-    const size_type positionAsIndex = size_type(position - begin());
-    assignRangeForward(begin() + 1 + positionAsIndex, end(), data_ + positionAsIndex);
-    destroyRange(data_ + sz_ - 1, data_ + sz_);
+    const size_type positionAsIndex = indexOf(position);
+
+    Instrumentation::on_shift(sz_ - positionAsIndex - 1, sizeof(T));
+    if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        destroyRange(data_ + positionAsIndex, data_ + positionAsIndex + 1);
+        detail::shiftRange(data_ + positionAsIndex + 1, data_ + sz_, data_ + positionAsIndex);
+    } else {
+        assignRangeForward(begin() + 1 + positionAsIndex, end(), data_ + positionAsIndex);
+        destroyRange(data_ + sz_ - 1, data_ + sz_);
+    }
     --sz_;
 
-    return iterator(data_ + (position - begin()));
+    return iterator(data_ + (position - begin()), this);
 }
 
-template <class T, class Allocator>
-constexpr vector<T, Allocator>::iterator vector<T, Allocator>::erase(const_iterator first,
-                                                                     const_iterator last) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::erase(const_iterator first,
+                                                           const_iterator last) {
+    COOLSTD_CHECK(reaches(first.ptr_) && reaches(last.ptr_) && first.ptr_ <= last.ptr_,
+                  "erase() range is not within [begin(), end()]");
     const difference_type distance = std::distance(first, last);
-    const size_type positionAsIndex = size_type(first - begin());
+    const size_type positionAsIndex = indexOf(first);
 
-    assignRangeForward(begin() + positionAsIndex + distance, end(), data_ + positionAsIndex);
-    destroyRange(data_ + sz_ - distance, data_ + sz_);
+    Instrumentation::on_shift(sz_ - positionAsIndex - size_type(distance), sizeof(T));
+    if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        destroyRange(data_ + positionAsIndex, data_ + positionAsIndex + distance);
+        detail::shiftRange(data_ + positionAsIndex + distance, data_ + sz_,
+                           data_ + positionAsIndex);
+    } else {
+        assignRangeForward(begin() + positionAsIndex + distance, end(), data_ + positionAsIndex);
+        destroyRange(data_ + sz_ - distance, data_ + sz_);
+    }
     sz_ -= distance;
 
-    return iterator(data_ + positionAsIndex);
+    return iterator(data_ + positionAsIndex, this);
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::erase_unordered(const_iterator position) {
+    COOLSTD_CHECK(holds(position.ptr_), "erase_unordered() position is not at an element");
+    const size_type positionAsIndex = indexOf(position);
+
+    if (positionAsIndex + 1 != sz_) {
+        if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+            destroyRange(data_ + positionAsIndex, data_ + positionAsIndex + 1);
+            detail::shiftRange(data_ + sz_ - 1, data_ + sz_, data_ + positionAsIndex);
+            --sz_;
+            return iterator(data_ + positionAsIndex, this);
+        } else {
+            data_[positionAsIndex] = std::move(data_[sz_ - 1]);
+        }
+    }
+    pop_back();
+
+    return iterator(data_ + positionAsIndex, this);
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <std::ranges::input_range Indices>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::size_type
+vector<T, Allocator, GrowthPolicy, Instrumentation>::erase_indices(const Indices& indices) {
+    size_type write = 0;
+    size_type run = 0;
+
+    for (auto&& index : indices) {
+        const size_type i = size_type(index);
+
+        COOLSTD_CHECK(i < sz_ && i + 1 >= run,
+                      "erase_indices() needs ascending indices below size()");
+        if (i >= run && i < sz_) {
+            compactRun(run, i, write);
+            compactDrop(i);
+            run = i + 1;
+        }
+    }
+
+    return compactFinish(run, write);
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::swap(vector& swapVector) noexcept(
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::compactRun(size_type run,
+                                                                               size_type end,
+                                                                               size_type& write) {
+    if (write != run) {
+        Instrumentation::on_shift(end - run, sizeof(T));
+        if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+            // Runs are short when many elements go, and a memmove call per element then costs
+            // more than copying the bytes; write < run, so copying forward is safe.
+            if ((end - run) * sizeof(T) <= compactCopyBytes && !std::is_constant_evaluated()) {
+                for (size_type i = run; i < end; ++i) {
+                    std::memcpy(static_cast<void*>(data_ + write + (i - run)),
+                                static_cast<const void*>(data_ + i), sizeof(T));
+                }
+            } else {
+                detail::shiftRange(data_ + run, data_ + end, data_ + write);
+            }
+        } else {
+            std::move(data_ + run, data_ + end, data_ + write);
+        }
+    }
+    write += end - run;
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::compactDrop(
+    size_type index) noexcept {
+    if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        destroyRange(data_ + index, data_ + index + 1);
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::size_type
+vector<T, Allocator, GrowthPolicy, Instrumentation>::compactFinish(size_type run,
+                                                                   size_type write) noexcept {
+    const size_type oldSize = sz_;
+
+    // Moving down can only throw for non-bitwise T, whose moves vector already assumes are
+    // nothrow in erase(); the dropped elements are then destroyed with the moved-from ones.
+    compactRun(run, sz_, write);
+    if constexpr (!detail::is_bitwise_relocatable_v<Allocator, T>) {
+        destroyRange(data_ + write, data_ + sz_);
+    }
+    sz_ = write;
+
+    return oldSize - write;
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::swap(
+    vector& swapVector) noexcept(
     std::allocator_traits<Allocator>::propagate_on_container_swap::value ||
     std::allocator_traits<Allocator>::is_always_equal::value) {
     if (this == &swapVector) {
         return;
     }
 
+    if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator, swapVector.allocator);
+    }
     std::swap(data_, swapVector.data_);
     std::swap(cap_, swapVector.cap_);
     std::swap(sz_, swapVector.sz_);
+    swapRecords(swapVector);
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
 template <class... Args>
-constexpr vector<T, Allocator>::iterator vector<T, Allocator>::emplace(const_iterator position,
-                                                                       Args&&... args) {
-    const size_type positionAsIndex = size_type(position - begin());
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::emplace(const_iterator position,
+                                                             Args&&... args) {
+    const size_type positionAsIndex = indexOf(position);
 
     if (size() == capacity()) {
-        value_type* newData = nullptr;
-        size_type numOfCopied = 0;
+        grow(nextCapacity(sz_ + 1), positionAsIndex, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap,
+                                                        std::forward<Args>(args)...);
+        });
 
-        newData = std::allocator_traits<Allocator>::allocate(allocator, 2 * cap_);
-
-        std::allocator_traits<Allocator>::construct(allocator, newData + positionAsIndex,
+        ++sz_;
+    } else if (positionAsIndex == sz_) {
+        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_,
                                                     std::forward<Args>(args)...);
-
-        for (; numOfCopied < positionAsIndex; ++numOfCopied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + numOfCopied,
-                                                        *(data_ + numOfCopied));
-        }
-
-        for (; numOfCopied < sz_; ++numOfCopied) {
-            std::allocator_traits<Allocator>::construct(allocator, newData + numOfCopied + 1,
-                                                        *(data_ + numOfCopied));
-        }
-
-        destroyRange(data_, data_ + sz_);
-        destroyPointer(data_);
-
-        data_ = newData;
-        cap_ = 2 * cap_;
         ++sz_;
+    } else if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        T temp(std::forward<Args>(args)...);
+
+        shiftAndFill(positionAsIndex, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap, std::move(temp));
+        });
     } else {
-        assignRangeBackward(begin() + positionAsIndex, end(), data_ + positionAsIndex + 1);
+        T temp(std::forward<Args>(args)...);
+
+        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_,
+                                                    std::move(*(data_ + sz_ - 1)));
+        assignRangeBackward(begin() + positionAsIndex, end() - 1, data_ + positionAsIndex + 1);
+        Instrumentation::on_shift(sz_ - positionAsIndex, sizeof(T));
         ++sz_;
 
-        std::allocator_traits<Allocator>::construct(allocator, position.ptr_,
-                                                    std::forward<Args>(args)...);
+        *(data_ + positionAsIndex) = std::move(temp);
     }
 
-    return iterator(data_ + positionAsIndex);
+    return iterator(data_ + positionAsIndex, this);
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
 template <class... Args>
-constexpr vector<T, Allocator>::reference vector<T, Allocator>::emplace_back(Args&&... args) {
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::reference
+vector<T, Allocator, GrowthPolicy, Instrumentation>::emplace_back(Args&&... args) {
     if (size() == capacity()) {
-        value_type* newData = grow(2 * cap_, true);
-
-        destroyRange(data_, data_ + sz_);
-        destroyPointer(data_);
-
-        data_ = newData;
-        cap_ = 2 * cap_;
+        grow(nextCapacity(sz_ + 1), sz_, 1, [&](pointer gap) {
+            std::allocator_traits<Allocator>::construct(allocator, gap,
+                                                        std::forward<Args>(args)...);
+        });
+    } else {
+        std::allocator_traits<Allocator>::construct(allocator, data_ + sz_,
+                                                    std::forward<Args>(args)...);
     }
 
-    std::allocator_traits<Allocator>::construct(allocator, data_ + sz_,
-                                                std::forward<Args>(args)...);
-
     ++sz_;
     return data_[sz_ - 1];
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::resize(size_type count) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::resize(size_type count) {
     if (count == 0) {
         clear();
         return;
@@ -1025,33 +2310,20 @@ constexpr void vector<T, Allocator>::resize(size_type count) {
     } else if (size() == count) {
         return;
     } else {
-        size_type constructed = 0;
-
-        if (count < capacity()) {
-            for (; constructed < (count - sz_); ++constructed) {
-                std::allocator_traits<Allocator>::construct(allocator, data_ + sz_ + constructed);
-            }
-
+        if (count <= capacity()) {
+            detail::uninitializedFill(allocator, data_ + sz_, count - sz_);
         } else {
-            value_type* newData = grow(count, true);
-
-            for (; constructed < (count - sz_); ++constructed) {
-                std::allocator_traits<Allocator>::construct(allocator, newData + sz_ + constructed);
-            }
-
-            destroyRange(data_, data_ + sz_);
-            destroyPointer(data_);
-
-            data_ = newData;
-            cap_ = count;
+            grow(nextCapacity(count), sz_, count - sz_,
+                 [&](pointer gap) { detail::uninitializedFill(allocator, gap, count - sz_); });
         }
     }
 
     sz_ = count;
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::resize(size_type count, const T& value) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::resize(size_type count,
+                                                                           const T& value) {
     if (count == 0) {
         return clear();
     } else if (count < size()) {
@@ -1059,165 +2331,380 @@ constexpr void vector<T, Allocator>::resize(size_type count, const T& value) {
     } else if (count == size()) {
         return;
     } else {
-        size_type constructed = 0;
+        if (count <= capacity()) {
+            detail::uninitializedFill(allocator, data_ + sz_, count - sz_, value);
+        } else {
+            T temp(value);
 
-        if (count < capacity()) {
+            grow(nextCapacity(count), sz_, count - sz_, [&](pointer gap) {
+                detail::uninitializedFill(allocator, gap, count - sz_, temp);
+            });
+        }
+    }
 
-            for (; constructed < (count - sz_); ++constructed) {
-                std::allocator_traits<Allocator>::construct(allocator, data_ + sz_ + constructed,
-                                                            value);
-            }
+    sz_ = count;
+}
 
-        } else {
-            value_type* newData = grow(count, true);
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <chunk_executor Executor>
+void vector<T, Allocator, GrowthPolicy, Instrumentation>::resize(const Executor& exec,
+                                                                 size_type count) {
+    if (count <= sz_) {
+        destroyRange(data_ + count, data_ + sz_);
+    } else if (count <= capacity()) {
+        detail::parallelFill(exec, allocator, data_ + sz_, count - sz_);
+    } else {
+        grow(nextCapacity(count), sz_, count - sz_,
+             [&](pointer gap) { detail::parallelFill(exec, allocator, gap, count - sz_); });
+    }
 
-            for (; constructed < (count - sz_); ++constructed) {
-                std::allocator_traits<Allocator>::construct(allocator, newData + sz_ + constructed,
-                                                            value);
-            }
+    sz_ = count;
+}
 
-            destroyRange(data_, data_ + sz_);
-            destroyPointer(data_);
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <chunk_executor Executor>
+void vector<T, Allocator, GrowthPolicy, Instrumentation>::resize(const Executor& exec,
+                                                                 size_type count, const T& value) {
+    if (count <= sz_) {
+        destroyRange(data_ + count, data_ + sz_);
+    } else if (count <= capacity()) {
+        detail::parallelFill(exec, allocator, data_ + sz_, count - sz_, value);
+    } else {
+        T temp(value);
 
-            data_ = newData;
-            cap_ = count;
-        }
+        grow(nextCapacity(count), sz_, count - sz_, [&](pointer gap) {
+            detail::parallelFill(exec, allocator, gap, count - sz_, temp);
+        });
     }
 
     sz_ = count;
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::reserve(size_type count) {
-    if (count <= capacity()) {
-        return;
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::resize_for_overwrite(
+    size_type count) {
+    if (count <= sz_) {
+        destroyRange(data_ + count, data_ + sz_);
+    } else if (count <= capacity()) {
+        detail::uninitializedDefaultFill(allocator, data_ + sz_, count - sz_);
+    } else {
+        // Default-initialization reads nothing that could alias the old block, so the elements
+        // are made in place once it has grown; a realloc-style allocator then needn't stage one.
+        grow(nextCapacity(count));
+        detail::uninitializedDefaultFill(allocator, data_ + sz_, count - sz_);
     }
 
-    value_type* newData = grow(count, true);
+    sz_ = count;
+}
 
-    destroyRange(data_, data_ + sz_);
-    destroyPointer(data_);
-    data_ = newData;
-    cap_ = count;
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <class Operation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::resize_and_overwrite(
+    size_type count, Operation op) {
+    resize_for_overwrite(count);
+
+    const size_type written = size_type(op(data_, count));
+
+    destroyRange(data_ + written, data_ + sz_);
+    sz_ = written;
 }
 
-template <class T, class Allocator>
-constexpr void vector<T, Allocator>::shrink_to_fit() {
-    if (size() == capacity()) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::reserve(size_type count) {
+    if (count <= capacity()) {
         return;
     }
 
-    value_type* newData = std::allocator_traits<Allocator>::allocate(allocator, size());
-    size_type copied = 0;
+    grow(count);
+}
 
-    for (; copied < sz_; ++copied) {
-        std::allocator_traits<Allocator>::construct(allocator, newData + copied, *(data_ + copied));
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::shrink_to_fit() {
+    if (size() == capacity()) {
+        return;
     }
 
-    destroyRange(data_, data_ + sz_);
-    destroyPointer(data_);
-
-    data_ = newData;
-    cap_ = size();
+    grow(size());
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
 template <class InputIterator>
-void vector<T, Allocator>::assignRangeForward(InputIterator from, InputIterator to,
-                                              pointer destination) {
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::assignRangeForward(
+    InputIterator from, InputIterator to, pointer destination) {
     for (; from != to; ++from, ++destination) {
-        *destination = *from;
+        *destination = std::move(*from);
     }
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
 template <class InputIterator>
-void vector<T, Allocator>::assignRangeBackward(InputIterator from, InputIterator to,
-                                               pointer destination) {
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::assignRangeBackward(
+    InputIterator from, InputIterator to, pointer destination) {
     destination += to - from - 1;
 
     for (; to != from; --to, --destination) {
-        *destination = *(to - 1);
+        *destination = std::move(*(to - 1));
     }
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
 template <class InputIterator>
-void vector<T, Allocator>::moveRangeForward(InputIterator from, InputIterator to,
-                                            pointer destination) {
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::moveRangeForward(
+    InputIterator from, InputIterator to, pointer destination) {
     for (; from != to; ++from, ++destination) {
         std::allocator_traits<Allocator>::construct(allocator, destination, std::move(*from));
     }
 }
 
-template <class T, class Allocator>
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
 template <class InputIterator>
-void vector<T, Allocator>::copyRangeForward(InputIterator from, InputIterator to,
-                                            pointer destination) {
-    for (; from != to; ++from, ++destination) {
-        std::allocator_traits<Allocator>::construct(allocator, destination, *from);
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::insertCounted(size_type positionAsIndex,
+                                                                   InputIterator first,
+                                                                   size_type count) {
+    auto fill = [&](pointer gap) { detail::uninitializedCopyN(allocator, first, count, gap); };
+
+    if (sz_ + count > cap_) {
+        grow(nextCapacity(sz_ + count), positionAsIndex, count, fill);
+        sz_ += count;
+    } else if (positionAsIndex == sz_) {
+        fill(data_ + sz_);
+        sz_ += count;
+    } else if constexpr (detail::is_bitwise_relocatable_v<Allocator, T>) {
+        shiftAndFill(positionAsIndex, count, fill);
+    } else {
+        fill(data_ + sz_);
+        sz_ += count;
+        Instrumentation::on_shift(sz_ - count - positionAsIndex, sizeof(T));
+        std::rotate(data_ + positionAsIndex, data_ + sz_ - count, data_ + sz_);
     }
+
+    return iterator(data_ + positionAsIndex, this);
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::copyRangeForward(pointer from, pointer to, const_reference value) {
-    for (; from != to; ++from) {
-        std::allocator_traits<Allocator>::construct(allocator, from, value);
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <class InputIterator, class Sentinel>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::iterator
+vector<T, Allocator, GrowthPolicy, Instrumentation>::insertUnsized(size_type positionAsIndex,
+                                                                   InputIterator first,
+                                                                   Sentinel last) {
+    const size_type oldSize = sz_;
+
+    for (; first != last; ++first) {
+        emplace_back(*first);
     }
+    Instrumentation::on_shift(oldSize - positionAsIndex, sizeof(T));
+    std::rotate(data_ + positionAsIndex, data_ + oldSize, data_ + sz_);
+
+    return iterator(data_ + positionAsIndex, this);
 }
 
-template <class T, class Allocator>
-template <class InputIterator>
-void vector<T, Allocator>::copyRangeBackward(InputIterator from, InputIterator to,
-                                             pointer destination) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::size_type
+vector<T, Allocator, GrowthPolicy, Instrumentation>::nextCapacity(size_type required) const {
+    if (required > max_size()) {
+        throw(std::length_error("Required capacity exceeds max_size()!"));
+    }
 
-    destination += to - from - 1;
+    const size_type next = GrowthPolicy::next_capacity(cap_, required, sizeof(T));
 
-    for (; to != from; --to, --destination) {
-        std::allocator_traits<Allocator>::construct(allocator, destination, *(to - 1));
-    }
+    return std::min(std::max(next, required), max_size());
 }
 
-template <class T, class Allocator>
-T* vector<T, Allocator>::grow(size_type newCap, bool copy, size_type gapIndex, size_type gapSize) {
-    value_type* newData = std::allocator_traits<Allocator>::allocate(allocator, newCap);
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::grow(size_type newCap) {
+    grow(newCap, sz_, 0, detail::no_fill{});
+}
 
-    if (copy) {
-        size_type copied = 0;
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <class Fill>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::grow(
+    size_type newCap, size_type gapIndex, size_type gapSize, Fill fill) {
+    // Appending to a block the allocator can extend in place moves nothing, so arguments that
+    // alias existing elements stay valid.
+    if (newCap > cap_ && gapIndex == sz_ && detail::tryExpand(allocator, data_, cap_, newCap)) {
+        Instrumentation::on_reallocate(cap_, newCap, true, sizeof(T));
+        cap_ = newCap;
+        fill(data_ + gapIndex);
+        return;
+    }
 
-        if (gapSize > 0) {
+    if constexpr (detail::is_bitwise_relocatable_v<Allocator, T> &&
+                  detail::has_reallocate<Allocator>::value) {
+        if (data_ != nullptr && (gapSize <= 1 || detail::is_single_block<Allocator>::value)) {
+            reallocate(newCap, gapIndex, gapSize, fill);
+            return;
+        }
+    }
 
-            for (; copied < gapIndex; ++copied) {
-                std::allocator_traits<Allocator>::construct(allocator, newData + copied,
-                                                            *(data_ + copied));
-            }
+    // Read before the allocation and fill, which the compiler can't see through, so that it
+    // knows the relocated range ends where a gap at the end starts.
+    const size_type oldSize = sz_;
+    auto [newData, allocated] = detail::allocateAtLeast(allocator, newCap);
 
-            for (; copied < sz_; ++copied) {
-                std::allocator_traits<Allocator>::construct(allocator, newData + copied + gapSize,
-                                                            *(data_ + copied));
-            }
+    try {
+        fill(newData + gapIndex);
+    } catch (...) {
+        std::allocator_traits<Allocator>::deallocate(allocator, newData, allocated);
+        throw;
+    }
 
-        } else {
+    try {
+        detail::relocate(allocator, data_, data_ + oldSize, newData, gapIndex, gapSize);
+    } catch (...) {
+        detail::destroyRange(allocator, newData + gapIndex, newData + gapIndex + gapSize);
+        std::allocator_traits<Allocator>::deallocate(allocator, newData, allocated);
+        throw;
+    }
 
-            for (; copied < sz_; ++copied) {
-                std::allocator_traits<Allocator>::construct(allocator, newData + copied,
-                                                            *(data_ + copied));
-            }
+    Instrumentation::on_allocate(allocated, sizeof(T));
+    if (data_ != nullptr) {
+        Instrumentation::on_reallocate(cap_, allocated, false, sizeof(T));
+        Instrumentation::on_relocate(sz_, relocationKind, sizeof(T));
+    }
+
+    destroyPointer(data_);
+
+    data_ = newData;
+    cap_ = allocated;
+    trackBuffer();
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <class Fill>
+void vector<T, Allocator, GrowthPolicy, Instrumentation>::reallocate(size_type newCap,
+                                                                     size_type gapIndex,
+                                                                     size_type gapSize, Fill fill) {
+    if constexpr (std::is_same_v<Fill, detail::no_fill>) {
+        reallocateBlock(newCap, gapIndex, gapSize);
+        return;
+    }
+
+    if (gapSize == 1) {
+        // A single new element is built off to the side first: its arguments may alias the old
+        // block, which reallocate() is free to release. T is trivially relocatable, so moving it
+        // into the gap afterwards is a plain memcpy.
+        alignas(T) unsigned char staging[sizeof(T)];
+        pointer element = reinterpret_cast<pointer>(staging);
+        fill(element);
+
+        try {
+            reallocateBlock(newCap, gapIndex, gapSize);
+        } catch (...) {
+            detail::destroyRange(allocator, element, element + 1);
+            throw;
         }
+        std::memcpy(static_cast<void*>(data_ + gapIndex), staging, sizeof(T));
+        return;
+    }
+
+    // Larger gaps are filled in place once the block has moved, so callers copy anything that
+    // may alias the vector beforehand.
+    reallocateBlock(newCap, gapIndex, gapSize);
+    if (gapSize > 0) {
+        try {
+            fill(data_ + gapIndex);
+        } catch (...) {
+            detail::shiftRange(data_ + gapIndex + gapSize, data_ + sz_ + gapSize,
+                               data_ + gapIndex);
+            throw;
+        }
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+void vector<T, Allocator, GrowthPolicy, Instrumentation>::reallocateBlock(size_type newCap,
+                                                                          size_type gapIndex,
+                                                                          size_type gapSize) {
+    const auto oldAddress = reinterpret_cast<std::uintptr_t>(data_);
+    pointer newData = allocator.reallocate(data_, cap_, newCap);
+
+    const bool moved = reinterpret_cast<std::uintptr_t>(newData) != oldAddress;
+    Instrumentation::on_reallocate(cap_, newCap, true, sizeof(T));
+    if (moved) {
+        Instrumentation::on_relocate(sz_, instrument::relocation::bitwise, sizeof(T));
+    }
+
+    detail::shiftRange(newData + gapIndex, newData + sz_, newData + gapIndex + gapSize);
+    data_ = newData;
+    cap_ = newCap;
+    if (moved) {
+        trackBuffer();
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <class Fill>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::reassign(size_type count,
+                                                                             Fill fill) {
+    destroyRange(data_, data_ + sz_);
+    sz_ = 0;
+
+    grow(count, 0, count, fill);
+    sz_ = count;
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+template <class Fill>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::shiftAndFill(
+    size_type gapIndex, size_type gapSize, Fill fill) {
+    Instrumentation::on_shift(sz_ - gapIndex, sizeof(T));
+    detail::shiftRange(data_ + gapIndex, data_ + sz_, data_ + gapIndex + gapSize);
+
+    try {
+        fill(data_ + gapIndex);
+    } catch (...) {
+        detail::shiftRange(data_ + gapIndex + gapSize, data_ + sz_ + gapSize, data_ + gapIndex);
+        throw;
     }
 
-    return newData;
+    sz_ += gapSize;
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::destroyRange(pointer from, pointer to) {
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::destroyRange(
+    pointer from, pointer to) {
     for (; from != to; ++from) {
         std::allocator_traits<Allocator>::destroy(allocator, from);
     }
 }
 
-template <class T, class Allocator>
-void vector<T, Allocator>::destroyPointer(pointer ptr) {
-    std::allocator_traits<Allocator>::deallocate(allocator, ptr, sz_);
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr vector<T, Allocator, GrowthPolicy, Instrumentation>::pointer
+vector<T, Allocator, GrowthPolicy, Instrumentation>::allocate(size_type count) {
+    pointer ptr = std::allocator_traits<Allocator>::allocate(allocator, count);
+    Instrumentation::on_allocate(count, sizeof(T));
+
+    return ptr;
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr void vector<T, Allocator, GrowthPolicy, Instrumentation>::destroyPointer(pointer ptr) {
+#if COOLSTD_CHECKS
+    if (record_ != nullptr) {
+        checks::detail::releaseRecord(record_);
+        record_ = nullptr;
+    }
+#endif
+    if (ptr == nullptr) {
+        return;
+    }
+
+    Instrumentation::on_deallocate(cap_, sz_, sizeof(T));
+    if constexpr (!detail::is_monotonic<Allocator>::value) {
+        std::allocator_traits<Allocator>::deallocate(allocator, ptr, cap_);
+    }
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr bool operator==(const vector<T, Allocator, GrowthPolicy, Instrumentation>& lhs,
+                const vector<T, Allocator, GrowthPolicy, Instrumentation>& rhs) {
+    return lhs.size() == rhs.size() && detail::equalRanges(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <class T, class Allocator, class GrowthPolicy, class Instrumentation>
+constexpr auto operator<=>(const vector<T, Allocator, GrowthPolicy, Instrumentation>& lhs,
+                 const vector<T, Allocator, GrowthPolicy, Instrumentation>& rhs) {
+    return detail::compareRanges(lhs.data(), lhs.size(), rhs.data(), rhs.size());
 }
 }  // namespace coolstd
\ No newline at end of file